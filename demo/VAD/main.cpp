@@ -26,8 +26,7 @@ int main(int argc, char *argv[])
     {
         WaveFileData * file = new WaveFileData();
         file->read();
-        std::vector<int16_t> samples = file->getSamples();
-        performVAD(samples);
+        performVAD(file->getSamples());
     }
 
     else
@@ -38,8 +37,7 @@ int main(int argc, char *argv[])
         {
             WaveFileData * file = new WaveFileData(readStreamIntoBuffer);
             file->read();
-            std::vector<int16_t> samples = file->getSamples();
-            performVAD(samples);
+            performVAD(file->getSamples());
 
         }
 
@@ -47,8 +45,7 @@ int main(int argc, char *argv[])
         {
             WaveFileData * file = new WaveFileData(argv[1]);
             file->read();
-            std::vector<int16_t> samples = file->getSamples();
-            performVAD(samples);
+            performVAD(file->getSamples());
         }
     }
 
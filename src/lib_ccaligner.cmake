@@ -31,8 +31,30 @@ set(webRTCVADFiles
         ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/vad/vad_sp.c
         ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/vad/webrtc_vad.c
 )
-add_library(webRTC ${webRTCVADFiles})
+
+#WebRTC sinc resampler(for converting audio to 16KHz, uses SSE when available) and ring buffer(for streaming audio)
+set(webRTCAudioFiles
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/base/checks.cc
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/audio_util.cc
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/ring_buffer.c
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/resampler/push_sinc_resampler.cc
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/resampler/sinc_resampler.cc
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/system_wrappers/source/aligned_malloc.cc
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/system_wrappers/source/cpu_features.cc
+)
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "(x86)|(X86)|(amd64)|(AMD64)|(i.86)")
+    set(webRTCAudioFiles ${webRTCAudioFiles}
+            ${CMAKE_CURRENT_LIST_DIR}/lib_ext/webrtc/webrtc/common_audio/resampler/sinc_resampler_sse.cc
+    )
+endif()
+
+add_library(webRTC ${webRTCVADFiles} ${webRTCAudioFiles})
 set_target_properties(webRTC PROPERTIES FOLDER lib_ext)
+if(WIN32)
+    target_compile_definitions(webRTC PRIVATE WEBRTC_WIN)
+else()
+    target_compile_definitions(webRTC PRIVATE WEBRTC_POSIX)
+endif()
 
 if(UNIX)
     set (EXTRA_FLAGS ${EXTRA_FLAGS} -lpthread -pthread)
@@ -82,6 +104,14 @@ set(SOURCE_FILES
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/voice_activity_detection.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/read_wav_file.h
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/read_wav_file.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/audio_converter.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/audio_converter.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/sample_stream.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/sample_stream.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/feature_store.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/feature_store.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/language_model.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/language_model.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/grammar_tools.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/grammar_tools.h
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/recognize_using_pocketsphinx.cpp
@@ -90,9 +120,24 @@ set(SOURCE_FILES
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/params.h
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/phoneme_utils.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/phoneme_utils.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/sound_changes.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/sound_changes.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/pronunciation_store.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/pronunciation_store.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/workspace.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/workspace.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/word_matcher.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/word_matcher.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/caption_stream.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/caption_stream.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/batch_aligner.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/batch_aligner.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/alignment_server.h
+        ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/alignment_server.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/output_handler.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/output_handler.h
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/logger.cpp
         ${CMAKE_CURRENT_LIST_DIR}/lib_ccaligner/logger.h
         )
-add_library(libccaligner STATIC ${SOURCE_FILES})
\ No newline at end of file
+add_library(libccaligner STATIC ${SOURCE_FILES})
+target_link_libraries(libccaligner webRTC)
\ No newline at end of file
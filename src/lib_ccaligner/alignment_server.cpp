@@ -0,0 +1,550 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "alignment_server.h"
+#include "batch_aligner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+enum class JobState { queued, running, aligned, failed, cancelled };
+
+struct ServerJob    //a request and how aligning it goes, shared by its connection and the worker aligning it
+{
+    std::string filePrefix;                 //of the files sent with the request and of the output, in the workspace
+    std::string audioFileName, subtitleFileName, outputFileName;
+    bool audioIsRaw;
+    JobState state;
+    bool started;
+    std::string error;
+    std::atomic<bool> cancelled;
+    std::condition_variable changed;        //the state changed
+
+    explicit ServerJob(std::string prefix)
+        : filePrefix(std::move(prefix)), outputFileName(filePrefix + ".out"), audioIsRaw(false),
+          state(JobState::queued), started(false), cancelled(false) {}
+
+    bool finished() const noexcept { return state != JobState::queued && state != JobState::running; }
+};
+
+#ifdef WIN32
+
+//UNIX domain sockets are not available, validateParams() refuses --serve before it gets here
+
+AlignmentServer::AlignmentServer(Params *parameters) : _parameters(parameters), _socket(-1), _stopping(false), _admitted(0)
+{
+    FATAL(IncompatibleParameters) << "--serve listens on a UNIX domain socket, which is not supported on Windows!";
+}
+
+void AlignmentServer::serve() {}
+void AlignmentServer::stop() noexcept {}
+AlignmentServer::~AlignmentServer() {}
+
+#else
+
+static const int tick = 50;                 //ms between looks at a connection and the output of its job
+static const int requestTimeout = 30000;    //ms a client may pause while sending a request
+static volatile std::sig_atomic_t stopSignalled = 0;
+
+static void onStopSignal(int)
+{
+    stopSignalled = 1;
+}
+
+class ClientConnection  //read with a time limit, given up on when the server stops
+{
+    int _socket;
+    const std::atomic<bool>& _stopping;
+    std::string _buffer;                    //received, not yet consumed
+    bool _closed;
+
+public:
+    ClientConnection(int socket, const std::atomic<bool>& stopping) : _socket(socket), _stopping(stopping), _closed(false) {}
+    ClientConnection(const ClientConnection&) = delete;
+    ClientConnection& operator=(const ClientConnection&) = delete;
+    ~ClientConnection() { close(_socket); }
+
+    bool closed() const noexcept { return _closed; }
+
+    bool receive(int timeout)   //false if nothing arrived within timeout ms
+    {
+        for (int waited = 0; !_closed && !_stopping; waited += tick)
+        {
+            pollfd readable = {_socket, POLLIN, 0};
+
+            if (poll(&readable, 1, std::min(tick, timeout - waited)) > 0)
+            {
+                char data[65536];
+                ssize_t received = recv(_socket, data, sizeof(data), 0);
+
+                if (received <= 0)
+                    _closed = true;
+                else
+                    _buffer.append(data, received);
+
+                return received > 0;
+            }
+
+            if (waited + tick >= timeout)
+                break;
+        }
+
+        return false;
+    }
+
+    bool nextLine(std::string& line)        //of what was received already
+    {
+        std::size_t end = _buffer.find('\n');
+
+        if (end == std::string::npos)
+            return false;
+
+        line = _buffer.substr(0, end);
+        _buffer.erase(0, end + 1);
+        line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+        return true;
+    }
+
+    bool readLine(std::string& line, int timeout)
+    {
+        while (!nextLine(line))
+            if (!receive(timeout))
+                return false;
+
+        return true;
+    }
+
+    bool readBytes(unsigned long long numberOfBytes, std::ostream& out, int timeout)
+    {
+        while (numberOfBytes > 0)
+        {
+            if (_buffer.empty() && !receive(timeout))
+                return false;
+
+            std::size_t taken = (std::size_t) std::min<unsigned long long>(numberOfBytes, _buffer.size());
+            out.write(_buffer.data(), taken);
+            _buffer.erase(0, taken);
+            numberOfBytes -= taken;
+        }
+
+        return true;
+    }
+
+    bool send(const std::string& data)
+    {
+        for (std::size_t sent = 0; sent < data.size() && !_closed; )
+        {
+            ssize_t written = ::send(_socket, data.data() + sent, data.size() - sent, 0);
+
+            if (written <= 0)
+                _closed = true;
+            else
+                sent += written;
+        }
+
+        return !_closed;
+    }
+};
+
+static sockaddr_un socketAddress(const std::string& path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path))
+        FATAL(InvalidParameters) << "The path of the socket " << path << " is longer than " << sizeof(address.sun_path) - 1 << " characters!";
+
+    std::strcpy(address.sun_path, path.c_str());
+    return address;
+}
+
+AlignmentServer::AlignmentServer(Params *parameters) : _parameters(parameters), _socket(-1), _stopping(false), _admitted(0)
+{
+    sockaddr_un address = socketAddress(_parameters->socketPath);
+
+    //a socket left behind by a server which is gone is replaced, one still answering is not
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool answering = probe >= 0 && connect(probe, (sockaddr *) &address, sizeof(address)) == 0;
+
+    if (probe >= 0)
+        close(probe);
+
+    if (answering)
+        FATAL(IncompatibleParameters) << "Another server is listening on " << _parameters->socketPath << "!";
+
+    unlink(_parameters->socketPath.c_str());
+    _socket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    //requests name files the server reads, only its user may send them, the socket is created that way
+    mode_t mask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+    bool bound = _socket >= 0 && bind(_socket, (sockaddr *) &address, sizeof(address)) == 0;
+    umask(mask);
+
+    if (!bound || listen(_socket, SOMAXCONN) != 0)
+    {
+        std::string reason = strerror(errno);
+
+        if (_socket >= 0)
+            close(_socket);
+
+        FATAL(UnknownError) << "Unable to listen on " << _parameters->socketPath << " : " << reason;
+    }
+}
+
+AlignmentServer::~AlignmentServer()
+{
+    if (_socket >= 0)
+    {
+        close(_socket);
+        unlink(_parameters->socketPath.c_str());
+    }
+}
+
+void AlignmentServer::stop() noexcept
+{
+    _stopping = true;
+}
+
+bool AlignmentServer::readRequest(ClientConnection& client, ServerJob& job, std::string& reason)
+{
+    std::string line;
+
+    while (client.readLine(line, requestTimeout))
+    {
+        if (line.empty())
+        {
+            if (job.audioFileName.empty() || job.subtitleFileName.empty())
+                reason = "A request needs audio and subtitles";
+
+            return reason.empty();
+        }
+
+        std::istringstream fields(line);
+        std::string field, value;
+        fields >> field;
+        std::getline(fields >> std::ws, value);
+
+        if (field == "audio")
+        {
+            job.audioFileName = value;
+            job.audioIsRaw = false;
+        }
+
+        else if (field == "subtitles")
+        {
+            job.subtitleFileName = value;
+        }
+
+        else if (field == "pcm" || field == "srt")
+        {
+            char *end = nullptr;
+            unsigned long long numberOfBytes = std::strtoull(value.c_str(), &end, 10);
+
+            if (value.empty() || *end != '\0')
+            {
+                reason = "The size of " + field + " is not a number of bytes : " + value;
+                return false;
+            }
+
+            std::string fileName = job.filePrefix + (field == "pcm" ? ".raw" : ".srt");
+            std::ofstream out(fileName, std::ios::binary);
+
+            if (!client.readBytes(numberOfBytes, out, requestTimeout))
+                return false;
+
+            out.close();
+
+            if (!out)
+            {
+                reason = "Unable to write " + fileName;
+                return false;
+            }
+
+            if (field == "pcm")
+            {
+                job.audioFileName = fileName;
+                job.audioIsRaw = true;
+            }
+            else
+                job.subtitleFileName = fileName;
+        }
+
+        else
+        {
+            reason = "Unknown field '" + field + "' in the request";
+            return false;
+        }
+    }
+
+    return false;   //closed or paused too long before the request ended
+}
+
+void AlignmentServer::follow(ClientConnection& client, ServerJob& job)
+{
+    std::streamoff sent = 0;
+    bool announced = false;
+
+    while (true)
+    {
+        bool started, finished;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            job.changed.wait_for(lock, std::chrono::milliseconds(tick));
+            started = job.started;
+            finished = job.finished();
+        }
+
+        if (started && !announced)
+            announced = client.send("started\n");
+
+        if (started)    //what was written of the output since the last look
+        {
+            std::ifstream output(job.outputFileName, std::ios::binary);
+            output.seekg(sent);
+            std::string written((std::istreambuf_iterator<char>(output)), std::istreambuf_iterator<char>());
+
+            if (!written.empty() && client.send("output " + std::to_string(written.size()) + "\n" + written))
+                sent += written.size();
+        }
+
+        if (finished)
+            break;
+
+        if (!client.closed())
+            client.receive(0);
+
+        std::string line;
+
+        while (client.nextLine(line))
+        {
+            if (line == "cancel")
+                job.cancelled = true;
+        }
+
+        if (client.closed() || _stopping)
+            job.cancelled = true;
+    }
+
+    switch (job.state)
+    {
+        case JobState::aligned:     client.send("done\n");
+            break;
+
+        case JobState::failed:      client.send("failed " + job.error + "\n");
+            break;
+
+        default:                    client.send("cancelled\n");
+    }
+}
+
+void AlignmentServer::serveConnection(int connection)
+{
+    ClientConnection client(connection, _stopping);
+    std::shared_ptr<ServerJob> job(new ServerJob(Workspace::unique(_parameters->workspacePath)));
+    std::string reason;
+
+    if (readRequest(client, *job, reason))
+    {
+        std::size_t ahead;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ahead = _queue.size();
+
+            if (!_stopping)
+                _queue.push_back(job);
+        }
+
+        if (_stopping)
+        {
+            client.send("cancelled\n");
+        }
+        else
+        {
+            _jobQueued.notify_one();
+            client.send("queued " + std::to_string(ahead) + "\n");
+            follow(client, *job);
+        }
+    }
+
+    else if (!reason.empty())
+    {
+        client.send("failed " + reason + "\n");
+    }
+
+    for (const char *extension : {".raw", ".srt", ".out"})
+        std::remove((job->filePrefix + extension).c_str());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _admitted--;
+    _connectionClosed.notify_all();
+}
+
+void AlignmentServer::admit(int connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_admitted < _parameters->jobs + _parameters->queueLength)
+        {
+            _admitted++;
+            std::thread(&AlignmentServer::serveConnection, this, connection).detach();    //serve() waits for every admitted connection
+            return;
+        }
+    }
+
+    ClientConnection client(connection, _stopping);
+    client.send("busy\n");
+
+    while (client.receive(0));  //closing with unread data would reset the connection under the client
+}
+
+void AlignmentServer::run(ServerJob& job)
+{
+    auto started = std::chrono::steady_clock::now();
+    JobState state = JobState::failed;
+    std::string error, workspace;
+
+    try
+    {
+        if (!std::ifstream(job.subtitleFileName))   //the parser would take a missing file for one without subtitles
+            FATAL(FileNotFound) << "Unable to open subtitles " << job.subtitleFileName;
+
+        Params parameters = _parameters->forJob(job.audioFileName, job.subtitleFileName, job.outputFileName);
+        parameters.audioIsRaw = job.audioIsRaw;
+        workspace = parameters.workspacePath;
+
+        PocketsphinxAligner(&parameters, _model.get(), &job.cancelled).align();
+        state = JobState::aligned;
+    }
+
+    catch (AlignmentCancelled&)
+    {
+        state = JobState::cancelled;
+    }
+
+    catch (std::exception& e)
+    {
+        error = reasonOf(e);
+    }
+
+    if (!workspace.empty())     //a server runs for long, nothing is kept for inspection
+        Workspace(workspace).remove();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (state == JobState::aligned)
+        INFO << "Aligned " << job.audioFileName << " in " << std::fixed << std::setprecision(2) << seconds << " s";
+    else if (state == JobState::cancelled)
+        INFO << "Cancelled aligning " << job.audioFileName;
+    else
+        WARNING << "Unable to align " << job.audioFileName << " : " << error;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    job.state = state;
+    job.error = error;
+    job.changed.notify_all();
+}
+
+void AlignmentServer::work()
+{
+    while (true)
+    {
+        std::shared_ptr<ServerJob> job;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobQueued.wait(lock, [this] { return _stopping || !_queue.empty(); });
+
+            if (_queue.empty())
+                return;
+
+            job = _queue.front();
+            _queue.pop_front();
+
+            if (job->cancelled)
+            {
+                job->state = JobState::cancelled;
+                job->changed.notify_all();
+                continue;
+            }
+
+            job->state = JobState::running;
+            job->started = true;
+            job->changed.notify_all();
+        }
+
+        run(*job);
+    }
+}
+
+void AlignmentServer::serve()
+{
+    Workspace(_parameters->workspacePath).create();    //for the log of the shared model and the files of requests
+    _model = decltype(_model)(new AcousticModel(_parameters->modelPath, _parameters->alignerLogPath));
+
+    std::signal(SIGPIPE, SIG_IGN);          //a client gone while its output is sent is noticed by the failed send
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+
+    std::vector<std::thread> workers;
+
+    for (unsigned long i = 0; i < _parameters->jobs; i++)
+        workers.emplace_back(&AlignmentServer::work, this);
+
+    INFO << "Serving alignments on " << _parameters->socketPath << ", " << _parameters->jobs << " at once and up to "
+         << _parameters->queueLength << " waiting..";
+
+    while (!_stopping && !stopSignalled)
+    {
+        pollfd incoming = {_socket, POLLIN, 0};
+
+        if (poll(&incoming, 1, tick) <= 0)
+            continue;
+
+        int connection = accept(_socket, nullptr, nullptr);
+
+        if (connection >= 0)
+            admit(connection);
+    }
+
+    INFO << "Stopping, cancelling the requests being served..";
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stopping = true;
+        _jobQueued.notify_all();
+        _connectionClosed.wait(lock, [this] { return _admitted == 0; });
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    stopSignalled = 0;
+    _model.reset();
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_ALIGNMENT_SERVER_H
+#define CCALIGNER_ALIGNMENT_SERVER_H
+
+#include "params.h"
+#include "recognize_using_pocketsphinx.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*
+ * Keeps the acoustic model loaded and aligns the files of requests sent over a local UNIX domain socket, one
+ * request per connection. A request is made of lines, ended by an empty one:
+ *
+ *  audio <path>        audio file to align, or
+ *  pcm <bytes>         followed by that many bytes of 16 bit, 16KHz, mono, little endian samples
+ *  subtitles <path>    its subtitles, or
+ *  srt <bytes>         followed by that many bytes of SubRip subtitles
+ *
+ * The reply is a line per event: "queued <requests ahead>", "started", "output <bytes>" followed by that many bytes
+ * of the JSON output as dialogues are aligned, and last "done", "failed <reason>" or "cancelled". A connection made while
+ * -jobs are aligned and -queue more wait is answered "busy" and closed before its request is read. Sending "cancel"
+ * or closing the connection cancels the request, whether it waits or is being aligned.
+ */
+
+struct ServerJob;
+class ClientConnection;
+
+class AlignmentServer
+{
+    Params * _parameters;
+    std::unique_ptr<AcousticModel> _model;
+    int _socket;
+    std::atomic<bool> _stopping;
+    std::size_t _admitted;                  //connections sending, waiting for or following their request
+    std::deque<std::shared_ptr<ServerJob>> _queue;
+    std::mutex _mutex;                      //guards the queue, the admitted connections and the state of jobs
+    std::condition_variable _jobQueued, _connectionClosed;
+
+    void admit(int connection);             //serve the connection if there is room for it, else answer busy
+    void serveConnection(int connection);
+    bool readRequest(ClientConnection& client, ServerJob& job, std::string& reason);    //false if the request is not to be aligned, with the reason if malformed
+    void follow(ClientConnection& client, ServerJob& job);     //stream the output and state of the job until it finishes
+    void run(ServerJob& job);
+    void work();                            //run queued jobs until stopped
+
+public:
+    explicit AlignmentServer(Params *parameters);   //listens on the socket right away
+    AlignmentServer(const AlignmentServer&) = delete;
+    AlignmentServer& operator=(const AlignmentServer&) = delete;
+
+    void serve();                           //until stop(), SIGINT or SIGTERM
+    void stop() noexcept;                   //cancel every request and return from serve()
+    ~AlignmentServer();
+};
+
+#endif //CCALIGNER_ALIGNMENT_SERVER_H
@@ -0,0 +1,278 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "audio_converter.h"
+
+#include <cmath>
+#include "webrtc/common_audio/resampler/push_sinc_resampler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CCALIGNER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+const unsigned long AudioConverter::targetSampleRate;
+const std::size_t AudioConverter::framesPerChunk;
+
+bool isTargetFormat(const WaveFormat& format) noexcept
+{
+    return format.audioFormat == pcmFormat && format.numChannels == 1 &&
+           format.sampleRate == AudioConverter::targetSampleRate && format.bitsPerSample == 16;
+}
+
+static float decodeSample(const unsigned char *bytes, int audioFormat, int bitsPerSample) noexcept   //single little endian sample, in 16 bit range
+{
+    if (audioFormat == floatFormat)
+    {
+        if (bitsPerSample == 64)
+        {
+            uint64_t bits = 0;
+            for (int i = 7; i >= 0; i--)
+                bits = (bits << 8) | bytes[i];
+
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return static_cast<float>(value * 32768.0);
+        }
+
+        uint32_t bits = ((uint32_t)bytes[3] << 24) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[1] << 8) | bytes[0];
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value * 32768.0f;
+    }
+
+    switch (bitsPerSample)
+    {
+        case 8  :   return (bytes[0] - 128) * 256.0f;   //8 bit PCM is unsigned
+        case 16 :   return static_cast<int16_t>(bytes[0] | (bytes[1] << 8));
+        case 24 :   return static_cast<int32_t>(((uint32_t)bytes[2] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[0] << 8)) / 65536.0f;
+        default :   return static_cast<int32_t>(((uint32_t)bytes[3] << 24) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[1] << 8) | bytes[0]) / 65536.0f;
+    }
+}
+
+void downmixToFloat(const unsigned char *frames, std::size_t numberOfFrames, const WaveFormat& format, float *mono)
+{
+    std::size_t i = 0;
+
+#ifdef CCALIGNER_USE_SSE2   //x86 is little endian, samples can be loaded as they are
+
+    if (format.audioFormat == pcmFormat && format.bitsPerSample == 16 && format.numChannels == 2)
+    {
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        for (; i + 4 <= numberOfFrames; i += 4)     //4 stereo frames at a time : L + R summed by madd
+        {
+            __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(frames + 4 * i));
+            __m128 sum = _mm_cvtepi32_ps(_mm_madd_epi16(samples, ones));
+            _mm_storeu_ps(mono + i, _mm_mul_ps(sum, half));
+        }
+    }
+
+    else if (format.audioFormat == pcmFormat && format.bitsPerSample == 16 && format.numChannels == 1)
+    {
+        for (; i + 8 <= numberOfFrames; i += 8)     //only widening to float, used while resampling mono audio
+        {
+            __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(frames + 2 * i));
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+            _mm_storeu_ps(mono + i, _mm_cvtepi32_ps(low));
+            _mm_storeu_ps(mono + i + 4, _mm_cvtepi32_ps(high));
+        }
+    }
+
+    else if (format.audioFormat == floatFormat && format.bitsPerSample == 32 && format.numChannels == 2)
+    {
+        const __m128 scale = _mm_set1_ps(0.5f * 32768.0f);
+
+        for (; i + 4 <= numberOfFrames; i += 4)     //de-interleave LRLR LRLR into LLLL RRRR and add
+        {
+            __m128 first = _mm_loadu_ps(reinterpret_cast<const float *>(frames + 8 * i));
+            __m128 second = _mm_loadu_ps(reinterpret_cast<const float *>(frames + 8 * i + 16));
+            __m128 left = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 right = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(mono + i, _mm_mul_ps(_mm_add_ps(left, right), scale));
+        }
+    }
+
+    else if (format.audioFormat == floatFormat && format.bitsPerSample == 32 && format.numChannels == 1)
+    {
+        const __m128 scale = _mm_set1_ps(32768.0f);
+
+        for (; i + 4 <= numberOfFrames; i += 4)
+        {
+            __m128 samples = _mm_loadu_ps(reinterpret_cast<const float *>(frames + 4 * i));
+            _mm_storeu_ps(mono + i, _mm_mul_ps(samples, scale));
+        }
+    }
+
+#endif
+
+    const std::size_t bytesPerSample = format.bitsPerSample / 8;
+    const float scale = 1.0f / format.numChannels;
+
+    for (; i < numberOfFrames; i++)     //remaining frames, and every layout without a vectorised path (5.1, 24 bit, ...)
+    {
+        const unsigned char *frame = frames + i * format.blockAlign;
+        float sum = 0;
+
+        for (int channel = 0; channel < format.numChannels; channel++)
+            sum += decodeSample(frame + channel * bytesPerSample, format.audioFormat, format.bitsPerSample);
+
+        mono[i] = sum * scale;
+    }
+}
+
+static void floatToSamples(const float *input, std::size_t count, int16_t *samples) noexcept  //round and saturate to 16 bit
+{
+    std::size_t i = 0;
+
+#ifdef CCALIGNER_USE_SSE2
+    const __m128 minimum = _mm_set1_ps(-32768.0f), maximum = _mm_set1_ps(32767.0f);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i low = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(input + i), maximum), minimum));   //rounds to nearest
+        __m128i high = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(input + i + 4), maximum), minimum));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(samples + i), _mm_packs_epi32(low, high));   //saturates
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float value = std::min(std::max(input[i], -32768.0f), 32767.0f);
+        samples[i] = static_cast<int16_t>(std::lrint(value));
+    }
+}
+
+static unsigned long greatestCommonDivisor(unsigned long a, unsigned long b) noexcept
+{
+    while (b != 0)
+    {
+        unsigned long remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+AudioConverter::AudioConverter(const WaveFormat& format)
+    : _format(format),
+      _sourceFrames(0),
+      _destinationFrames(0),
+      _monoBegin(0),
+      _samplesToSkip(0),
+      _framesIn(0),
+      _samplesOut(0)
+{
+    DEBUG << "Converting audio : " << format.sampleRate << "Hz, " << format.numChannels << " channel(s), "
+          << format.bitsPerSample << " bits, " << (format.audioFormat == floatFormat ? "float" : "PCM");
+
+    if (format.sampleRate != targetSampleRate)
+    {
+        /*
+         * The push resampler takes fixed blocks which must hold a whole number of frames on both sides,
+         * e.g. 44100 -> 16000 : 441 -> 160. Blocks are grown to at least 10 ms so that the kernel fits.
+         */
+
+        unsigned long divisor = greatestCommonDivisor(format.sampleRate, targetSampleRate);
+        std::size_t sourceUnit = format.sampleRate / divisor, destinationUnit = targetSampleRate / divisor;
+        std::size_t minimumFrames = std::max<std::size_t>(format.sampleRate / 100, 64);
+        std::size_t multiplier = (minimumFrames + sourceUnit - 1) / sourceUnit;
+
+        _sourceFrames = sourceUnit * multiplier;
+        _destinationFrames = destinationUnit * multiplier;
+
+        _resampler.reset(new webrtc::PushSincResampler(_sourceFrames, _destinationFrames));
+        _resampled.resize(_destinationFrames);
+
+        //the output lags the input by half the kernel, drop that so timestamps stay where they were
+        _samplesToSkip = static_cast<std::size_t>(std::lround(webrtc::PushSincResampler::AlgorithmicDelaySeconds(format.sampleRate) * targetSampleRate));
+
+        DEBUG << "Resampling in blocks of " << _sourceFrames << " -> " << _destinationFrames << " frames";
+    }
+
+    _mono.reserve(framesPerChunk + _sourceFrames);
+}
+
+void AudioConverter::emit(const float *samples, std::size_t count, std::vector<int16_t>& output)
+{
+    std::size_t skip = std::min(count, _samplesToSkip);
+    _samplesToSkip -= skip;
+    samples += skip;
+    count -= skip;
+
+    std::size_t oldSize = output.size();
+    output.resize(oldSize + count);
+    floatToSamples(samples, count, output.data() + oldSize);
+
+    _samplesOut += count;
+}
+
+void AudioConverter::resampleBlock(std::vector<int16_t>& output)
+{
+    _resampler->Resample(_mono.data() + _monoBegin, _sourceFrames, _resampled.data(), _resampled.size());
+    _monoBegin += _sourceFrames;
+
+    //never emit more than the input accounts for, the tail of the last block is padding
+    std::size_t count = std::min<unsigned long long>(_destinationFrames, expectedSamples(_framesIn) + _samplesToSkip - _samplesOut);
+    emit(_resampled.data(), count, output);
+}
+
+void AudioConverter::convert(const unsigned char *frames, std::size_t numberOfFrames, std::vector<int16_t>& output)
+{
+    while (numberOfFrames > 0)
+    {
+        std::size_t count = std::min(numberOfFrames, framesPerChunk);
+
+        std::size_t oldSize = _mono.size();
+        _mono.resize(oldSize + count);
+        downmixToFloat(frames, count, _format, _mono.data() + oldSize);
+
+        frames += count * _format.blockAlign;
+        numberOfFrames -= count;
+        _framesIn += count;
+
+        if (!_resampler)
+        {
+            emit(_mono.data(), _mono.size(), output);
+            _mono.clear();
+            continue;
+        }
+
+        while (_mono.size() - _monoBegin >= _sourceFrames)
+            resampleBlock(output);
+
+        //move the incomplete block to the front
+        _mono.erase(_mono.begin(), _mono.begin() + _monoBegin);
+        _monoBegin = 0;
+    }
+}
+
+void AudioConverter::flush(std::vector<int16_t>& output)
+{
+    if (!_resampler)
+        return;
+
+    //feed silence till every input frame, including the ones held back by the kernel, has come out
+    while (_samplesOut < expectedSamples(_framesIn))
+    {
+        _mono.resize(_monoBegin + _sourceFrames, 0.0f);
+        resampleBlock(output);
+
+        _mono.clear();
+        _monoBegin = 0;
+    }
+}
+
+std::size_t AudioConverter::expectedSamples(unsigned long long numberOfFrames) const noexcept
+{
+    return static_cast<std::size_t>(numberOfFrames * targetSampleRate / _format.sampleRate);
+}
+
+AudioConverter::~AudioConverter() = default;
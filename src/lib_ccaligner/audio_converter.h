@@ -0,0 +1,64 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_AUDIO_CONVERTER_H
+#define CCALIGNER_AUDIO_CONVERTER_H
+
+#include "commons.h"
+
+namespace webrtc
+{
+    class PushSincResampler;
+}
+
+enum waveFormatTag
+{
+    pcmFormat = 1,              //integer PCM
+    floatFormat = 3,            //IEEE float
+    extensibleFormat = 0xFFFE   //WAVE_FORMAT_EXTENSIBLE, actual format is stored in the SubFormat GUID
+};
+
+struct WaveFormat   //contents of the 'fmt ' chunk
+{
+    int audioFormat, numChannels, blockAlign, bitsPerSample;
+    unsigned long sampleRate, byteRate;
+};
+
+bool isTargetFormat(const WaveFormat& format) noexcept;    //16KHz, mono, 16 bit PCM : samples can be used as they are
+
+//decode frames of any supported format and average their channels; output is float in 16 bit range
+void downmixToFloat(const unsigned char *frames, std::size_t numberOfFrames, const WaveFormat& format, float *mono);
+
+class AudioConverter    //converts PCM/float audio of any sample rate and channel count to 16KHz, mono, 16 bit; chunk by chunk
+{
+    WaveFormat _format;
+    std::size_t _sourceFrames, _destinationFrames;              //resampler block sizes, both spanning the same duration
+    std::unique_ptr<webrtc::PushSincResampler> _resampler;     //not used if the audio already is at 16KHz
+    std::vector<float> _mono;                                   //downmixed frames waiting for a complete resampler block
+    std::size_t _monoBegin;                                     //[_monoBegin, end) of _mono is yet to be resampled
+    std::vector<float> _resampled;                              //output of a single resampler block
+    std::size_t _samplesToSkip;                                 //resampler delay, dropped from the beginning of output
+    unsigned long long _framesIn, _samplesOut;
+
+    void resampleBlock(std::vector<int16_t>& output);
+    void emit(const float *samples, std::size_t count, std::vector<int16_t>& output);
+
+public:
+    static const unsigned long targetSampleRate = 16000;
+    static const std::size_t framesPerChunk = 4096;            //frames downmixed at a time, bounds the scratch memory
+
+    explicit AudioConverter(const WaveFormat& format);
+    AudioConverter(const AudioConverter&) = delete;
+    AudioConverter& operator=(const AudioConverter&) = delete;
+
+    void convert(const unsigned char *frames, std::size_t numberOfFrames, std::vector<int16_t>& output); //append converted samples
+    void flush(std::vector<int16_t>& output);                   //drain the resampler once the audio has ended
+    std::size_t expectedSamples(unsigned long long numberOfFrames) const noexcept;  //16KHz samples for that many input frames
+
+    ~AudioConverter();
+};
+
+#endif //CCALIGNER_AUDIO_CONVERTER_H
@@ -0,0 +1,195 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "batch_aligner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+static double secondsSince(std::chrono::steady_clock::time_point started)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+std::string reasonOf(const std::exception& e)
+{
+    std::string reason(e.what());
+    std::size_t prefix = reason.find(" | ");
+
+    if (prefix != std::string::npos)
+        reason.erase(0, prefix + 3);
+
+    std::replace_if(reason.begin(), reason.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    reason.erase(reason.find_last_not_of(' ') + 1);
+    return reason;
+}
+
+BatchAligner::BatchAligner(Params *parameters) : _parameters(parameters), _linesRead(0)
+{
+    _manifest.open(_parameters->manifestFileName);
+
+    if (!_manifest)
+        FATAL(FileNotFound) << "Unable to open manifest " << _parameters->manifestFileName;
+}
+
+bool BatchAligner::readJob(BatchJob& job)
+{
+    std::string line;
+
+    while (std::getline(_manifest, line))
+    {
+        _linesRead++;
+        line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<std::string> fields;
+        std::istringstream columns(line);
+
+        for (std::string field; std::getline(columns, field, '\t'); )
+            fields.push_back(field);
+
+        fields.resize(std::max<std::size_t>(fields.size(), 3));
+
+        job = BatchJob();
+        job.line = _linesRead;
+        job.audioFileName = fields[0];
+        job.subtitleFileName = fields[1];
+        job.outputFileName = fields[2];
+        return true;
+    }
+
+    return false;
+}
+
+bool BatchAligner::nextJob(BatchJob& job)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_pending.empty())
+        return false;
+
+    job = _pending.front();
+    _pending.pop_front();
+    return true;
+}
+
+void BatchAligner::run(BatchJob& job)
+{
+    auto started = std::chrono::steady_clock::now();
+
+    try
+    {
+        if (job.audioFileName.empty() || job.subtitleFileName.empty())
+            FATAL(InvalidFile) << "Line " << job.line << " of the manifest does not list an audio and a subtitle file separated by a tab";
+
+        if (!std::ifstream(job.subtitleFileName))   //the parser would take a missing file for one without subtitles
+            FATAL(FileNotFound) << "Unable to open subtitles " << job.subtitleFileName;
+
+        Params parameters = _parameters->forJob(job.audioFileName, job.subtitleFileName, job.outputFileName);
+        job.outputFileName = parameters.outputFileName;
+
+        PocketsphinxAligner(&parameters, _model.get()).align();
+
+        if (parameters.removeWorkspace)     //kept for inspection if the job failed
+            Workspace(parameters.workspacePath).remove();
+
+        job.aligned = true;
+    }
+
+    catch (std::exception& e)
+    {
+        job.error = reasonOf(e);
+    }
+
+    job.seconds = secondsSince(started);
+
+    if (job.aligned)
+        INFO << "Aligned " << job.audioFileName << " in " << std::fixed << std::setprecision(2) << job.seconds << " s";
+    else
+        WARNING << "Unable to align " << job.audioFileName << " of line " << job.line << " : " << job.error;
+}
+
+void BatchAligner::work()
+{
+    BatchJob job;
+
+    while (nextJob(job))
+    {
+        run(job);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished.push_back(job);
+    }
+}
+
+bool BatchAligner::writeSummary() const
+{
+    std::ofstream summary(_parameters->summaryFileName);
+    summary << "line\taudio\tsubtitles\toutput\tstatus\tseconds\terror\n" << std::fixed << std::setprecision(3);
+
+    for (const BatchJob& job : _finished)
+    {
+        summary << job.line << "\t" << job.audioFileName << "\t" << job.subtitleFileName << "\t" << job.outputFileName << "\t"
+                << (job.aligned ? "aligned" : "failed") << "\t" << job.seconds << "\t" << job.error << "\n";
+    }
+
+    summary.close();
+
+    if (!summary)
+    {
+        WARNING << "Unable to write the summary of the batch to " << _parameters->summaryFileName;
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchAligner::align()
+{
+    auto started = std::chrono::steady_clock::now();
+
+    Workspace(_parameters->workspacePath).create();    //for the log of the shared model
+    _model = decltype(_model)(new AcousticModel(_parameters->modelPath, _parameters->alignerLogPath));
+
+    for (BatchJob job; readJob(job); )
+        _pending.push_back(job);
+
+    //no more threads than there are files to align
+    std::size_t numberOfWorkers = std::max<std::size_t>(1, std::min<std::size_t>(_parameters->jobs, _pending.size()));
+
+    INFO << "Aligning the " << _pending.size() << " files listed in " << _parameters->manifestFileName << ", " << numberOfWorkers << " at once...";
+
+    //the files of a job are only read while it is aligned, so memory is bounded by the number of jobs
+    std::vector<std::thread> workers;
+
+    for (std::size_t i = 1; i < numberOfWorkers; i++)
+        workers.emplace_back(&BatchAligner::work, this);
+
+    work();
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    std::sort(_finished.begin(), _finished.end(), [](const BatchJob& a, const BatchJob& b) {
+        return a.line < b.line;
+    });
+
+    std::size_t failed = std::count_if(_finished.begin(), _finished.end(), [](const BatchJob& job) {
+        return !job.aligned;
+    });
+
+    writeSummary();
+
+    INFO << "Aligned " << _finished.size() - failed << " of " << _finished.size() << " files in " << std::fixed << std::setprecision(2)
+         << secondsSince(started) << " s, " << failed << " failed. Summary written to " << _parameters->summaryFileName;
+
+    return failed == 0;
+}
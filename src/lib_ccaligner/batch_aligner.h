@@ -0,0 +1,65 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_BATCH_ALIGNER_H
+#define CCALIGNER_BATCH_ALIGNER_H
+
+#include "params.h"
+#include "recognize_using_pocketsphinx.h"
+
+#include <fstream>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct BatchJob     //a line of the manifest and how aligning it went
+{
+    std::size_t line;
+    std::string audioFileName, subtitleFileName, outputFileName;
+    bool aligned;
+    double seconds;
+    std::string error;
+
+    BatchJob() noexcept : line(0), aligned(false), seconds(0) {}
+};
+
+std::string reasonOf(const std::exception& e);      //message of the exception on one line, without the log prefix of FATAL
+
+/*
+ * Aligns every (audio, subtitle) pair listed in a manifest, up to -jobs of them at once, in one process.
+ * Each line of the manifest holds the paths of an audio file, its subtitles and, optionally, the output separated
+ * by tabs; empty lines and lines starting with # are skipped. The acoustic model is loaded once and shared by the
+ * decoders of all jobs. A job that fails is recorded in the summary and does not stop the others.
+ */
+
+class BatchAligner
+{
+    Params * _parameters;
+    std::unique_ptr<AcousticModel> _model;
+    std::ifstream _manifest;
+    std::size_t _linesRead;
+    std::deque<BatchJob> _pending;
+    std::vector<BatchJob> _finished;
+    std::mutex _mutex;                      //guards the pending and finished jobs
+
+    bool readJob(BatchJob& job);            //next line of the manifest, false at its end
+    bool nextJob(BatchJob& job);            //false once every job is taken
+    void run(BatchJob& job);                //align the files of the job, noting why if they could not be
+    void work();                            //run jobs until the manifest ends
+    bool writeSummary() const;
+
+public:
+    explicit BatchAligner(Params *parameters);
+    BatchAligner(const BatchAligner&) = delete;
+    BatchAligner& operator=(const BatchAligner&) = delete;
+
+    bool align();                           //true if every job was aligned
+    const std::vector<BatchJob>& jobs() const noexcept { return _finished; }     //in the order of the manifest
+};
+
+#endif //CCALIGNER_BATCH_ALIGNER_H
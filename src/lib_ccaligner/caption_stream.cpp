@@ -0,0 +1,81 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "caption_stream.h"
+#include "commons.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+CaptionStream::CaptionStream(const std::string& fileName) : _in(&std::cin), _cuesRead(0)
+{
+    if (fileName == "-")
+        return;
+
+    _file.open(fileName);   //waits for a writer when it is a named pipe
+
+    if (!_file)
+        FATAL(FileNotFound) << "Unable to open caption stream " << fileName;
+
+    _in = &_file;
+}
+
+CaptionStream::CaptionStream(std::istream& stream) : _in(&stream), _cuesRead(0)
+{
+}
+
+std::unique_ptr<SubtitleItem> CaptionStream::next()
+{
+    std::string line, number, timeLine, text;
+
+    //a cue is its number, its times and its text, up to a blank line or the end of the stream
+    while (std::getline(*_in, line))
+    {
+        line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+
+        if (line.empty())
+        {
+            if (timeLine.empty() && text.empty())   //blank lines between cues
+            {
+                number.clear();
+                continue;
+            }
+
+            break;
+        }
+
+        if (timeLine.empty() && line.find("-->") != std::string::npos)
+            timeLine = line;
+
+        else if (timeLine.empty())
+            number = line;
+
+        else
+            text += (text.empty() ? "" : " ") + line;
+    }
+
+    if (timeLine.empty())
+    {
+        if (!number.empty())
+            WARNING << "Caption stream ended in the middle of cue " << number;
+
+        return nullptr;
+    }
+
+    std::vector<std::string> times;
+    split(timeLine, ' ', times);
+
+    if (times.size() < 3)
+    {
+        WARNING << "Skipping cue with malformed times : " << timeLine;
+        return next();
+    }
+
+    _cuesRead++;
+    int subNo = number.empty() ? (int) _cuesRead : atoi(number.c_str());
+
+    return std::unique_ptr<SubtitleItem>(new SubtitleItem(subNo, times[0], times[2], text));
+}
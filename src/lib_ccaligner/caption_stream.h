@@ -0,0 +1,30 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_CAPTION_STREAM_H
+#define CCALIGNER_CAPTION_STREAM_H
+
+#include "srtparser.h"
+
+#include <fstream>
+#include <memory>
+
+class CaptionStream     //SubRip cues read one at a time as they arrive, from a file, a pipe or standard input
+{
+    std::ifstream _file;
+    std::istream * _in;
+    long int _cuesRead;
+
+public:
+    explicit CaptionStream(const std::string& fileName);   //"-" for standard input
+    explicit CaptionStream(std::istream& stream);
+    CaptionStream(const CaptionStream&) = delete;
+    CaptionStream& operator=(const CaptionStream&) = delete;
+
+    std::unique_ptr<SubtitleItem> next();   //waits till the cue is complete, nullptr at the end of the stream
+};
+
+#endif //CCALIGNER_CAPTION_STREAM_H
@@ -6,10 +6,16 @@
 
 #include "ccaligner.h"
 
-CCAligner::CCAligner(Params* parameters) : logFile(parameters->logPath)
+CCAligner::CCAligner(Params* parameters) : _workspace(parameters->workspacePath), _aligned(false)
 {
     _parameters = parameters;
-  
+
+    //tempFiles/ is only created when something is written to it, a workspace asked for is created up front for the logs
+    if (_parameters->workspacePath != Workspace::defaultDirectory)
+        _workspace.create();
+
+    logFile.open(_parameters->logPath);
+
     Logger::Sink sink(logFile, false);
     sink.setMinimumOutputLevel(Logger::Level::verbose);
     getLogger().addSink(sink);
@@ -19,11 +25,22 @@ CCAligner::CCAligner(Params* parameters) : logFile(parameters->logPath)
 
 CCAligner::~CCAligner() {
     logFile.close();
+
+    if (_aligned && _parameters->removeWorkspace)
+        _workspace.remove();
 }
 
 int CCAligner::initAligner()
 {
-    if(_parameters->chosenAlignerType == approxAligner)
+    if(!_parameters->socketPath.empty())
+    {
+        AlignmentServer(_parameters).serve();
+    }
+    else if(!_parameters->manifestFileName.empty())
+    {
+        BatchAligner(_parameters).align();
+    }
+    else if(_parameters->chosenAlignerType == approxAligner)
     {
         ApproxAligner(_parameters->subtitleFileName, srt).align();
     }
@@ -36,6 +53,7 @@ int CCAligner::initAligner()
         FATAL(InvalidParameters) << "Unsupported Aligner Type!";
     }
 
+    _aligned = true;
     return 1;
 }
 
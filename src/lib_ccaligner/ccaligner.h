@@ -9,11 +9,15 @@
 
 #include "params.h"
 #include "recognize_using_pocketsphinx.h"
+#include "batch_aligner.h"
+#include "alignment_server.h"
 
 class CCAligner
 {
     Params * _parameters;
+    Workspace _workspace;
     std::ofstream logFile;
+    bool _aligned;                                      //workspace is only removed after a successful run
 
 public:
 
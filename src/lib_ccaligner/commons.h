@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <regex>
 #include <cstdarg>
+#include <cstring>
 #include <memory>
 #include "logger.h"
 
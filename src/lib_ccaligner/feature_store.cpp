@@ -0,0 +1,295 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "feature_store.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+const std::size_t FeatureStore::headerSize;
+
+static const char cacheMagic[8] = {'C', 'C', 'A', 'F', 'E', 'A', 'T', '1'};
+static const uint64_t fnvOffsetBasis = 14695981039346656037ULL, fnvPrime = 1099511628211ULL;
+static const long int samplesPerBlock = 1 << 16;   //samples handed to the front end at a time
+
+std::mutex& frontEndCreation()
+{
+    static std::mutex creation;
+    return creation;
+}
+
+static uint64_t hashBytes(const std::string& bytes, uint64_t hash) noexcept
+{
+    for (unsigned char byte : bytes)
+    {
+        hash ^= byte;
+        hash *= fnvPrime;
+    }
+
+    return hash;
+}
+
+FeatureStore::FeatureStore() noexcept
+    : _data(nullptr),
+      _numberOfFrames(0),
+      _numberOfCoefficients(0),
+      _frameRate(0),
+      _frameShift(0),
+      _key(0)
+{
+
+}
+
+uint64_t FeatureStore::hashSamples(const SampleView& samples, uint64_t hash) noexcept
+{
+    for (int16_t sample : samples)
+    {
+        hash ^= static_cast<uint16_t>(sample);
+        hash *= fnvPrime;
+    }
+
+    return hash;
+}
+
+uint64_t FeatureStore::parameterHash(cmd_ln_t *config)
+{
+    uint64_t hash = hashBytes(std::string(cacheMagic, sizeof(cacheMagic)), fnvOffsetBasis);
+
+    //every front end parameter, i.e. the defaults overridden by the model's feat.params
+    for (const arg_t *arg = fe_get_args(); arg->name != nullptr; arg++)
+    {
+        std::string name(arg->name);
+
+        if (name == "-remove_silence" || name == "-verbose" || name == "-input_endian")
+            continue;   //the cache never drops silence, and samples are always handed over in host order
+
+        std::ostringstream value;
+
+        switch (arg->type & ~ARG_REQUIRED)
+        {
+            case ARG_INTEGER :
+            case ARG_BOOLEAN :  value << cmd_ln_int_r(config, arg->name);
+                break;
+
+            case ARG_FLOATING : value << std::setprecision(17) << cmd_ln_float_r(config, arg->name);
+                break;
+
+            case ARG_STRING :
+            {
+                const char *text = cmd_ln_str_r(config, arg->name);
+                value << (text == nullptr ? "" : text);
+                break;
+            }
+
+            default :   continue;
+        }
+
+        hash = hashBytes(name + "=" + value.str() + "\n", hash);
+    }
+
+    return hash;
+}
+
+uint64_t FeatureStore::cacheKey(const SampleView& samples, cmd_ln_t *config)
+{
+    return hashSamples(samples, parameterHash(config));
+}
+
+std::string FeatureStore::cacheFileName(const std::string& directory, uint64_t key)
+{
+    std::ostringstream fileName;
+    fileName << directory;
+
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+        fileName << '/';
+
+    fileName << std::hex << std::setw(16) << std::setfill('0') << key << ".feat";
+    return fileName.str();
+}
+
+bool FeatureStore::compute(SampleSource& audio, cmd_ln_t *config)
+{
+    DEBUG << "Computing features of the complete audio";
+
+    //frames must line up with the samples, so the front end should not drop silence
+    long int removeSilence = cmd_ln_int_r(config, "-remove_silence");
+    cmd_ln_set_int_r(config, "-remove_silence", 0);
+    fe_t *fe;
+    {
+        std::lock_guard<std::mutex> lock(frontEndCreation());
+        fe = fe_init_auto_r(config);
+    }
+    cmd_ln_set_int_r(config, "-remove_silence", removeSilence);
+
+    if (fe == nullptr)
+    {
+        FATAL(UnknownError) << "Failed to initialise feature extraction, see log for details";
+    }
+
+    int32 frameShift, frameSize;
+    fe_get_input_size(fe, &frameShift, &frameSize);
+
+    _mappedFile.close();
+    _frames.clear();
+    _numberOfCoefficients = fe_get_output_size(fe);
+    _frameRate = cmd_ln_int32_r(config, "-frate");
+    _frameShift = frameShift;
+    _key = parameterHash(config);   //samples are hashed as they pass, streamed audio can not be read twice
+
+    std::vector<mfcc_t> lastFrame(_numberOfCoefficients);
+    std::vector<mfcc_t *> rows;
+    fe_start_utt(fe);
+
+    for (long int position = 0; ; position += samplesPerBlock)
+    {
+        SampleView block = audio.getSamples(position, samplesPerBlock);
+
+        if (block.empty())
+            break;
+
+        _key = hashSamples(block, _key);
+
+        const int16 *samples = block.data();
+        std::size_t remaining = block.size();
+        int32 numberOfFrames = 0;
+
+        fe_process_frames(fe, &samples, &remaining, nullptr, &numberOfFrames, nullptr);    //only counts the frames
+
+        std::size_t firstFrame = _frames.size() / _numberOfCoefficients;
+        _frames.resize((firstFrame + numberOfFrames) * _numberOfCoefficients);
+        rows.assign(numberOfFrames + 1, lastFrame.data());  //never empty, or the front end would only count again
+
+        for (int32 i = 0; i < numberOfFrames; i++)
+            rows[i] = _frames.data() + (firstFrame + i) * _numberOfCoefficients;
+
+        fe_process_frames(fe, &samples, &remaining, rows.data(), &numberOfFrames, nullptr);
+        _frames.resize((firstFrame + numberOfFrames) * _numberOfCoefficients);
+    }
+
+    int32 numberOfFrames = 0;
+    fe_end_utt(fe, lastFrame.data(), &numberOfFrames);    //samples left over after the last complete frame
+
+    if (numberOfFrames > 0)
+        _frames.insert(_frames.end(), lastFrame.begin(), lastFrame.end());
+
+    fe_free(fe);
+
+    _data = _frames.data();
+    _numberOfFrames = _frames.size() / _numberOfCoefficients;
+    computeMean();
+
+    DEBUG << "Computed " << _numberOfFrames << " frames of " << _numberOfCoefficients << " coefficients";
+    return true;
+}
+
+bool FeatureStore::save(const std::string& fileName) const
+{
+    std::string temporaryFileName = fileName + ".tmp";     //renamed once complete, readers never see a partial file
+    std::ofstream out(temporaryFileName, std::ios::binary);
+
+    if (!out)
+    {
+        WARNING << "Unable to write feature cache : " << temporaryFileName;
+        return false;
+    }
+
+    unsigned char header[headerSize] = {};
+    uint32_t numberOfCoefficients = _numberOfCoefficients, frameRate = _frameRate;
+    uint64_t numberOfFrames = _numberOfFrames;
+
+    std::memcpy(header, cacheMagic, sizeof(cacheMagic));
+    std::memcpy(header + 8, &_key, sizeof(_key));
+    std::memcpy(header + 16, &numberOfCoefficients, sizeof(numberOfCoefficients));
+    std::memcpy(header + 20, &frameRate, sizeof(frameRate));
+    std::memcpy(header + 24, &numberOfFrames, sizeof(numberOfFrames));
+
+    out.write(reinterpret_cast<const char *>(header), headerSize);
+    out.write(reinterpret_cast<const char *>(_data), _numberOfFrames * _numberOfCoefficients * sizeof(mfcc_t));
+    out.close();
+
+#ifdef WIN32
+    std::remove(fileName.c_str());  //rename() does not replace an existing file on Windows
+#endif
+
+    if (!out || std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+    {
+        WARNING << "Unable to write feature cache : " << fileName;
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    DEBUG << "Saved " << _numberOfFrames << " frames to " << fileName;
+    return true;
+}
+
+bool FeatureStore::load(const std::string& fileName, uint64_t key, cmd_ln_t *config)
+{
+    if (!_mappedFile.open(fileName))
+        return false;
+
+    const unsigned char *data = _mappedFile.data();
+    uint64_t storedKey = 0, numberOfFrames = 0;
+    uint32_t numberOfCoefficients = 0, frameRate = 0;
+
+    if (_mappedFile.size() >= headerSize)
+    {
+        std::memcpy(&storedKey, data + 8, sizeof(storedKey));
+        std::memcpy(&numberOfCoefficients, data + 16, sizeof(numberOfCoefficients));
+        std::memcpy(&frameRate, data + 20, sizeof(frameRate));
+        std::memcpy(&numberOfFrames, data + 24, sizeof(numberOfFrames));
+    }
+
+    //written by another version or byte order, or for other audio/parameters
+    if (_mappedFile.size() < headerSize || std::memcmp(data, cacheMagic, sizeof(cacheMagic)) != 0 || storedKey != key ||
+        frameRate == 0 || _mappedFile.size() != headerSize + numberOfFrames * numberOfCoefficients * sizeof(mfcc_t))
+    {
+        DEBUG << "Ignoring stale feature cache : " << fileName;
+        _mappedFile.close();
+        return false;
+    }
+
+    _frames.clear();
+    _frames.shrink_to_fit();
+    _data = reinterpret_cast<const mfcc_t *>(data + headerSize);
+    _numberOfFrames = numberOfFrames;
+    _numberOfCoefficients = numberOfCoefficients;
+    _frameRate = frameRate;
+    _frameShift = static_cast<int>(cmd_ln_float32_r(config, "-samprate")) / frameRate;
+    _key = key;
+    computeMean();
+
+    DEBUG << "Loaded " << _numberOfFrames << " frames from " << fileName;
+    return true;
+}
+
+void FeatureStore::computeMean()
+{
+    std::vector<double> sum(_numberOfCoefficients, 0.0);
+
+    for (std::size_t i = 0; i < _numberOfFrames; i++)
+        for (int j = 0; j < _numberOfCoefficients; j++)
+            sum[j] += MFCC2FLOAT(frame(i)[j]);
+
+    _mean.resize(_numberOfCoefficients);
+
+    for (int j = 0; j < _numberOfCoefficients; j++)
+        _mean[j] = FLOAT2MFCC(_numberOfFrames ? sum[j] / _numberOfFrames : 0.0);
+}
+
+mfcc_t ** FeatureStore::copyFrames(std::size_t firstFrame, std::size_t numberOfFrames, std::vector<mfcc_t>& buffer, std::vector<mfcc_t *>& rows) const
+{
+    firstFrame = std::min(firstFrame, _numberOfFrames);
+    numberOfFrames = std::min(numberOfFrames, _numberOfFrames - firstFrame);
+
+    buffer.assign(frame(firstFrame), frame(firstFrame + numberOfFrames));
+    rows.resize(numberOfFrames);
+
+    for (std::size_t i = 0; i < numberOfFrames; i++)
+        rows[i] = buffer.data() + i * _numberOfCoefficients;
+
+    return rows.data();
+}
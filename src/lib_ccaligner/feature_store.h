@@ -0,0 +1,70 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_FEATURE_STORE_H
+#define CCALIGNER_FEATURE_STORE_H
+
+#include "read_wav_file.h"
+#include "pocketsphinx.h"
+
+#include <mutex>
+
+//sphinxbase front ends write static frequency warping parameters when created, so front ends and the decoders holding
+//them are created one at a time under this lock when several files are aligned at once
+std::mutex& frontEndCreation();
+
+/*
+ * Cache file layout (host byte order) :
+ *
+ *  0   char[8]     "CCAFEAT1"
+ *  8   uint64      key, hash of the samples and the front end parameters
+ *  16  uint32      number of coefficients per frame
+ *  20  uint32      frame rate
+ *  24  uint64      number of frames
+ *  32  mfcc_t[]    frames, one after the other
+ */
+
+class FeatureStore  //cepstral frames of the complete audio, frame i begins at sample i * frameShift()
+{
+    std::vector<mfcc_t> _frames;            //frames computed in this run
+    MappedFile _mappedFile;                 //cache file the frames are served from, if loaded
+    const mfcc_t * _data;                   //whichever of the above holds the frames
+    std::size_t _numberOfFrames;
+    int _numberOfCoefficients, _frameRate, _frameShift;
+    uint64_t _key;
+    std::vector<mfcc_t> _mean;              //mean of every frame, the global cepstral mean of the audio
+
+    void computeMean();
+
+public:
+    static const std::size_t headerSize = 32;
+
+    FeatureStore() noexcept;
+    FeatureStore(const FeatureStore&) = delete;
+    FeatureStore& operator=(const FeatureStore&) = delete;
+
+    static uint64_t hashSamples(const SampleView& samples, uint64_t hash) noexcept;   //FNV-1a over 16 bit samples
+    static uint64_t parameterHash(cmd_ln_t *config);                                //every front end parameter
+    static uint64_t cacheKey(const SampleView& samples, cmd_ln_t *config);          //samples + parameters, see key()
+    static std::string cacheFileName(const std::string& directory, uint64_t key);
+
+    bool compute(SampleSource& audio, cmd_ln_t *config);                    //run the front end over the audio, reading it once in order
+    bool save(const std::string& fileName) const;                           //write atomically, false on failure
+    bool load(const std::string& fileName, uint64_t key, cmd_ln_t *config); //map cached frames, false if missing or stale
+
+    std::size_t size() const noexcept { return _numberOfFrames; }
+    int numberOfCoefficients() const noexcept { return _numberOfCoefficients; }
+    int frameRate() const noexcept { return _frameRate; }
+    int frameShift() const noexcept { return _frameShift; }
+    uint64_t key() const noexcept { return _key; }
+    const mfcc_t * frame(std::size_t index) const noexcept { return _data + index * _numberOfCoefficients; }
+    const std::vector<mfcc_t>& mean() const noexcept { return _mean; }
+
+    //writable copy of frames [firstFrame, firstFrame + numberOfFrames), as ps_process_cep() modifies its input
+    mfcc_t ** copyFrames(std::size_t firstFrame, std::size_t numberOfFrames, std::vector<mfcc_t>& buffer, std::vector<mfcc_t *>& rows) const;
+};
+
+#endif //CCALIGNER_FEATURE_STORE_H
@@ -6,15 +6,14 @@
 
 #include "generate_approx_timestamp.h"
 
-int CurrentSub::_wordNumber;    //defining a static data member
-
 CurrentSub::CurrentSub(SubtitleItem *sub) noexcept
     : _sub(sub),
       _sentenceLength(sub->getDialogue().size()),
       _wordCount(sub->getWordCount()),
-      _dialogueDuration(getDuration(sub->getStartTime(), sub->getEndTime()))
+      _dialogueDuration(getDuration(sub->getStartTime(), sub->getEndTime())),
+      _wordNumber(0)
 {
-    _wordNumber = 0;
+
 }
 
 void CurrentSub::printToSRT(const std::string& fileName, outputOptions printOption) const
@@ -25,7 +25,7 @@ class CurrentSub    //processing one subtitle at a time
 {
     int _sentenceLength, _wordCount;    //length of the dialogue, number of words in that dialogue
     long _dialogueDuration;             //duration of the dialogue in ms
-    static int _wordNumber;             //used to maintain the information about which word is being processed
+    int _wordNumber;                    //used to maintain the information about which word is being processed
     SubtitleItem *_sub;                 //the subtitle itself (SubtitleItem is defined in srtparser.h)
 
 public:
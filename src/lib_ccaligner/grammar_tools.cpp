@@ -32,409 +32,378 @@ void ConfigureQuickGenerationOptions(bool &generateQuickDict, bool &generateQuic
     }
 }
 
-void CreateTempDirectories() // Create temporary directories
+void AddSentence(Grammar &grammar, std::vector<std::string> words) //Add a dialogue to the grammar being generated
 {
-    //create temporary directories in case they don't exist
-    DEBUG << "Creating temporary directories at tempFiles/";
+    if (words.empty())
+        return;
 
-#ifndef WIN32
-    int rv = systemGetStatus("mkdir -p tempFiles/corpus tempFiles/dict tempFiles/vocab tempFiles/fsg tempFiles/lm");
-#else
-    int rv = systemGetStatus("if not exist tempFiles\\ mkdir tempFiles\\corpus tempFiles\\dict tempFiles\\vocab tempFiles\\fsg tempFiles\\lm");
-#endif
+    for (std::string &word : words)
+        word = stringToLower(word);
 
-    if (rv != 0)
+    if (grammar.has(corpus))
     {
-        FATAL(UnknownError) << "Unable to create directory tempFiles/ : " << strerror(errno);
-    }
+        std::string sentence = "<s>";
 
-    DEBUG << "Directories created successfully!";
-}
+        for (const std::string &word : words)
+            sentence += " " + word;
 
-void CreateNewGrammarFiles(grammarName name, std::ofstream &corpusDump, std::ofstream &fsgDump,
-    std::ofstream &vocabDump, std::ofstream &dictDump, std::ofstream &phoneticCorpusDump, std::ofstream &logDump) //Create and initialize files for writing.
-{
-    //setting exceptions to be thrown on failure
-    corpusDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fsgDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    vocabDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    dictDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    phoneticCorpusDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    logDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-    try
-    {
-        logDump.open("tempFiles/grammar.log", std::ios::binary);
-        logDump.close();
-    }
-    catch (std::system_error& e)
-    {
-        FATAL(UnknownError) << e.code().message();
+        grammar.corpus.push_back(sentence + " </s>");
     }
 
-    if (name == corpus || name == complete_grammar)
+    if (grammar.has(vocab) || grammar.has(lm) || grammar.has(dict))
+        grammar.words.addSentence(words);
+
+    if (grammar.has(phone_lm))
     {
-        INFO << "Creating Corpus : tempFiles/corpus/corpus.txt";
+        std::vector<std::string> phoneticSentence(1, "SIL");
 
-        try
-        {
-            corpusDump.open("tempFiles/corpus/corpus.txt", std::ios::binary);
-            corpusDump.close();
-        }
-        catch (std::system_error& e)
+        for (const std::string &word : words)
         {
-            FATAL(UnknownError) << e.code().message();
+            for (const Phoneme &ph : stringToPhoneme(word))
+                if (!ph.empty())    //punctuation
+                    phoneticSentence.push_back(ph);
         }
-    }
 
-    if (name == phone_lm || name == complete_grammar)
-    {
-        INFO << "Creating Phonetic Corpus : tempFiles/corpus/phoneticCorpus.txt";
+        phoneticSentence.push_back("SIL");
 
-        try
-        {
-            phoneticCorpusDump.open("tempFiles/corpus/phoneticCorpus.txt", std::ios::binary);
-            phoneticCorpusDump.close();
-        }
-        catch (std::system_error& e)
-        {
-            FATAL(UnknownError) << e.code().message();
-        }
+        std::string sentence;
+
+        for (const std::string &phone : phoneticSentence)
+            sentence += phone + " ";
+
+        grammar.phoneticCorpus.push_back(sentence);
+        grammar.phones.addSentence(phoneticSentence);
     }
 }
 
-void CreateBiasedLM(grammarName name, bool generateQuickLM) //Create biased language model
+static std::string quickPhonemes(const std::string &word)   //phonemes of the rule based g2p, separated by spaces
 {
-    int rv;
-    if (name == lm || name == complete_grammar)
-    {
-        INFO << "Creating Biased Language Model : tempFiles/lm/complete.lm";
+    std::string phonemes;
 
-        if (generateQuickLM)
-        {
-            rv = systemGetStatus("perl quick_lm.pl -s tempFiles/corpus/corpus.txt 2>tempFiles/grammar.log");
+    for (const Phoneme &ph : stringToPhoneme(word))
+        if (!ph.empty())
+            phonemes += phonemes.empty() ? ph : " " + ph;
 
-            if (rv != 0)
-                FATAL(UnknownError) << "Something went wrong while creating Phonetic Language Model!";
+    return phonemes;
+}
 
-#ifndef WIN32
-            rv = systemGetStatus("mv tempFiles/corpus/corpus.txt.arpabo tempFiles/lm/complete.lm 2>tempFiles/grammar.log");
-#else
-            rv = systemGetStatus("move tempFiles\\corpus\\corpus.txt.arpabo tempFiles\\lm\\complete.lm 2>tempFiles\\grammar.log");
-#endif
-            if (rv != 0)
-                FATAL(UnknownError) << "Something went wrong while moving phonetic model!";
-        }
-        else
-        {
-            rv = systemGetStatus("text2idngram -vocab tempFiles/vocab/complete.vocab -idngram tempFiles/lm/lm.idngram <  tempFiles/corpus/corpus.txt 2>tempFiles/grammar.log");
+static std::map<std::string, std::string> RunSeq2Seq(const Workspace &workspace, const std::vector<std::string> &words)   //g2p-seq2seq only reads and writes files
+{
+    INFO << "Creating the Dictionary of " << words.size() << " words, this might take some time depending "
+        "on your TensorFlow configuration.";
 
-            if (rv != 0)
-                FATAL(UnknownError) << "Something went wrong while creating idngram file!";
+    workspace.create();
 
-            rv = systemGetStatus("idngram2lm -vocab_type 0 -idngram tempFiles/lm/lm.idngram -vocab tempFiles/vocab/complete.vocab  -arpa tempFiles/lm/complete.lm 2>tempFiles/grammar.log");
+    std::string vocabularyFileName = workspace.path("vocab/g2p.vocab"), dictionaryFileName = workspace.path("dict/g2p.dict");
 
-            if (rv != 0)
-                FATAL(UnknownError) << "Something went wrong while creating biased language model!";
-        }
+    {
+        std::ofstream vocabulary(vocabularyFileName, std::ios::binary);
+
+        for (const std::string &word : words)
+            vocabulary << word << "\n";
+
+        if (!vocabulary)
+            FATAL(UnknownError) << "Something went wrong while creating vocabulary!";
     }
+
+    std::string command = "g2p-seq2seq --decode \"" + vocabularyFileName + "\" --model g2p-seq2seq-cmudict/ > \"" + dictionaryFileName + "\"";
+    int rv = systemGetStatus(command.c_str());
+
+    if (rv != 0)
+    {
+        FATAL(UnknownError) << "Something went wrong while creating dictionary!";
+    }
+
+    PronunciationStore generated;
+
+    if (!generated.readDictionary(dictionaryFileName))
+        FATAL(UnknownError) << "Something went wrong while creating dictionary!";
+
+    return generated.entries();
 }
 
-void GenerateDict(bool generateQuickDict) // Generate dictionary from tensor flow (or not if making quick dict)
+void GenerateDict(Grammar &grammar, bool generateQuickDict) // Generate dictionary from tensor flow (or not if making quick dict)
 {
-    if (generateQuickDict)
+    //words of the lexicon and of earlier runs are looked up, only the rest goes through g2p
+    PronunciationStore lexicon, cache;
+    bool useLexicon = false, useCache = false;
+    std::string cacheFileName = grammar.pronunciationCachePath.empty() ? "" : grammar.pronunciationCachePath + "/g2p-seq2seq.store";
+
+    if (!grammar.lexiconPath.empty())
     {
-        std::ifstream vocabInput("tempFiles/vocab/complete.vocab");
-        std::ofstream dictDump;
+        uint64_t stamp = PronunciationStore::fileStamp(grammar.lexiconPath);
+        std::string lexiconFileName = grammar.pronunciationCachePath.empty() ? "" : grammar.pronunciationCachePath + "/lexicon.store";
 
-        try
-        {
-            dictDump.open("tempFiles/dict/complete.dict", std::ios::binary);
-        }
-        catch (std::system_error& e)
-        {
-            FATAL(UnknownError) << e.code().message();
-        }
+        if (stamp == 0)
+            FATAL(FileNotFound) << "Lexicon " << grammar.lexiconPath << " does not exist!";
 
-        std::string word;
-        std::vector<std::string> phonemes;
-        bool beginWriting = false;
+        useLexicon = !lexiconFileName.empty() && lexicon.load(lexiconFileName, stamp);
 
-        while (std::getline(vocabInput, word))
+        if (!useLexicon)
         {
-            if (beginWriting)
-            {
-                phonemes = stringToPhoneme(word);
+            if (!lexicon.readDictionary(grammar.lexiconPath))
+                FATAL(InvalidFile) << "Unable to read lexicon " << grammar.lexiconPath;
 
-                dictDump << word << " ";
+            if (!lexiconFileName.empty())
+                lexicon.save(lexiconFileName);
 
-                for (std::string ph : phonemes)
-                    dictDump << ph << " ";
-                dictDump << "\n";
-            }
-
-            if (word == "<s>")
-                beginWriting = true;
+            useLexicon = true;
         }
-
-        vocabInput.close();
-        dictDump.close();
     }
-    else
+
+    if (!cacheFileName.empty() && !generateQuickDict)
+        useCache = cache.load(cacheFileName);
+
+    std::map<std::string, std::string> pronunciations;
+    std::vector<std::string> unknownWords;
+
+    for (const std::string &word : grammar.words.vocabulary())
     {
-        INFO << "Creating the Dictionary, this might take some time depending "
-            "on your TensorFlow configuration : tempFiles/dict/complete.dict";
-        int rv = systemGetStatus("g2p-seq2seq --decode tempFiles/vocab/complete.vocab --model g2p-seq2seq-cmudict/ > tempFiles/dict/complete.dict");
+        if (word == "<s>" || word == "</s>")
+            continue;
 
-        if (rv != 0)
-        {
-            FATAL(UnknownError) << "Something went wrong while creating dictionary!";
-        }
+        std::string phonemes;
+
+        if ((useLexicon && lexicon.find(word, phonemes)) || (useCache && cache.find(word, phonemes)))
+            pronunciations.emplace(word, phonemes);
+        else
+            unknownWords.push_back(word);
     }
 
-}
+    DEBUG << pronunciations.size() << " words found in the lexicon or cache, " << unknownWords.size() << " left for g2p";
 
+    if (generateQuickDict)
+    {
+        for (const std::string &word : unknownWords)
+            pronunciations.emplace(word, quickPhonemes(word));
+    }
 
-std::string getFileData(std::string _fileName)           //returns whole read file. Used to read text files
-{
-    std::ifstream infile(_fileName);
-    std::string allData = "";
-    std::string line;
-    while (std::getline(infile, line))
+    else if (!unknownWords.empty())
     {
-        std::istringstream iss(line);
-        allData += line + "\n";
+        std::map<std::string, std::string> generated = RunSeq2Seq(grammar.workspace, unknownWords);
+
+        if (!cacheFileName.empty())
+            PronunciationStore::append(cacheFileName, generated);
+
+        pronunciations.insert(generated.begin(), generated.end());
+    }
+
+    //in the order of the vocabulary, as g2p-seq2seq writes it
+    for (const std::string &word : grammar.words.vocabulary())
+    {
+        auto found = pronunciations.find(word);
+
+        if (found != pronunciations.end())
+            grammar.dictionary.emplace_back(found->first, found->second);
     }
-    return allData;
 }
 
-bool generate(std::string transcriptFileName, grammarName name) //Generate Grammar from text files.
+void WriteGrammarFiles(const Grammar &grammar) //Write what is generated to the workspace, to inspect or reuse it
 {
-    std::string transcript = getFileData(transcriptFileName);
+    const Workspace &workspace = grammar.workspace;
+    workspace.create();
 
-    bool generateQuickDict = false, generateQuickLM = false;
-    int rv;
+    auto writeLines = [](const std::string &fileName, const std::vector<std::string> &lines) {
+        std::ofstream out(fileName, std::ios::binary);
 
-    ConfigureQuickGenerationOptions(generateQuickDict, generateQuickLM, name);
+        for (const std::string &line : lines)
+            out << line << "\n";
 
-    CreateTempDirectories();
+        if (!out)
+            FATAL(UnknownError) << "Unable to write " << fileName;
+    };
 
-    std::ofstream corpusDump, phoneticCorpusDump, fsgDump, vocabDump, dictDump, logDump;
+    if (grammar.has(corpus))
+    {
+        INFO << "Creating Corpus : " << workspace.path("corpus/corpus.txt");
+        writeLines(workspace.path("corpus/corpus.txt"), grammar.corpus);
+    }
 
-    CreateNewGrammarFiles(name, corpusDump, fsgDump, vocabDump, dictDump, phoneticCorpusDump, logDump);
+    if (grammar.has(vocab) && !grammar.words.writeVocabulary(workspace.path("vocab/complete.vocab")))
+        FATAL(UnknownError) << "Something went wrong while creating vocabulary!";
 
-    //Writing Files
-    if (name == corpus || name == complete_grammar)
+    if (grammar.has(dict))
     {
-        try
-        {
-            corpusDump.open("tempFiles/corpus/corpus.txt", std::ios::binary | std::ios::app);
-        }
-        catch (std::system_error& e)
-        {
-            FATAL(FileNotFound) << e.code().message();
-        }
+        std::vector<std::string> entries;
+
+        for (const auto &entry : grammar.dictionary)
+            entries.push_back(entry.first + " " + entry.second);
 
-        corpusDump << "<s> " << stringToLower(transcript) << " </s>\n";
-        corpusDump.close();
+        writeLines(workspace.dictPath(), entries);
     }
 
-	if (name == phone_lm || name == complete_grammar)
-	{
-		try
-		{
-			phoneticCorpusDump.open("tempFiles/corpus/phoneticCorpus.txt", std::ios::binary | std::ios::app);
-		}
+    if (grammar.has(lm))
+    {
+        INFO << "Creating Biased Language Model : " << workspace.lmPath();
 
-		catch (std::system_error& e)
-		{
-			FATAL(FileNotFound) << e.code().message();
-		}
+        if (!grammar.words.writeARPA(workspace.lmPath()))
+            FATAL(UnknownError) << "Something went wrong while creating biased language model!";
+    }
 
-		std::istringstream iss(transcript);
-		std::vector<std::string> SplitTranscript((std::istream_iterator<std::string>(iss)),
-			std::istream_iterator<std::string>()); //split transcript into words
+    if (grammar.has(phone_lm))
+    {
+        INFO << "Creating Phonetic Language Model : " << workspace.phoneticLmPath();
+        writeLines(workspace.path("corpus/phoneticCorpus.txt"), grammar.phoneticCorpus);
 
-		size_t numberOfWords = SplitTranscript.size();
-		std::string printPhoneticCourpus = "SIL ";
+        if (!grammar.phones.writeARPA(workspace.phoneticLmPath()))
+            FATAL(UnknownError) << "Something went wrong while creating Phonetic Language Model!";
+    }
+}
+
+void WriteSubtitleFSG(const Workspace &workspace, SubtitleItem *sub) //Write the grammar of a dialogue, named after its start time
+{
+    long int startTime = sub->getStartTime();
+    std::string fsgFileName(workspace.path("fsg/" + std::to_string(startTime)));
+    fsgFileName += ".fsg";
 
-		for (int i = 0; i<numberOfWords; i++)
-		{
-			std::vector<Phoneme> phones = stringToPhoneme(stringToLower(SplitTranscript[i]));
+    std::ofstream fsgDump;
+    fsgDump.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 
-			for (Phoneme ph : phones)
-				printPhoneticCourpus += ph + " ";
-		}
+    try
+    {
+        fsgDump.open(fsgFileName, std::ios::binary);
+    }
 
-		printPhoneticCourpus += "SIL\n";
+    catch(std::system_error& e)
+    {
+        FATAL(FileNotFound) << e.code().message();
+    }
 
-		phoneticCorpusDump << printPhoneticCourpus;
-		phoneticCorpusDump.close();
-	}
+    int numberOfWords = sub->getWordCount();
 
-    //FSG not needed for transcription
+    fsgDump<<"FSG_BEGIN CUSTOM_FSG\n";
+    fsgDump<<"NUM_STATES "<<(numberOfWords * 2) + 2<<"\n";
+    fsgDump<<"START_STATE 0\n";
+    fsgDump<<"FINAL_STATE "<<(numberOfWords * 2) + 1<<"\n\n";
+    fsgDump<<"# Transitions\n";
 
-    if (name == vocab || name == complete_grammar)
+    for(int i=0;i<numberOfWords;i++)
     {
-        rv = systemGetStatus("text2wfreq < tempFiles/corpus/corpus.txt 2>tempFiles/grammar.log | wfreq2vocab > tempFiles/vocab/complete.vocab 2>tempFiles/grammar_wfreq2vocab.log");
-
-        if (rv != 0)
-            FATAL(UnknownError) << "Something went wrong while creating vocabulary!";
+        fsgDump<<"TRANSITION "<<"0 "<<i+1<<" 0.0909\n";
     }
-
-    if (name == dict || name == complete_grammar)
+    for(int i=numberOfWords, counter = 1;counter<=numberOfWords;i++,counter++)
     {
-        GenerateDict(generateQuickDict);
+        fsgDump<<"TRANSITION "<<counter<<" "<<i+1<<" 1.0 "<<stringToLower(sub->getWordByIndex(counter-1))<<"\n";
+    }
+    for(int i=numberOfWords + 1;i<numberOfWords * 2 + 1;i++)
+    {
+        fsgDump<<"TRANSITION "<<i<<" "<<numberOfWords * 2 + 1<<" 0.0909\n";
     }
 
-    CreateBiasedLM(name, generateQuickLM);
+    fsgDump<<"TRANSITION "<<numberOfWords * 2 + 1<<" 0 0.0909\n";
+    fsgDump<<"FSG_END\n";
+    fsgDump.close();
+}
 
-    DEBUG<<"Grammar files created!";
-    return true;
+std::string getFileData(std::string _fileName)           //returns whole read file. Used to read text files
+{
+    std::ifstream infile(_fileName);
+    std::string allData = "";
+    std::string line;
+    while (std::getline(infile, line))
+    {
+        std::istringstream iss(line);
+        allData += line + "\n";
+    }
+    return allData;
 }
 
-bool generate(std::vector <SubtitleItem*> subtitles, grammarName name) //Generate grammar from subtitle (.srt) files.
+void FinishGrammar(Grammar &grammar, bool generateQuickDict, bool writeFiles) //Estimate models and make the dictionary of all added dialogues
 {
-    bool generateQuickDict = false, generateQuickLM = false;
-    int rv;
+    if (grammar.has(vocab) || grammar.has(lm) || grammar.has(dict))
+        grammar.words.estimate();
 
-    ConfigureQuickGenerationOptions(generateQuickDict, generateQuickLM, name);
+    if (grammar.has(phone_lm))
+        grammar.phones.estimate();
 
-    CreateTempDirectories();
+    if (grammar.has(dict))
+        GenerateDict(grammar, generateQuickDict);
 
-    std::ofstream corpusDump, phoneticCorpusDump, fsgDump, vocabDump, dictDump, logDump;
+    if (writeFiles)
+        WriteGrammarFiles(grammar);
 
-    CreateNewGrammarFiles(name, corpusDump, fsgDump, vocabDump, dictDump, phoneticCorpusDump, logDump);
+    DEBUG << "Grammar created!";
+}
 
-    for(SubtitleItem *sub : subtitles)
-    {
-        if(name == corpus || name == complete_grammar)
-        {
-            try
-            {
-                corpusDump.open("tempFiles/corpus/corpus.txt", std::ios::binary | std::ios::app);
-            }
-            catch(std::system_error& e)
-            {
-                FATAL(FileNotFound) << e.code().message();
-            }
-
-            corpusDump << "<s> " << stringToLower(sub->getDialogue()) << " </s>\n";
-            corpusDump.close();
-        }
+bool generate(std::string transcriptFileName, Grammar &grammar, grammarName name, bool writeFiles) //Generate Grammar from text files.
+{
+    std::string transcript = getFileData(transcriptFileName);
 
-        if(name == phone_lm || name == complete_grammar)
-        {
-            try
-            {
-                phoneticCorpusDump.open("tempFiles/corpus/phoneticCorpus.txt", std::ios::binary | std::ios::app);
-            }
+    bool generateQuickDict = false, generateQuickLM = false;
 
-            catch(std::system_error& e)
-            {
-                FATAL(FileNotFound) << e.code().message();
-            }
+    ConfigureQuickGenerationOptions(generateQuickDict, generateQuickLM, name);
 
-            int numberOfWords = sub->getWordCount();
-            std::string printPhoneticCourpus = "SIL ";
+    grammar.name = name;
 
-            for(int i=0;i<numberOfWords;i++)
-            {
-                std::vector<Phoneme> phones = stringToPhoneme(stringToLower(sub->getWordByIndex(i)));
+    std::istringstream iss(transcript);
+    AddSentence(grammar, std::vector<std::string>((std::istream_iterator<std::string>(iss)), std::istream_iterator<std::string>()));
 
-                for(Phoneme ph : phones)
-                    printPhoneticCourpus += ph + " ";
-            }
+    //FSG not needed for transcription
 
-            printPhoneticCourpus += "SIL\n";
+    FinishGrammar(grammar, generateQuickDict, writeFiles);
+    return true;
+}
 
-            phoneticCorpusDump << printPhoneticCourpus;
-            phoneticCorpusDump.close();
-        }
+bool generate(std::vector <SubtitleItem*> subtitles, Grammar &grammar, grammarName name, bool writeFiles) //Generate grammar from subtitle (.srt) files.
+{
+    bool generateQuickDict = false, generateQuickLM = false;
 
-        if(name == fsg || name == complete_grammar)
-        {
-            long int startTime = sub->getStartTime();
-            std::string fsgFileName("tempFiles/fsg/" + std::to_string(startTime));
-            fsgFileName += ".fsg";
-
-            try
-            {
-                fsgDump.open(fsgFileName, std::ios::binary);
-            }
-
-            catch(std::system_error& e)
-            {
-                FATAL(FileNotFound) << e.code().message();
-            }
-
-            int numberOfWords = sub->getWordCount();
-
-            fsgDump<<"FSG_BEGIN CUSTOM_FSG\n";
-            fsgDump<<"NUM_STATES "<<(numberOfWords * 2) + 2<<"\n";
-            fsgDump<<"START_STATE 0\n";
-            fsgDump<<"FINAL_STATE "<<(numberOfWords * 2) + 1<<"\n\n";
-            fsgDump<<"# Transitions\n";
-
-            for(int i=0;i<numberOfWords;i++)
-            {
-                fsgDump<<"TRANSITION "<<"0 "<<i+1<<" 0.0909\n";
-            }
-            for(int i=numberOfWords, counter = 1;counter<=numberOfWords;i++,counter++)
-            {
-                fsgDump<<"TRANSITION "<<counter<<" "<<i+1<<" 1.0 "<<stringToLower(sub->getWordByIndex(counter-1))<<"\n";
-            }
-            for(int i=numberOfWords + 1;i<numberOfWords * 2 + 1;i++)
-            {
-                fsgDump<<"TRANSITION "<<i<<" "<<numberOfWords * 2 + 1<<" 0.0909\n";
-            }
-
-            fsgDump<<"TRANSITION "<<numberOfWords * 2 + 1<<" 0 0.0909\n";
-            fsgDump<<"FSG_END\n";
-            fsgDump.close();
-        }
+    ConfigureQuickGenerationOptions(generateQuickDict, generateQuickLM, name);
 
-    }
+    grammar.name = name;
+
+    if (name == fsg && writeFiles)   //aligner builds them in memory, files are only written on request
+        grammar.workspace.create();
 
-    if(name == vocab || name == complete_grammar)
+    for (SubtitleItem *sub : subtitles)
     {
-        DEBUG << "Creating vocabulary...";
+        AddSentence(grammar, sub->getIndividualWords());
 
-        rv = systemGetStatus("text2wfreq < tempFiles/corpus/corpus.txt 2>tempFiles/grammar.log | wfreq2vocab > tempFiles/vocab/complete.vocab 2>tempFiles/grammar_wfreq2vocab.log");
+        if (name == fsg && writeFiles)
+            WriteSubtitleFSG(grammar.workspace, sub);
+    }
 
-        if (rv != 0)
-        {
-            FATAL(UnknownError) << "Something went wrong while creating vocabulary!";
-        }
+    FinishGrammar(grammar, generateQuickDict, writeFiles);
+    return true;
+}
 
-        DEBUG << "Vocabulary created!";
-    }
+fsg_model_t *CreateSubtitleFSG(SubtitleItem *sub, logmath_t *lmath, float32 languageWeight)
+{
+    //same states and transitions as the files written by generate(), any word of the dialogue may follow any other
+    int numberOfWords = sub->getWordCount();
+    int finalState = numberOfWords * 2 + 1;
+    int32 wordProbability = static_cast<int32>(logmath_log(lmath, 1.0) * languageWeight);
+    int32 nullProbability = static_cast<int32>(logmath_log(lmath, 0.0909) * languageWeight);
 
-    if(name == dict || name == complete_grammar)
-    {
-        GenerateDict(generateQuickDict);
-    }
+    fsg_model_t *fsg = fsg_model_init("CUSTOM_FSG", lmath, languageWeight, finalState + 1);
+    fsg->start_state = 0;
+    fsg->final_state = finalState;
 
-    CreateBiasedLM(name, generateQuickLM);
+    glist_t nulls = nullptr;
 
-    if (name == phone_lm || name == complete_grammar)
+    for (int i = 1; i <= numberOfWords; i++)
     {
-        INFO << "Creating Phonetic Language Model : tempFiles/lm/phone.lm";
+        if (fsg_model_null_trans_add(fsg, 0, i, nullProbability) == 1)
+            nulls = glist_add_ptr(nulls, fsg_model_null_trans(fsg, 0, i));
+    }
 
-        rv = systemGetStatus("perl quick_lm.pl -s tempFiles/corpus/phoneticCorpus.txt 2>tempFiles/grammar.log");
-        if (rv != 0)
-            FATAL(UnknownError) << "Something went wrong while creating Phonetic Language Model!";
+    for (int i = 1; i <= numberOfWords; i++)
+    {
+        int32 wid = fsg_model_word_add(fsg, stringToLower(sub->getWordByIndex(i - 1)).c_str());
+        fsg_model_trans_add(fsg, i, numberOfWords + i, wordProbability, wid);
+    }
 
-#ifndef WIN32
-        rv = systemGetStatus("mv tempFiles/corpus/phoneticCorpus.txt.arpabo tempFiles/lm/ 2>tempFiles/grammar.log");
-#else
-        rv = systemGetStatus("move tempFiles\\corpus\\phoneticCorpus.txt.arpabo tempFiles\\lm\\ 2>tempFiles\\grammar.log");
-#endif
-        if (rv != 0)
-            FATAL(UnknownError) << "Something went wrong while moving phonetic model!";
+    for (int i = numberOfWords + 1; i < finalState; i++)
+    {
+        if (fsg_model_null_trans_add(fsg, i, finalState, nullProbability) == 1)
+            nulls = glist_add_ptr(nulls, fsg_model_null_trans(fsg, i, finalState));
     }
 
-    DEBUG << "Grammar files created!";
+    if (fsg_model_null_trans_add(fsg, finalState, 0, nullProbability) == 1)
+        nulls = glist_add_ptr(nulls, fsg_model_null_trans(fsg, finalState, 0));
 
-    return true;
+    nulls = fsg_model_null_trans_closure(fsg, nulls);
+    glist_free(nulls);
+
+    return fsg;
 }
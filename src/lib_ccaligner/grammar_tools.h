@@ -10,15 +10,33 @@
 #include "srtparser.h"
 #include "commons.h"
 #include "phoneme_utils.h"
+#include "language_model.h"
+#include "pronunciation_store.h"
+#include "workspace.h"
+#include <sphinxbase/fsg_model.h>
 
-bool generate(std::vector <SubtitleItem*> subtitles, grammarName name = complete_grammar);
-bool generate(std::string transcriptFileName, grammarName name = complete_grammar);
+struct Grammar      //generated from the subtitles, handed to the decoder in memory
+{
+    grammarName name = no_grammar;                      //which parts are generated
+    std::vector<std::string> corpus, phoneticCorpus;    //a sentence per dialogue
+    LanguageModel words, phones;                        //biased and phonetic language model
+    std::vector<std::pair<std::string, std::string>> dictionary;   //words and their phonemes, separated by spaces
+    std::string lexiconPath, pronunciationCachePath;    //looked up before g2p, if set
+    Workspace workspace;                                //where files of the grammar are written, and g2p is run
+
+    bool has(grammarName part) const noexcept { return name == part || name == complete_grammar; }
+};
+
+//files of the grammar are written to its workspace only if writeFiles is set
+bool generate(std::vector <SubtitleItem*> subtitles, Grammar &grammar, grammarName name = complete_grammar, bool writeFiles = false);
+bool generate(std::string transcriptFileName, Grammar &grammar, grammarName name = complete_grammar, bool writeFiles = false);
 void ConfigureQuickGenerationOptions(bool &generateQuickDict, bool &generateQuickLM, grammarName &name);
-void CreateTempDirectories();
-void CreateNewGrammarFiles(grammarName name, std::ofstream &corpusDump, std::ofstream &fsgDump,
-	std::ofstream &vocabDump, std::ofstream &dictDump, std::ofstream &phoneticCorpusDump, std::ofstream &logDump);
-void CreateBiasedLM(grammarName name, bool generateQuickLM);
-void GenerateDict(bool generateQuickDict);
+void AddSentence(Grammar &grammar, std::vector<std::string> words);
+void GenerateDict(Grammar &grammar, bool generateQuickDict);
+void FinishGrammar(Grammar &grammar, bool generateQuickDict, bool writeFiles);
+void WriteGrammarFiles(const Grammar &grammar);
+void WriteSubtitleFSG(const Workspace &workspace, SubtitleItem *sub);
+fsg_model_t *CreateSubtitleFSG(SubtitleItem *sub, logmath_t *lmath, float32 languageWeight);   //the grammar of a .fsg file, built in memory
 std::string getFileData(std::string _fileName);
 
 #endif //CCALIGNER_GRAMMAR_TOOLS_H
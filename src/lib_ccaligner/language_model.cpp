@@ -0,0 +1,241 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "language_model.h"
+
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+namespace {
+    const float unlikely = -99.0f;     //log10 probability of <s>, it is never predicted
+
+    double discount(const std::map<std::vector<uint32_t>, uint32_t>& counts) {
+        double once = 0, twice = 0;
+
+        for (const auto& count : counts) {
+            if (count.second == 1)
+                once++;
+            else if (count.second == 2)
+                twice++;
+        }
+
+        //too little data to estimate from
+        if (once == 0 || twice == 0)
+            return 0.5;
+
+        return once / (once + 2 * twice);
+    }
+}
+
+LanguageModel::LanguageModel(int order)
+    : _order(order),
+    _counts(order),
+    _estimated(false) {
+
+    if (order < 1 || order > 6)
+        FATAL(InvalidParameters) << "Language model order must be between 1 and 6 : " << order;
+
+    wordId("</s>");
+    wordId("<s>");
+}
+
+uint32_t LanguageModel::wordId(const std::string& word) {
+    auto found = _wordIds.find(word);
+
+    if (found != _wordIds.end())
+        return found->second;
+
+    uint32_t id = static_cast<uint32_t>(_words.size());
+    _wordIds.emplace(word, id);
+    _words.push_back(word);
+    return id;
+}
+
+void LanguageModel::addSentence(const std::vector<std::string>& words) {
+    if (words.empty())
+        return;
+
+    std::vector<uint32_t> sentence;
+    sentence.reserve(words.size() + 2);
+    sentence.push_back(wordId("<s>"));
+
+    for (const std::string& word : words)
+        sentence.push_back(wordId(word));
+
+    sentence.push_back(wordId("</s>"));
+
+    for (int n = 1; n <= _order; n++) {
+        for (std::size_t end = n; end <= sentence.size(); end++) {
+            if (n == 1 && end == 1)     //<s> only begins sentences, it is not counted as a word
+                continue;
+
+            _counts[n - 1][std::vector<uint32_t>(sentence.begin() + (end - n), sentence.begin() + end)]++;
+        }
+    }
+
+    _estimated = false;
+}
+
+void LanguageModel::estimate() {
+    //word ids of the model follow the sorted vocabulary, as in an ARPA file
+    std::vector<uint32_t> sorted(_words.size()), rank(_words.size());
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::sort(sorted.begin(), sorted.end(), [this](uint32_t a, uint32_t b) { return _words[a] < _words[b]; });
+
+    _vocabulary.clear();
+    for (uint32_t i = 0; i < sorted.size(); i++) {
+        rank[sorted[i]] = i;
+        _vocabulary.push_back(_words[sorted[i]]);
+    }
+
+    //probability of every counted n-gram, and back-off weight of every history, in their natural order
+    std::vector<std::map<std::vector<uint32_t>, double>> probabilities(_order), backoffs(_order);
+    uint32_t startId = _wordIds.at("<s>");
+    double numberOfWords = 0;
+
+    for (const auto& count : _counts[0])
+        numberOfWords += count.second;
+
+    for (const auto& count : _counts[0])
+        probabilities[0][count.first] = count.second / numberOfWords;
+
+    for (int n = 2; n <= _order; n++) {
+        const auto& counts = _counts[n - 1];
+        double d = discount(counts);
+
+        std::map<std::vector<uint32_t>, std::pair<double, double>> histories;     //total count and distinct words following
+
+        for (const auto& count : counts) {
+            auto& history = histories[std::vector<uint32_t>(count.first.begin(), count.first.end() - 1)];
+            history.first += count.second;
+            history.second++;
+        }
+
+        for (const auto& count : counts) {
+            const auto& history = histories.at(std::vector<uint32_t>(count.first.begin(), count.first.end() - 1));
+            double lower = probabilities[n - 2].at(std::vector<uint32_t>(count.first.begin() + 1, count.first.end()));
+            probabilities[n - 1][count.first] = (count.second - d) / history.first + d * history.second / history.first * lower;
+        }
+
+        for (const auto& history : histories)
+            backoffs[n - 2][history.first] = d * history.second.second / history.second.first;
+    }
+
+    _ngrams.assign(_order, Ngrams());
+
+    for (int n = 1; n <= _order; n++) {
+        std::vector<std::vector<uint32_t>> keys;
+
+        if (n == 1) {
+            for (uint32_t id : sorted)
+                keys.push_back({id});
+        }
+
+        else {
+            for (const auto& probability : probabilities[n - 1])
+                keys.push_back(probability.first);
+
+            std::sort(keys.begin(), keys.end(), [&rank](const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+                return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                                    [&rank](uint32_t x, uint32_t y) { return rank[x] < rank[y]; });
+            });
+        }
+
+        Ngrams& ngrams = _ngrams[n - 1];
+
+        for (const std::vector<uint32_t>& key : keys) {
+            for (uint32_t id : key)
+                ngrams.words.push_back(rank[id]);
+
+            auto probability = probabilities[n - 1].find(key);
+            bool start = n == 1 && key[0] == startId;
+            ngrams.probabilities.push_back(start || probability == probabilities[n - 1].end() ? unlikely : std::log10(probability->second));
+
+            if (n < _order) {
+                auto backoff = backoffs[n - 1].find(key);
+                ngrams.backoffs.push_back(backoff == backoffs[n - 1].end() ? 0.0f : std::log10(backoff->second));
+            }
+        }
+    }
+
+    _estimated = true;
+}
+
+const std::vector<std::string>& LanguageModel::vocabulary() const {
+    if (!_estimated)
+        FATAL(UnknownError) << "Language model is used before it is estimated!";
+
+    return _vocabulary;
+}
+
+const LanguageModel::Ngrams& LanguageModel::ngrams(int order) const {
+    if (!_estimated)
+        FATAL(UnknownError) << "Language model is used before it is estimated!";
+
+    return _ngrams.at(order - 1);
+}
+
+bool LanguageModel::writeVocabulary(const std::string& fileName) const {
+    std::ofstream out(fileName, std::ios::binary);
+    out << "## Vocabulary of " << vocabulary().size() << " words, sorted\n";
+
+    for (const std::string& word : vocabulary())
+        out << word << "\n";
+
+    return static_cast<bool>(out);
+}
+
+bool LanguageModel::writeARPA(const std::string& fileName) const {
+    FILE *out = std::fopen(fileName.c_str(), "wb");
+
+    if (out == nullptr)
+        return false;
+
+    std::fprintf(out, "\\data\\\n");
+    for (int n = 1; n <= _order; n++)
+        std::fprintf(out, "ngram %d=%zu\n", n, ngrams(n).probabilities.size());
+
+    for (int n = 1; n <= _order; n++) {
+        const Ngrams& current = ngrams(n);
+        std::fprintf(out, "\n\\%d-grams:\n", n);
+
+        for (std::size_t i = 0; i < current.probabilities.size(); i++) {
+            std::fprintf(out, "%.6f", current.probabilities[i]);
+
+            for (int k = 0; k < n; k++)
+                std::fprintf(out, " %s", _vocabulary[current.words[i * n + k]].c_str());
+
+            if (n < _order)
+                std::fprintf(out, " %.6f", current.backoffs[i]);
+
+            std::fprintf(out, "\n");
+        }
+    }
+
+    std::fprintf(out, "\n\\end\\\n");
+    return std::fclose(out) == 0;
+}
+
+ngram_model_t *LanguageModel::model(cmd_ln_t *config, logmath_t *lmath) const {
+    std::vector<const char *> words;
+    std::vector<uint32_t> counts;
+    std::vector<const uint32_t *> ngramWords;
+    std::vector<const float32 *> probabilities, backoffs;
+
+    for (const std::string& word : vocabulary())
+        words.push_back(word.c_str());
+
+    for (int n = 1; n <= _order; n++) {
+        const Ngrams& current = ngrams(n);
+        counts.push_back(static_cast<uint32_t>(current.probabilities.size()));
+        ngramWords.push_back(current.words.data());
+        probabilities.push_back(current.probabilities.data());
+        backoffs.push_back(current.backoffs.data());
+    }
+
+    return ngram_model_build(config, lmath, _order, counts.data(), words.data(), ngramWords.data(), probabilities.data(), backoffs.data());
+}
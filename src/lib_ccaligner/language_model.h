@@ -0,0 +1,62 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_LANGUAGE_MODEL_H
+#define CCALIGNER_LANGUAGE_MODEL_H
+
+#include "commons.h"
+#include <map>
+#include <unordered_map>
+#include <sphinxbase/ngram_model.h>
+
+/*
+ * Back-off n-gram model, estimated in memory with interpolated absolute discounting :
+ *
+ *  p(w | h) = max(c(h w) - D, 0) / c(h) + D * T(h) / c(h) * p(w | h')
+ *
+ * where c(h) counts the n-grams following history h, T(h) the distinct words following it, h' is h without its
+ * first word and D = n1 / (n1 + 2 * n2) from the number of n-grams seen once and twice. Every word of the
+ * vocabulary is seen, so unigrams are relative frequencies. Written as an ARPA model the back-off weight of h
+ * is D * T(h) / c(h).
+ */
+
+class LanguageModel
+{
+public:
+    struct Ngrams   //n-grams of one order, sorted by their words
+    {
+        std::vector<uint32_t> words;    //word ids, history first, order ids per n-gram
+        std::vector<float> probabilities, backoffs;     //log10
+    };
+
+private:
+    int _order;
+    std::unordered_map<std::string, uint32_t> _wordIds;
+    std::vector<std::string> _words;                            //in order of first appearance
+    std::vector<std::map<std::vector<uint32_t>, uint32_t>> _counts;  //n-gram counts, of order 1 at index 0
+    std::vector<std::string> _vocabulary;                       //sorted, the word ids of estimated n-grams
+    std::vector<Ngrams> _ngrams;
+    bool _estimated;
+
+    uint32_t wordId(const std::string& word);
+
+public:
+    explicit LanguageModel(int order = 3);
+
+    void addSentence(const std::vector<std::string>& words);   //count the n-grams of <s> words </s>
+    void estimate();                                            //compute probabilities of every counted n-gram
+
+    int order() const noexcept { return _order; }
+    bool empty() const noexcept { return _words.size() <= 2; }
+    const std::vector<std::string>& vocabulary() const;         //sorted, including <s> and </s>
+    const Ngrams& ngrams(int order) const;
+
+    bool writeVocabulary(const std::string& fileName) const;
+    bool writeARPA(const std::string& fileName) const;
+    ngram_model_t *model(cmd_ln_t *config, logmath_t *lmath) const;    //same model as the ARPA file, without the file
+};
+
+#endif //CCALIGNER_LANGUAGE_MODEL_H
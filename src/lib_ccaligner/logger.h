@@ -12,6 +12,7 @@
 #include <vector>
 #include <ctime>
 #include <array>
+#include <mutex>
 #include <exception>
 #include <typeinfo>
 
@@ -155,7 +156,13 @@ public:
             static std::string getCurrentTime() {
                 char currentTime[16];
                 const auto now = std::time(nullptr);
-                std::strftime(currentTime, sizeof(currentTime), "%m-%d %H:%M:%S", std::localtime(&now));
+                std::tm local;  // std::localtime shares its result between threads
+#ifdef WIN32
+                localtime_s(&local, &now);
+#else
+                localtime_r(&now, &local);
+#endif
+                std::strftime(currentTime, sizeof(currentTime), "%m-%d %H:%M:%S", &local);
                 return std::string(currentTime);
             }
 
@@ -168,18 +175,23 @@ public:
     // It will apply the level to all **existing** sinks. Set level to nolog if you don't want any log.
     // default: debug
     void setMinimumOutputLevel(Level level) noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
         for (auto& sink : _sinks) sink.setMinimumOutputLevel(level);
     }
 
+    // Lines logged from different threads are written whole.
     void log(std::stringstream& ss, Level level) {
+        std::lock_guard<std::mutex> lock(_mutex);
         for (auto& sink : _sinks) sink.output(ss, level);
     }
 
     void addSink(Sink sink) {
+        std::lock_guard<std::mutex> lock(_mutex);
         _sinks.emplace_back(sink);
     }
 
     void flush() {
+        std::lock_guard<std::mutex> lock(_mutex);
         for (auto& sink : _sinks) sink.flush();
     }
 
@@ -188,6 +200,7 @@ public:
 private:
     Logger() : _sinks{ {std::cout, true} } { }
     std::vector<Sink> _sinks;
+    std::mutex _mutex;
 };
 
 inline Logger& getLogger() {
@@ -9,49 +9,124 @@
 // Default paths.
 namespace {
     constexpr auto defaultModelPath = "model/";
-    constexpr auto defaultLmPath = "tempFiles/lm/complete.lm";
-    constexpr auto defaultDictPath = "tempFiles/dict/complete.dict";
-    constexpr auto defaultFsgPath = "tempFiles/fsg/";
     constexpr auto defaultPhoneticLmPath = "model/en-us-phone.lm.bin";
+    constexpr unsigned long maxWorkers = 64;   //each worker has decoders of its own, more would only exhaust memory
+    constexpr unsigned long maxQueueLength = 1024;     //each waiting request holds a connection and a thread of the server
+
+    //a count given to a parameter, digits only; strtoul would take "-1" as the largest count
+    unsigned long parseCount(const std::string& paramPrefix, const std::string& subParam) {
+        if (subParam.empty() || subParam.find_first_not_of("0123456789") != std::string::npos) {
+            FATAL(InvalidParameters) << "Invalid value passed to " << paramPrefix << " : " << subParam << ", it should be a positive integer";
+        }
+
+        errno = 0;
+        unsigned long count = std::strtoul(subParam.c_str(), nullptr, 10);
+
+        if (errno) {
+            FATAL(UnknownError) << "Invalid value passed to " << paramPrefix << " : " << strerror(errno);
+        }
+
+        return count;
+    }
 }
 
 Params::Params() noexcept
     : localTime(32, '\0'),
     modelPath(defaultModelPath),
-    lmPath(defaultLmPath),
-    dictPath(defaultDictPath),
-    fsgPath(defaultFsgPath),
+    lmPath(Workspace().lmPath()),
+    dictPath(Workspace().dictPath()),
+    fsgPath(),
     phoneticLmPath(defaultPhoneticLmPath),
+    workspacePath(Workspace::defaultDirectory),
 
     searchWindow(3),
     audioWindow(0),
     sampleWindow(0),
+    threads(1),
+    maxUtterance(20000),
+    vadAggressiveness(2),
+    latency(2000),
+    history(30000),
+    jobs(1),
+    queueLength(8),
 
     chosenAlignerType(asrAligner),
     grammarType(complete_grammar),
     outputFormat(xml),
     printOption(printBothWithDistinctColors),
     useFSG(),
+    forcedAlignment(),
     transcribe(),
     useBatchMode(),
     useExperimentalParams(),
     searchPhonemes(),
     displayRecognised(true),
     readStream(),
+    streamAudio(),
+    precomputeFeatures(),
     quickDict(),
     quickLM(),
+    dumpGrammar(),
+    pruneDict(true),
+    removeWorkspace(),
+    useLattice(),
+    trimSilence(),
+    liveAlign(),
+    usingTranscript(),
     audioIsRaw() {
       
     // Using date and time for log filename.
     const auto now = std::time(nullptr);
     localTime.erase(std::strftime(&localTime.front(), localTime.size(), "%d-%m-%Y-%H-%M-%S", std::localtime(&now)));
 
-    logPath = "tempFiles/" + localTime + ".log";
-    alignerLogPath = "tempFiles/aligner-" + localTime + ".log";
-    phonemeLogPath = "tempFiles/phoneme-" + localTime + ".log";
+    logPath = Workspace().path(localTime + ".log");
+    alignerLogPath = Workspace().path("aligner-" + localTime + ".log");
+    phonemeLogPath = Workspace().path("phoneme-" + localTime + ".log");
+}
+
+void Params::useWorkspace(const std::string& directory) {
+    Workspace current(workspacePath), workspace(directory);
+
+    struct { std::string *path; std::string atDefault, moved; } inWorkspace[] = {
+        {&lmPath, current.lmPath(), workspace.lmPath()},
+        {&dictPath, current.dictPath(), workspace.dictPath()},
+        {&phoneticLmPath, current.phoneticLmPath(), workspace.phoneticLmPath()},
+        {&logPath, current.path(localTime + ".log"), workspace.path(localTime + ".log")},
+        {&alignerLogPath, current.path("aligner-" + localTime + ".log"), workspace.path("aligner-" + localTime + ".log")},
+        {&phonemeLogPath, current.path("phoneme-" + localTime + ".log"), workspace.path("phoneme-" + localTime + ".log")}
+    };
+
+    for (const auto& entry : inWorkspace)
+    {
+        if (*entry.path == entry.atDefault)
+            *entry.path = entry.moved;
+    }
+
+    workspacePath = workspace.directory();
+}
+
+Params Params::forJob(const std::string& audio, const std::string& subtitles, const std::string& output) const {
+    Params job(*this);
+
+    job.manifestFileName.clear();
+    job.summaryFileName.clear();
+    job.socketPath.clear();
+    job.audioFileName = audio;
+    job.subtitleFileName = subtitles;
+    job.outputFileName = output;
+
+    //grammars of jobs aligned at once must not meet, each job gets its own workspace within that of the batch
+    job.useWorkspace(Workspace::unique(workspacePath));
+    job.removeWorkspace = true;
+    job.displayRecognised = false;  //recognised text of jobs aligned at once would interleave
+
+    job.validateParams();
+    return job;
 }
 
 void Params::inputParams(int argc, char *argv[]) {
+    bool formatGiven = false;
+
     for (int i = 1; i<argc; i++)         //parsing arguments
     {
         std::string subParam, paramPrefix(argv[i]);
@@ -105,6 +180,123 @@ void Params::inputParams(int argc, char *argv[]) {
             readStream = true;
         }
 
+        else if (paramPrefix == "--stream-audio") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "--stream-audio requires a valid response!";
+            }
+
+            if (subParam == "yes")
+                streamAudio = true;
+
+            i++;
+        }
+
+        else if (paramPrefix == "--live") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "--live requires a valid response!";
+            }
+
+            if (subParam == "yes")
+                liveAlign = true;
+
+            i++;
+        }
+
+        else if (paramPrefix == "-latency") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-latency requires an integer value to determine how long audio is awaited after a caption!";
+            }
+
+            errno = 0;
+            latency = std::strtoul(subParam.c_str(), nullptr, 10);
+
+            if (errno) {
+                FATAL(UnknownError) << "Invalid value passed to -latency : " << strerror(errno);
+            }
+
+            i++;
+        }
+
+        else if (paramPrefix == "-history") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-history requires an integer value to determine how much of the audio is kept!";
+            }
+
+            errno = 0;
+            history = std::strtoul(subParam.c_str(), nullptr, 10);
+
+            if (errno) {
+                FATAL(UnknownError) << "Invalid value passed to -history : " << strerror(errno);
+            }
+
+            i++;
+        }
+
+        else if (paramPrefix == "-batch") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-batch requires a path to a manifest of audio and subtitle files!";
+            }
+
+            manifestFileName = subParam;
+            i++;
+        }
+
+        else if (paramPrefix == "-jobs") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-jobs requires a valid integer value to determine how many files of a batch are aligned at once!";
+            }
+
+            jobs = parseCount(paramPrefix, subParam);
+            i++;
+        }
+
+        else if (paramPrefix == "-summary") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-summary requires a path to write the summary of a batch to!";
+            }
+
+            summaryFileName = subParam;
+            i++;
+        }
+
+        else if (paramPrefix == "--serve") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "--serve requires a path to the UNIX domain socket to listen on!";
+            }
+
+            socketPath = subParam;
+            i++;
+        }
+
+        else if (paramPrefix == "-queue") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-queue requires a valid integer value to determine how many requests may wait to be aligned!";
+            }
+
+            queueLength = parseCount(paramPrefix, subParam);
+            i++;
+        }
+
+        else if (paramPrefix == "--precompute-features") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "--precompute-features requires a valid response!";
+            }
+
+            if (subParam == "yes")
+                precomputeFeatures = true;
+
+            i++;
+        }
+
+        else if (paramPrefix == "-featCache") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-featCache requires a path to a valid directory!";
+            }
+
+            featureCachePath = subParam;
+            i++;
+        }
+
         else if (paramPrefix == "-out") {
             if (i + 1 > argc) {
                 FATAL(IncompleteParameters) << "-out requires a valid output filename!";
@@ -138,6 +330,7 @@ void Params::inputParams(int argc, char *argv[]) {
                 FATAL(InvalidParameters) << "-oFormat requires a valid output format!";
             }
 
+            formatGiven = true;
             i++;
         }
 
@@ -160,6 +353,24 @@ void Params::inputParams(int argc, char *argv[]) {
         }
 
 
+        else if (paramPrefix == "-lexicon") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-lexicon requires a path to a valid dictionary file!";
+            }
+
+            lexiconPath = subParam;
+            i++;
+        }
+
+        else if (paramPrefix == "-g2pCache") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-g2pCache requires a path to a valid directory!";
+            }
+
+            pronunciationCachePath = subParam;
+            i++;
+        }
+
         else if (paramPrefix == "-dict") {
             if (i + 1 > argc) {
                 FATAL(IncompleteParameters) << "-dict requires a path to a valid dictionary file!";
@@ -219,6 +430,24 @@ void Params::inputParams(int argc, char *argv[]) {
             i++;
         }
 
+        else if (paramPrefix == "-workdir") {
+            if (i + 1 >= argc) {
+                FATAL(IncompleteParameters) << "-workdir requires a path to a directory, or auto!";
+            }
+
+            if (subParam == "auto") {
+                useWorkspace(Workspace::unique());
+                removeWorkspace = true;
+            }
+
+            else {
+                useWorkspace(subParam);
+                removeWorkspace = false;
+            }
+
+            i++;
+        }
+
         else if (paramPrefix == "--enable-phonemes") {
             if (i + 1 > argc) {
                 FATAL(IncompleteParameters) << "--enable-phonemes requires a valid response!";
@@ -287,6 +516,50 @@ void Params::inputParams(int argc, char *argv[]) {
             i++;
         }
 
+        else if (paramPrefix == "--dump-grammar") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "--dump-grammar requires a valid response!";
+            }
+
+            if (subParam == "yes")
+                dumpGrammar = true;
+
+            i++;
+        }
+
+        else if (paramPrefix == "--prune-dict") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "--prune-dict requires a valid response!";
+            }
+
+            if (subParam == "no")
+                pruneDict = false;
+
+            i++;
+        }
+
+        else if (paramPrefix == "--use-lattice") {
+            if (i + 1 >= argc) {
+                FATAL(IncompleteParameters) << "--use-lattice requires a valid response!";
+            }
+
+            if (subParam == "yes")
+                useLattice = true;
+
+            i++;
+        }
+
+        else if (paramPrefix == "--trim-silence") {
+            if (i + 1 >= argc) {
+                FATAL(IncompleteParameters) << "--trim-silence requires a valid response!";
+            }
+
+            if (subParam == "yes")
+                trimSilence = true;
+
+            i++;
+        }
+
         else if (paramPrefix == "--print-aligned") {
             if (i + 1 > argc) {
                 FATAL(IncompleteParameters) << "--print-aligned requires a valid response!";
@@ -383,6 +656,44 @@ void Params::inputParams(int argc, char *argv[]) {
             i++;
         }
 
+        else if (paramPrefix == "-threads") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-threads requires a valid integer value to determine the number of workers!";
+            }
+
+            threads = parseCount(paramPrefix, subParam);
+            i++;
+        }
+
+        else if (paramPrefix == "-maxUtterance") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-maxUtterance requires an integer value to determine the longest utterance transcribed at once!";
+            }
+
+            errno = 0;
+            maxUtterance = std::strtoul(subParam.c_str(), nullptr, 10);
+
+            if (errno) {
+                FATAL(UnknownError) << "Invalid value passed to -maxUtterance : " << strerror(errno);
+            }
+
+            i++;
+        }
+
+        else if (paramPrefix == "-vadMode") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-vadMode requires an integer value from 0 to 3 to determine the aggressiveness of voice activity detection!";
+            }
+
+            if (subParam.size() != 1 || subParam[0] < '0' || subParam[0] > '3') {
+                FATAL(InvalidParameters) << "Invalid value passed to -vadMode : " << subParam << ", it should be from 0 to 3";
+            }
+
+            vadAggressiveness = subParam[0] - '0';
+
+            i++;
+        }
+
         else if (paramPrefix == "-sampleWindow") {
             if (i + 1 > argc) {
                 FATAL(IncompleteParameters) << "-sampleWindow requires a valid integer value to determine the recognition scope!";
@@ -433,6 +744,24 @@ void Params::inputParams(int argc, char *argv[]) {
             i++;
         }
 
+        else if (paramPrefix == "-mode") {
+            if (i + 1 > argc) {
+                FATAL(IncompleteParameters) << "-mode requires a valid response!";
+            }
+
+            if (subParam == "forced")
+                forcedAlignment = true;
+
+            else if (subParam == "recognise")
+                forcedAlignment = false;
+
+            else {
+                FATAL(InvalidParameters) << "-mode requires either recognise or forced!";
+            }
+
+            i++;
+        }
+
         else if (paramPrefix == "-approx") {
             if (i + 1 > argc) {
                 FATAL(IncompleteParameters) << "-approx requires a valid response!";
@@ -450,15 +779,55 @@ void Params::inputParams(int argc, char *argv[]) {
 
     }
 
+    //clients read the output of served requests as it is streamed, it is always JSON
+    if (!socketPath.empty()) {
+        if (formatGiven && outputFormat != json)
+            FATAL(IncompatibleParameters) << "Served requests stream their output as JSON, -oFormat can only be json with --serve!";
+
+        outputFormat = json;
+    }
+
     validateParams();
 
 }
 
 void Params::validateParams() {
-    if (audioFileName.empty() && !readStream)
+    bool filesOfEachJob = !manifestFileName.empty() || !socketPath.empty();   //listed in the manifest or sent with each request
+
+    if (filesOfEachJob) {
+        if (!manifestFileName.empty() && !socketPath.empty())
+            FATAL(IncompatibleParameters) << "A batch is aligned on its own, it can not be combined with --serve!";
+
+#ifdef WIN32
+        if (!socketPath.empty())
+            FATAL(IncompatibleParameters) << "--serve listens on a UNIX domain socket, which is not supported on Windows!";
+#endif
+
+        if (!audioFileName.empty() || readStream || !subtitleFileName.empty() || usingTranscript || !outputFileName.empty())
+            FATAL(IncompatibleParameters) << "The audio, subtitle and output files of a batch are listed in its manifest and those of served requests sent with them, not given with -wav, -srt, -txt or -out!";
+
+        if (chosenAlignerType != asrAligner || transcribe || liveAlign)
+            FATAL(IncompatibleParameters) << "Batches and served requests recognise or force align the subtitles of each file, they can not be combined with other aligners, transcribing or live alignment!";
+
+        if (jobs == 0)
+            FATAL(InvalidParameters) << "At least one job is required!";
+
+        if (queueLength > maxQueueLength)
+            FATAL(InvalidParameters) << "At most " << maxQueueLength << " requests may wait, not " << queueLength << "!";
+
+        if (jobs > maxWorkers) {
+            WARNING << "Aligning " << maxWorkers << " files at once, the most allowed, instead of " << jobs << ".";
+            jobs = maxWorkers;
+        }
+
+        if (!manifestFileName.empty() && summaryFileName.empty())
+            summaryFileName = manifestFileName + ".summary.tsv";
+    }
+
+    else if (audioFileName.empty() && !readStream)
         FATAL(InvalidParameters) << "Audio file name is empty!";
 
-    if (subtitleFileName.empty() && !usingTranscript)
+    if (subtitleFileName.empty() && !usingTranscript && !filesOfEachJob)
         FATAL(InvalidParameters) << "Subtitle file name is empty!";
 
     if (transcriptFileName.empty() && usingTranscript)
@@ -480,7 +849,7 @@ void Params::validateParams() {
         DEBUG << "Using default Log Path.";
 
     if (fsgPath.empty())
-        DEBUG << "Using default FSG Path.";
+        DEBUG << "Building FSGs in memory.";
 
     if (phoneticLmPath.empty())
         DEBUG << "Using default Phonetic LM Path.";
@@ -495,7 +864,7 @@ void Params::validateParams() {
         audioFileName = "stdin";
     }
 
-    if (outputFileName.empty()) {
+    if (outputFileName.empty() && !filesOfEachJob) {
         outputFileName = extractFileName(audioFileName);
 
         switch (outputFormat)  //decide on basis of set output format
@@ -527,10 +896,63 @@ void Params::validateParams() {
         FATAL(IncompatibleParameters) << "FSG and Transcribing are not compatible!";
     }
 
+    if (forcedAlignment && (useFSG || transcribe)) {
+        FATAL(IncompatibleParameters) << "Forced alignment can not be combined with FSG or transcribing!";
+    }
+
     if (searchPhonemes && transcribe) {
         FATAL(IncompatibleParameters) << "Sorry, currently phoneme transcribing is not supported!";
     }
 
+    if (threads == 0)
+        FATAL(InvalidParameters) << "At least one thread is required!";
+
+    if (threads > maxWorkers) {
+        WARNING << "Using " << maxWorkers << " threads, the most allowed, instead of " << threads << ".";
+        threads = maxWorkers;
+    }
+
+    if (maxUtterance < 1000)
+        FATAL(InvalidParameters) << "Utterances of at least 1000 ms are required to transcribe!";
+
+    if (liveAlign) {
+        if (usingTranscript || transcribe || useFSG || chosenAlignerType != asrAligner)
+            FATAL(IncompatibleParameters) << "Live alignment only recognises or force aligns captions, it can not be combined with transcripts, transcribing or FSG!";
+
+        if (grammarType != no_grammar)
+            FATAL(IncompatibleParameters) << "Live alignment can not generate a grammar from captions yet to arrive, use --generate-grammar no along with -lm and -dict!";
+
+        if (threads > 1 || precomputeFeatures || !featureCachePath.empty())
+            FATAL(IncompatibleParameters) << "Live alignment decodes every caption as it arrives, on one thread and from its samples!";
+
+        if (readStream && subtitleFileName == "-")
+            FATAL(IncompatibleParameters) << "Audio and captions can not both be read from standard input!";
+
+        if (audioWindow > latency || sampleWindow > latency * 16)     //samples at 16KHz
+            FATAL(IncompatibleParameters) << "The recognition window after a caption can not exceed its latency of " << latency << " ms!";
+
+        if (history < 2 * latency + 1000)
+            FATAL(InvalidParameters) << "The audio history should be at least twice the latency and a second, " << 2 * latency + 1000 << " ms!";
+
+        streamAudio = true;     //only the history is kept
+    }
+
+    if (removeWorkspace && dumpGrammar) {
+        INFO << "Keeping workspace " << workspacePath << "/ for the dumped grammar.";
+        removeWorkspace = false;
+    }
+
+    //transcribing decodes the speech segments it finds from their samples, features of the audio are never precomputed
+    bool decodesSamples = transcribe || usingTranscript;
+
+    //precomputing reads the complete audio up front, which streaming is meant to avoid; it has to be asked for
+    if (streamAudio && !precomputeFeatures && !decodesSamples && (!featureCachePath.empty() || threads > 1))
+        FATAL(IncompatibleParameters) << "-threads and -featCache precompute the features of the complete audio, which --stream-audio avoids. Use --precompute-features yes to read the audio up front anyway!";
+
+    //workers decode dialogues in any order; starting each from the global cepstral mean keeps the result identical
+    if ((!featureCachePath.empty() || threads > 1) && !decodesSamples)
+        precomputeFeatures = true;
+
     printParams();
 }
 
@@ -552,19 +974,42 @@ void Params::printParams() const noexcept {
     VERBOSE << "sampleWindow        : " << sampleWindow;
     VERBOSE << "audioWindow         : " << audioWindow;
     VERBOSE << "searchWindow        : " << searchWindow;
+    VERBOSE << "threads             : " << threads;
+    VERBOSE << "maxUtterance        : " << maxUtterance;
+    VERBOSE << "vadAggressiveness   : " << vadAggressiveness;
     VERBOSE << "chosenAlignerType   : " << chosenAlignerType;
     VERBOSE << "grammarType         : " << grammarType;
     VERBOSE << "outputFormat        : " << outputFormat;
     VERBOSE << "printOption         : " << printOption;
     VERBOSE << "verbosity           : " << verbosity;
     VERBOSE << "useFSG              : " << useFSG;
+    VERBOSE << "forcedAlignment     : " << forcedAlignment;
     VERBOSE << "transcribe          : " << transcribe;
     VERBOSE << "useBatchMode        : " << useBatchMode;
     VERBOSE << "ExperimentalParams  : " << useExperimentalParams;
     VERBOSE << "searchPhonemes      : " << searchPhonemes;
     VERBOSE << "displayRecognised   : " << displayRecognised;
     VERBOSE << "readStream          : " << readStream;
+    VERBOSE << "streamAudio         : " << streamAudio;
+    VERBOSE << "precomputeFeatures  : " << precomputeFeatures;
+    VERBOSE << "featureCachePath    : " << featureCachePath;
+    VERBOSE << "lexiconPath         : " << lexiconPath;
+    VERBOSE << "pronunciationCache  : " << pronunciationCachePath;
     VERBOSE << "quickDict           : " << quickDict;
     VERBOSE << "quickLM             : " << quickLM;
+    VERBOSE << "dumpGrammar         : " << dumpGrammar;
+    VERBOSE << "pruneDict           : " << pruneDict;
+    VERBOSE << "workspacePath       : " << workspacePath;
+    VERBOSE << "removeWorkspace     : " << removeWorkspace;
+    VERBOSE << "useLattice          : " << useLattice;
+    VERBOSE << "trimSilence         : " << trimSilence;
+    VERBOSE << "liveAlign           : " << liveAlign;
+    VERBOSE << "latency             : " << latency;
+    VERBOSE << "history             : " << history;
+    VERBOSE << "manifestFileName    : " << manifestFileName;
+    VERBOSE << "jobs                : " << jobs;
+    VERBOSE << "summaryFileName     : " << summaryFileName;
+    VERBOSE << "socketPath          : " << socketPath;
+    VERBOSE << "queueLength         : " << queueLength;
     VERBOSE << "\n\n=====================================================\n";
 }
@@ -8,25 +8,29 @@
 #define CCALIGNER_PARAMS_H
 
 #include "commons.h"
+#include "workspace.h"
 
 #include <ctime>
 
 class Params {
     std::string localTime;
     void validateParams();
+    void useWorkspace(const std::string& directory);     //move paths left at their default into the workspace
 public:
-    std::string audioFileName, subtitleFileName, transcriptFileName, outputFileName, modelPath, lmPath, dictPath, fsgPath, logPath, phoneticLmPath, phonemeLogPath, alignerLogPath;
+    std::string audioFileName, subtitleFileName, transcriptFileName, outputFileName, modelPath, lmPath, dictPath, fsgPath, logPath, phoneticLmPath, phonemeLogPath, alignerLogPath, featureCachePath, lexiconPath, pronunciationCachePath, workspacePath, manifestFileName, summaryFileName, socketPath;
     bool audioIsRaw;
-    unsigned long searchWindow, sampleWindow, audioWindow;
+    unsigned long searchWindow, sampleWindow, audioWindow, threads, maxUtterance, latency, history, jobs, queueLength;
+    int vadAggressiveness;
     alignerType chosenAlignerType;
     grammarName grammarType;
     outputFormats outputFormat;
     outputOptions printOption;
-    bool verbosity, usingTranscript, useFSG, transcribe, useBatchMode, useExperimentalParams, searchPhonemes, displayRecognised, readStream, quickDict, quickLM;
+    bool verbosity, usingTranscript, useFSG, forcedAlignment, transcribe, useBatchMode, useExperimentalParams, searchPhonemes, displayRecognised, readStream, streamAudio, precomputeFeatures, quickDict, quickLM, dumpGrammar, pruneDict, removeWorkspace, useLattice, trimSilence, liveAlign;
 
     Params() noexcept;
     void inputParams(int argc, char *argv[]);
     void printParams() const noexcept;
+    Params forJob(const std::string& audio, const std::string& subtitles, const std::string& output) const;  //parameters aligning one file of a batch or request, output derived from the audio if empty
 
 };
 
@@ -26,21 +26,42 @@ std::wstring latin1ToWide(const std::string& s)
     return result;
 }
 
-const std::vector<std::pair<std::wregex, std::wstring>>& getReplacementRules()
+const std::vector<std::pair<std::wstring, std::wstring>>& getRules()
 {
-    static std::vector<std::pair<std::wregex, std::wstring>> rules
+    static std::vector<std::pair<std::wstring, std::wstring>> rules
         {
         #include "g2p_rules.cpp"
 
             // Turn bigrams into unigrams for easier conversion
-            { std::wregex(L"ôw"), L"Ω" },
-            { std::wregex(L"öy"), L"ω" },
-            { std::wregex(L"@r"), L"ɝ" }
+            { L"ôw", L"Ω" },
+            { L"öy", L"ω" },
+            { L"@r", L"ɝ" }
         };
 
     return rules;
 }
 
+const std::vector<std::pair<std::wregex, std::wstring>>& getReplacementRules()
+{
+    static std::vector<std::pair<std::wregex, std::wstring>> rules = []
+        {
+            std::vector<std::pair<std::wregex, std::wstring>> compiled;
+
+            for (const auto& rule : getRules())
+                compiled.emplace_back(std::wregex(rule.first), rule.second);
+
+            return compiled;
+        }();
+
+    return rules;
+}
+
+const SoundChanges& getSoundChanges()
+{
+    static SoundChanges rules(getRules());
+    return rules;
+}
+
 Phoneme charToPhone(wchar_t c)
 {
     // For reference, see http://www.zompist.com/spell.html
@@ -91,9 +112,8 @@ Phoneme charToPhone(wchar_t c)
     return " "; // treating noise as silence
 }
 
-std::vector<Phoneme> stringToPhoneme(const std::string &word)
+std::wstring applyReplacementRules(const std::string &word)
 {
-
     std::wstring wideWord = latin1ToWide(word);
     for (const auto& rule : getReplacementRules())
     {
@@ -111,6 +131,13 @@ std::vector<Phoneme> stringToPhoneme(const std::string &word)
         } while (changed);
     }
 
+    return wideWord;
+}
+
+std::vector<Phoneme> stringToPhoneme(const std::string &word)
+{
+    std::wstring wideWord = getSoundChanges().apply(latin1ToWide(word));
+
     // Remove duplicate phones
     std::vector<Phoneme> result;
     Phoneme lastPhoneme = "Noise";
@@ -132,4 +159,3 @@ std::vector<Phoneme> stringToPhoneme(const std::string &word)
     }
     return result;
 }
-
@@ -16,10 +16,14 @@
 #define CCALIGNER_PHONEME_UTILS_H
 
 #include "commons.h"
+#include "sound_changes.h"
 using Phoneme = std::string;
 
 std::wstring latin1ToWide(const std::string& s);
+const std::vector<std::pair<std::wstring, std::wstring>>& getRules();   //patterns and replacements, as for regex_replace
 const std::vector<std::pair<std::wregex, std::wstring>>& getReplacementRules();
+const SoundChanges& getSoundChanges();                                  //the same rules, compiled
+std::wstring applyReplacementRules(const std::string &word);            //with std::wregex, for reference
 Phoneme charToPhone(wchar_t c);
 std::vector<Phoneme> stringToPhoneme(const std::string &word);
 
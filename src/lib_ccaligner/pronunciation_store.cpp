@@ -0,0 +1,279 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "pronunciation_store.h"
+
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <sys/stat.h>
+
+#ifdef WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+const std::size_t PronunciationStore::headerSize;
+
+static const char storeMagic[8] = {'C', 'C', 'A', 'P', 'R', 'O', 'N', '1'};
+static const uint64_t fnvOffsetBasis = 14695981039346656037ULL, fnvPrime = 1099511628211ULL;
+
+static uint64_t hashBytes(const std::string& bytes, uint64_t hash) noexcept
+{
+    for (unsigned char byte : bytes)
+    {
+        hash ^= byte;
+        hash *= fnvPrime;
+    }
+
+    return hash;
+}
+
+PronunciationStore::PronunciationStore() noexcept
+    : _data(nullptr),
+      _size(0),
+      _stamp(0),
+      _numberOfEntries(0)
+{
+
+}
+
+uint64_t PronunciationStore::fileStamp(const std::string& fileName)
+{
+    struct stat status;
+
+    if (stat(fileName.c_str(), &status) != 0)
+        return 0;
+
+    std::ostringstream stamp;
+    stamp << fileName << '\0' << status.st_size << '\0' << status.st_mtime;
+    return hashBytes(stamp.str(), fnvOffsetBasis) | 1;     //never 0, which marks a cache
+}
+
+const char * PronunciationStore::entry(std::size_t index) const noexcept
+{
+    uint32_t offset;
+    std::memcpy(&offset, _data + headerSize + index * sizeof(offset), sizeof(offset));
+    return offset < _size ? reinterpret_cast<const char *>(_data + offset) : nullptr;
+}
+
+void PronunciationStore::assign(const std::map<std::string, std::string>& entries, uint64_t stamp)
+{
+    _mappedFile.close();
+
+    uint64_t numberOfEntries = entries.size();
+    std::size_t offset = headerSize + entries.size() * sizeof(uint32_t);
+    std::size_t size = offset;
+
+    for (const auto& entry : entries)
+        size += entry.first.size() + entry.second.size() + 2;
+
+    _buffer.assign(size, 0);
+    std::memcpy(_buffer.data(), storeMagic, sizeof(storeMagic));
+    std::memcpy(_buffer.data() + 8, &stamp, sizeof(stamp));
+    std::memcpy(_buffer.data() + 16, &numberOfEntries, sizeof(numberOfEntries));
+
+    std::size_t index = 0;
+
+    for (const auto& entry : entries)
+    {
+        uint32_t entryOffset = static_cast<uint32_t>(offset);
+        std::memcpy(_buffer.data() + headerSize + index++ * sizeof(entryOffset), &entryOffset, sizeof(entryOffset));
+
+        std::memcpy(_buffer.data() + offset, entry.first.data(), entry.first.size());
+        offset += entry.first.size() + 1;
+        std::memcpy(_buffer.data() + offset, entry.second.data(), entry.second.size());
+        offset += entry.second.size() + 1;
+    }
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+    _stamp = stamp;
+    _numberOfEntries = numberOfEntries;
+}
+
+bool PronunciationStore::readDictionary(const std::string& fileName)
+{
+    std::ifstream dictionary(fileName);
+
+    if (!dictionary)
+        return false;
+
+    std::map<std::string, std::string> entries;
+    std::string line;
+
+    while (std::getline(dictionary, line))
+    {
+        std::istringstream iss(line);
+        std::string word, phone, phonemes;
+
+        if (!(iss >> word) || word.compare(0, 3, ";;;") == 0)  //comment
+            continue;
+
+        if (word.size() > 3 && word.back() == ')' && word.find('(') != std::string::npos)  //alternate pronunciation, as in word(2)
+            continue;
+
+        while (iss >> phone)
+            phonemes += phonemes.empty() ? phone : " " + phone;
+
+        if (!phonemes.empty())
+            entries.emplace(stringToLower(word), phonemes);
+    }
+
+    assign(entries, fileStamp(fileName));
+    return true;
+}
+
+bool PronunciationStore::load(const std::string& fileName, uint64_t stamp)
+{
+    if (!_mappedFile.open(fileName))
+        return false;
+
+    const unsigned char *data = _mappedFile.data();
+    std::size_t size = _mappedFile.size();
+    uint64_t fileStamp, numberOfEntries;
+
+    if (size < headerSize || std::memcmp(data, storeMagic, sizeof(storeMagic)) != 0)
+    {
+        WARNING << "Ignoring pronunciations in " << fileName << ", it is not a pronunciation store";
+        _mappedFile.close();
+        return false;
+    }
+
+    std::memcpy(&fileStamp, data + 8, sizeof(fileStamp));
+    std::memcpy(&numberOfEntries, data + 16, sizeof(numberOfEntries));
+
+    //every entry must be terminated within the file
+    if (numberOfEntries > (size - headerSize) / sizeof(uint32_t) || (numberOfEntries > 0 && data[size - 1] != 0))
+    {
+        WARNING << "Ignoring pronunciations in " << fileName << ", the file is truncated";
+        _mappedFile.close();
+        return false;
+    }
+
+    if (fileStamp != stamp)
+    {
+        DEBUG << "Pronunciations in " << fileName << " are stale";
+        _mappedFile.close();
+        return false;
+    }
+
+    _buffer.clear();
+    _data = data;
+    _size = size;
+    _stamp = fileStamp;
+    _numberOfEntries = numberOfEntries;
+
+    DEBUG << "Loaded " << _numberOfEntries << " pronunciations from " << fileName;
+    return true;
+}
+
+bool PronunciationStore::save(const std::string& fileName) const
+{
+    //renamed once complete, readers never see a partial file and concurrent writers (processes, jobs of a batch) do not share it
+    static std::atomic<unsigned long> saved(0);
+    std::string temporaryFileName = fileName + "." + std::to_string(getpid()) + "-" + std::to_string(saved++) + ".tmp";
+    std::ofstream out(temporaryFileName, std::ios::binary);
+
+    if (!out)
+    {
+        WARNING << "Unable to write pronunciations : " << temporaryFileName;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char *>(_data), _size);
+    out.close();
+
+#ifdef WIN32
+    std::remove(fileName.c_str());  //rename() does not replace an existing file on Windows
+#endif
+
+    if (!out || std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+    {
+        WARNING << "Unable to write pronunciations : " << fileName;
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    DEBUG << "Saved " << _numberOfEntries << " pronunciations to " << fileName;
+    return true;
+}
+
+bool PronunciationStore::append(const std::string& fileName, const std::map<std::string, std::string>& entries)
+{
+    std::map<std::string, std::string> merged;
+
+    {
+        PronunciationStore existing;
+
+        if (existing.load(fileName))
+            merged = existing.entries();
+    }
+
+    for (const auto& entry : entries)
+        merged[entry.first] = entry.second;     //replacing what is stored for the same word
+
+    PronunciationStore store;
+    store.assign(merged);
+    return store.save(fileName);
+}
+
+bool PronunciationStore::find(const std::string& word, std::string& phonemes) const
+{
+    std::string key = stringToLower(word);
+    std::size_t first = 0, last = size();
+
+    while (first < last)
+    {
+        std::size_t middle = first + (last - first) / 2;
+        const char *current = entry(middle);
+
+        if (current == nullptr)
+            return false;
+
+        int order = std::strcmp(current, key.c_str());
+
+        if (order == 0)
+        {
+            const char *found = current + std::strlen(current) + 1;
+
+            if (found >= reinterpret_cast<const char *>(_data + _size))
+                return false;
+
+            phonemes.assign(found);
+            return true;
+        }
+
+        if (order < 0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return false;
+}
+
+std::map<std::string, std::string> PronunciationStore::entries() const
+{
+    std::map<std::string, std::string> result;
+
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        const char *word = entry(i);
+
+        if (word == nullptr)
+            continue;
+
+        const char *phonemes = word + std::strlen(word) + 1;
+
+        if (phonemes < reinterpret_cast<const char *>(_data + _size))
+            result.emplace(word, phonemes);
+    }
+
+    return result;
+}
@@ -0,0 +1,58 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_PRONUNCIATION_STORE_H
+#define CCALIGNER_PRONUNCIATION_STORE_H
+
+#include "read_wav_file.h"
+#include <map>
+
+/*
+ * Store file layout (host byte order) :
+ *
+ *  0   char[8]     "CCAPRON1"
+ *  8   uint64      stamp, of the dictionary the store was compiled from, 0 for a cache
+ *  16  uint64      number of entries
+ *  24  uint32[]    offset of every entry from the beginning of the file, sorted by word
+ *  ..  entries     word '\0' phonemes '\0', phonemes separated by spaces
+ *
+ * Lookups are a binary search of the mapped file, nothing is read up front.
+ */
+
+class PronunciationStore    //pronunciations keyed by lowercase word
+{
+    std::vector<unsigned char> _buffer;     //store built in this run
+    MappedFile _mappedFile;                 //store file it is served from, if loaded
+    const unsigned char * _data;            //whichever of the above holds the store
+    std::size_t _size;
+    uint64_t _stamp, _numberOfEntries;
+
+    const char * entry(std::size_t index) const noexcept;  //word of an entry, its phonemes follow
+
+public:
+    static const std::size_t headerSize = 24;
+
+    PronunciationStore() noexcept;
+    PronunciationStore(const PronunciationStore&) = delete;
+    PronunciationStore& operator=(const PronunciationStore&) = delete;
+
+    static uint64_t fileStamp(const std::string& fileName);     //name, size and modification time, 0 if missing
+
+    void assign(const std::map<std::string, std::string>& entries, uint64_t stamp = 0);
+    bool readDictionary(const std::string& fileName);           //first pronunciation of each word of a CMU style dictionary
+    bool load(const std::string& fileName, uint64_t stamp = 0); //map a store file, false if missing, stale or corrupt
+    bool save(const std::string& fileName) const;               //write atomically, false on failure
+
+    //add entries to the store file, a concurrent writer may win but the file is never partial
+    static bool append(const std::string& fileName, const std::map<std::string, std::string>& entries);
+
+    bool find(const std::string& word, std::string& phonemes) const;
+    std::map<std::string, std::string> entries() const;
+    std::size_t size() const noexcept { return static_cast<std::size_t>(_numberOfEntries); }
+    uint64_t stamp() const noexcept { return _stamp; }
+};
+
+#endif //CCALIGNER_PRONUNCIATION_STORE_H
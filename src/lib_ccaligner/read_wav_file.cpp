@@ -6,608 +6,953 @@
 
 #include "read_wav_file.h"
 
-int findIndex(std::vector<unsigned char>& fileData, const std::string& chunk)
+#ifdef WIN32
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+void setStandardInputToBinary() noexcept
 {
-    auto it = std::search(fileData.begin(), fileData.end(), chunk.begin(), chunk.end());
-    return (int)(it-fileData.begin());  //returns beginning of the string passed through "chunk" ('fmt' / 'data')
+#ifdef WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
 }
 
-WaveFileData::WaveFileData(std::string fileName, bool isRawFile) noexcept    //file is stored on disk
-    : _fileName(std::move(fileName)),
-      _openMode(readFile),
-      _isRawFile(isRawFile)
+static bool isLittleEndian() noexcept   //samples in WAV are little endian, a mapping can only be used as is on such hosts
 {
-    _samples.resize(0);
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char *>(&probe) == 1;
 }
 
-WaveFileData::WaveFileData(openMode mode, bool isRawFile) noexcept           //data being read from stream;
-    : _openMode(mode),
-      _isRawFile(isRawFile)
+int findIndex(std::vector<unsigned char>& fileData, const std::string& chunk)
 {
-    _samples.resize(0);
+    auto it = std::search(fileData.begin(), fileData.end(), chunk.begin(), chunk.end());
+    return (int)(it-fileData.begin());  //returns beginning of the string passed through "chunk" ('fmt' / 'data')
 }
 
-bool WaveFileData::checkValidWave (const std::vector<unsigned char>& fileData)
-{
-    /*Offset  Size  Name             Description
-     * 0         4   ChunkID          Contains the letters "RIFF" in ASCII form
-     */
+/* Convert 4 bytes to int
+ * Reference :
+ * https://stackoverflow.com/a/2386134/6487831
+ */
 
-    DEBUG << "Checking chunkID, should be RIFF";
-    std::string chunkID (fileData.begin(), fileData.begin() + 4);
-    return chunkID == "RIFF";
+unsigned long fourBytesToInt (const unsigned char *fileData, std::size_t fileSize, std::size_t index)
+{
+    // Process only if samples are within range
+    if(index+3 < fileSize)
+        return ((unsigned long)fileData[index + 3] << 24) | (fileData[index + 2] << 16) | (fileData[index + 1] << 8) | fileData[index];
 
+    FATAL(InvalidFile) << "Tried accessing samples out of bounds.";
+    return 0;
 }
 
-bool WaveFileData::decode()     //decodes the wave file
+int twoBytesToInt (const unsigned char *fileData, std::size_t fileSize, std::size_t index)
 {
-    /* Wave file format :
-
-        Offset  Size  Name             Description
-
-        The canonical WAVE format starts with the RIFF header:
-
-        0         4   ChunkID          Contains the letters "RIFF" in ASCII form
-                                       (0x52494646 big-endian form).
-        4         4   ChunkSize        36 + SubChunk2Size, or more precisely:
-                                       4 + (8 + SubChunk1Size) + (8 + SubChunk2Size)
-                                       This is the size of the rest of the chunk
-                                       following this number.  This is the size of the
-                                       entire file in bytes minus 8 bytes for the
-                                       two fields not included in this count:
-                                       ChunkID and ChunkSize.
-        8         4   Format           Contains the letters "WAVE"
-                                       (0x57415645 big-endian form).
-
-        The "WAVE" format consists of two subchunks: "fmt " and "data":
-        The "fmt " subchunk describes the sound data's format:
+    // Process only if samples are within range
+    if(index+1 < fileSize)
+        return ((fileData[index + 1] << 8) | fileData[index]);
 
-        12        4   Subchunk1ID      Contains the letters "fmt "
-                                       (0x666d7420 big-endian form).
-        16        4   Subchunk1Size    16 for PCM.  This is the size of the
-                                       rest of the Subchunk which follows this number.
-        20        2   AudioFormat      PCM = 1 (i.e. Linear quantization)
-                                       Values other than 1 indicate some
-                                       form of compression.
-        22        2   NumChannels      Mono = 1, Stereo = 2, etc.
-        24        4   SampleRate       8000, 44100, etc.
-        28        4   ByteRate         == SampleRate * NumChannels * BitsPerSample/8
-        32        2   BlockAlign       == NumChannels * BitsPerSample/8
-                                       The number of bytes for one sample including
-                                       all channels. I wonder what happens when
-                                       this number isn't an integer?
-        34        2   BitsPerSample    8 bits = 8, 16 bits = 16, etc.
-                  2   ExtraParamSize   if PCM, then doesn't exist
-                  X   ExtraParams      space for extra parameters
+    // If file was damaged
+    FATAL(InvalidFile) << "Tried accessing samples out of bounds.";
+    return 0;
+}
 
-        The "data" subchunk contains the size of the data and the actual sound:
+void bytesToSamples (const unsigned char *bytes, std::size_t numberOfSamples, int16_t *samples)
+{
+    if (isLittleEndian())
+    {
+        std::memcpy(samples, bytes, numberOfSamples * sizeof(int16_t));    //already in the host order
+        return;
+    }
 
-        36        4   Subchunk2ID      Contains the letters "data"
-                                       (0x64617461 big-endian form).
-        40        4   Subchunk2Size    == NumSamples * NumChannels * BitsPerSample/8
-                                       This is the number of bytes in the data.
-                                       You can also think of this as the size
-                                       of the read of the subchunk following this
-                                       number.
-        44        *   Data             The actual sound data.
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+        samples[i] = static_cast<int16_t>(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+}
 
-        SOURCE : http://soundfile.sapp.org/doc/WaveFormat/
+WaveFormat parseFormatChunk(const unsigned char *chunkData, std::size_t chunkSize)
+{
+    /*  Offset (w.r.t. chunk body)
 
-        NOTE : I later found out that the subChunks may be located at different offsets
-               in presence of metadata like LIST INFO etc..
+        0         2   AudioFormat           PCM = 1, IEEE float = 3, WAVE_FORMAT_EXTENSIBLE = 0xFFFE
+        2         2   NumChannels
+        4         4   SampleRate
+        8         4   ByteRate
+        12        2   BlockAlign
+        14        2   BitsPerSample
 
-               See : L#108
+        Only for WAVE_FORMAT_EXTENSIBLE :
 
+        16        2   ExtensionSize         22
+        18        2   ValidBitsPerSample
+        20        4   ChannelMask
+        24        16  SubFormat             GUID, begins with the actual AudioFormat
      */
 
-    std::string format(_fileData.begin() + 8, _fileData.begin() + 12);
-
-    if(format != "WAVE")
+    if(chunkSize < 16)
     {
-        DEBUG << "Invalid WAV file format";
-        FATAL(InvalidFile) << "Invalid WAV file format : " << format;
+        FATAL(InvalidFile) << "Incomplete format chunk, SubChunk1Size : " << chunkSize;
     }
 
-    DEBUG << "File format is identified as WAV";
-
-    /*
-     * Apparently, this is just not it. The `fmt ` and `data`  chunk may not necessarily be in continuation.
-     * There may occur inclusion of metadata. So, we'll need to find the location of these chunks.
-     */
-
-    DEBUG << "Finding FMT and DATA subchunks";
+    WaveFormat format;
 
-    int fmtIndex = findIndex(_fileData, "fmt ");
-    int dataIndex = findIndex(_fileData, "data");
+    format.audioFormat = twoBytesToInt(chunkData, chunkSize, 0);
 
-    if(fmtIndex < 0)
+    if(format.audioFormat == extensibleFormat)
     {
-        DEBUG << "FMT subchunk not found!";
-        FATAL(InvalidFile) << "FMT subchunk not found!";
+        if(chunkSize < 40)
+        {
+            FATAL(InvalidFile) << "Incomplete WAVE_FORMAT_EXTENSIBLE chunk, SubChunk1Size : " << chunkSize;
+        }
+
+        format.audioFormat = twoBytesToInt(chunkData, chunkSize, 24);
+        DEBUG << "WAVE_FORMAT_EXTENSIBLE, SubFormat : " << format.audioFormat;
     }
 
-    if(dataIndex < 0)
+    if(format.audioFormat != pcmFormat && format.audioFormat != floatFormat)
     {
-        DEBUG << "Data subchunk not found!";
-        FATAL(InvalidFile) << "Data subchunk not found!";
+        FATAL(InvalidFile) << "Not PCM or IEEE float, AudioFormat : " << format.audioFormat;
     }
 
-    DEBUG << "FMT index : "<< fmtIndex <<" , DATA index : " << dataIndex;
-
-    std::string subChunk1ID(_fileData.begin() + fmtIndex, _fileData.begin() + fmtIndex + 4);
+    format.numChannels = twoBytesToInt(chunkData, chunkSize, 2);
 
-    if(subChunk1ID != "fmt ")
+    if(format.numChannels < 1)
     {
-        FATAL(InvalidFile) << "Invalid SubChunk1ID : " << subChunk1ID;
+        FATAL(InvalidFile) << "Invalid number of channels, NumChannels : " << format.numChannels;
     }
 
-    unsigned long subChunk1Size = fourBytesToInt(_fileData, fmtIndex + 4);
+    format.sampleRate = fourBytesToInt(chunkData, chunkSize, 4);
 
-    if(subChunk1Size != 16)
+    if(format.sampleRate == 0)
     {
-        FATAL(InvalidFile) << "Not PCM, SubChunk1Size : " << subChunk1Size;
+        FATAL(InvalidFile) << "Invalid SampleRate : " << format.sampleRate;
     }
 
-    int audioFormat = twoBytesToInt(_fileData, fmtIndex + 8);
+    format.byteRate = fourBytesToInt(chunkData, chunkSize, 8);
+    format.blockAlign = twoBytesToInt(chunkData, chunkSize, 12);
+    format.bitsPerSample = twoBytesToInt(chunkData, chunkSize, 14);
 
-    if(audioFormat != 1)
+    bool supportedDepth = (format.audioFormat == pcmFormat) ?
+                          (format.bitsPerSample == 8 || format.bitsPerSample == 16 || format.bitsPerSample == 24 || format.bitsPerSample == 32) :
+                          (format.bitsPerSample == 32 || format.bitsPerSample == 64);
+
+    if(!supportedDepth)
     {
-        FATAL(InvalidFile) << "Not PCM, AudioFormat : " << audioFormat;
+        FATAL(InvalidFile) << "Unsupported BitsPerSample : " << format.bitsPerSample;
     }
 
-    DEBUG << "PCM : True";
-
-    int numChannels = twoBytesToInt(_fileData, fmtIndex + 10);
-
-    if(numChannels != 1)
+    if((format.byteRate != format.sampleRate * format.numChannels * format.bitsPerSample / 8) ||
+       (format.blockAlign != format.numChannels * format.bitsPerSample / 8))
     {
-        FATAL(InvalidFile) << "Not Mono, NumChannels : " << numChannels;
+        FATAL(InvalidFile) << "Incorrect header, ByteRate and/or BlockAlign values do not match!";
     }
 
-    DEBUG << "MONO : True";
+    DEBUG << (format.audioFormat == pcmFormat ? "PCM" : "Float") << " : " << format.bitsPerSample << " bits, "
+          << format.numChannels << " channel(s), " << format.sampleRate << "Hz";
 
-    unsigned long sampleRate = fourBytesToInt(_fileData, fmtIndex + 12);
+    if(!isTargetFormat(format))
+        DEBUG << "Audio is not 16 bit PCM mono sampled at 16KHz, it will be converted";
 
-    if(sampleRate != 16000)
-    {
-        FATAL(InvalidFile) << "Not 16000Hz SampleRate, SampleRate : " << sampleRate;
-    }
+    return format;
+}
 
-    DEBUG << "Sample Rate 16KHz : True";
+WaveStreamReader::WaveStreamReader(std::istream& stream, bool isRawStream)
+    : _stream(stream),
+      _buffer(blockSize),
+      _bufferBegin(0),
+      _bufferEnd(0),
+      _state(isRawStream ? readingSamples : readingRiffHeader),
+      _formatFound(isRawStream),
+      _chunkRemaining(0),
+      _dataSizeKnown(false),
+      _format(),
+      _convertedBegin(0),
+      _converterFlushed(false)
+{}
+
+std::size_t WaveStreamReader::readBlock(unsigned char *destination, std::size_t numberOfBytes)
+{
+    _stream.read(reinterpret_cast<char *>(destination), numberOfBytes);
+    return static_cast<std::size_t>(_stream.gcount());
+}
 
-    unsigned long byteRate = fourBytesToInt(_fileData, fmtIndex + 16);
+bool WaveStreamReader::require(std::size_t numberOfBytes)
+{
+    if (buffered() >= numberOfBytes)
+        return true;
 
-    int blockAlign = twoBytesToInt(_fileData, fmtIndex + 20);
+    //move the unconsumed bytes to the front and top up the buffer
+    std::memmove(_buffer.data(), _buffer.data() + _bufferBegin, buffered());
+    _bufferEnd -= _bufferBegin;
+    _bufferBegin = 0;
 
-    int bitRate = twoBytesToInt(_fileData, fmtIndex + 22); //BitsPerSample
+    if (_buffer.size() < numberOfBytes)
+        _buffer.resize(numberOfBytes);
 
-    if(bitRate != 16)
+    while (_bufferEnd < numberOfBytes)
     {
-        FATAL(InvalidFile) << "Not 16 bits/sec, BitRate : " << bitRate;
-    }
+        std::size_t bytesRead = readBlock(_buffer.data() + _bufferEnd, _buffer.size() - _bufferEnd);
 
-    DEBUG << "BitRate 16 bits/sec : True";
+        if (bytesRead == 0)
+            return false;
 
-    if((byteRate != sampleRate * numChannels * bitRate/8) || (blockAlign != numChannels * bitRate/8))
-    {
-        FATAL(InvalidFile) << "Incorrect header, ByteRate and/or BlockAlign values do not match!";
+        _bufferEnd += bytesRead;
     }
 
-    std::string subChunk2ID (_fileData.begin() + dataIndex, _fileData.begin() + dataIndex + 4);
+    return true;
+}
+
+bool WaveStreamReader::readHeader()
+{
+    DEBUG << "Processing Stream Header";
 
-    if(subChunk2ID != "data")
+    while (_state != readingSamples)
     {
-        FATAL(InvalidFile) << "Invalid SubChunk2ID : " << subChunk2ID;
-    }
+        switch (_state)
+        {
+            case readingRiffHeader:
+            {
+                DEBUG << "Checking chunkID, should be RIFF";
 
-    unsigned long subChunk2Size = fourBytesToInt(_fileData, dataIndex + 4);
+                if (!require(12))
+                {
+                    FATAL(InvalidFile) << "Invalid WAV file : Stream ended inside the header!";
+                }
 
-    unsigned long int numSamples = subChunk2Size * 8 / ( numChannels * bitRate);
+                const unsigned char *header = _buffer.data() + _bufferBegin;
 
-    DEBUG << "Number of samples : " << numSamples;
-    DEBUG << "Reading samples";
+                if (std::string(header, header + 4) != "RIFF")
+                {
+                    FATAL(InvalidFile) << "Invalid WAV file : Incorrect chunkID!";
+                }
 
-    for (unsigned long int i = 0; i < numSamples; i++)
-    {
-            unsigned long int sampleIndex = dataIndex + 8 + (blockAlign * i);
-            // dataIndex = index of beginning of "data" subChunk
-            // dataIndex + 8 is usually 44 as per the specs
+                if (std::string(header + 8, header + 12) != "WAVE")
+                {
+                    DEBUG << "Error: Incorrect header";
+                    FATAL(InvalidFile) << "Invalid WAV file : Incorrect Header!";
+                }
 
-            int16_t sample = twoBytesToInt(_fileData, sampleIndex);
-            _samples.push_back(sample);
-    }
-    DEBUG << "Successfully decoded";
-    return true;    //successfully decoded
-}
+                DEBUG << "wav header = WAVE confirmed!";
 
-bool WaveFileData::openFile ()
-{
-    std::ifstream infile (_fileName, std::ios::binary);
+                _bufferBegin += 12;
+                _state = readingChunkHeader;
+                break;
+            }
 
-    DEBUG << "Trying to read from file : " << _fileName;
+            case readingChunkHeader:
+            {
+                if (!require(8))
+                {
+                    DEBUG << "SubChunk2 ('data') not found";
+                    FATAL(InvalidFile) << "SubChunk2 ('data') not found!";
+                }
 
-    if (!infile)
-    {
-        FATAL(FileNotFound) << "Unable to open file : " << _fileName;
-    }
+                const unsigned char *header = _buffer.data() + _bufferBegin;
+                std::string chunkID(header, header + 4);
+                _chunkRemaining = fourBytesToInt(header, 8, 4);
+                _bufferBegin += 8;
 
-    DEBUG << "Reading file data";
+                DEBUG << "Found chunk : " << chunkID << " of size " << _chunkRemaining;
 
-    if (_isRawFile) { // handle raw audio files
-        infile.seekg(0, std::ios::end);
-        std::streamsize size = infile.tellg();
-        infile.seekg(0, std::ios::beg);
+                if (chunkID == "fmt ")
+                    _state = readingFormatChunk;
 
-        _samples = std::vector<int16_t>(size/2); // size is in unit of byte, while one int_16 uses 2 bytes
-        if (infile.read(reinterpret_cast<char*>(_samples.data()), size)) {
-            DEBUG << "File data read";
-            DEBUG << "Decoding is skipped since it is raw audio file";
-            return true;
-        }
-        else {
-            FATAL(InvalidFile) << "Unable to read from file : " << _fileName;
-            return false;
-        }
-    }
+                else if (chunkID == "data")
+                {
+                    if (!_formatFound)
+                    {
+                        FATAL(InvalidFile) << "Invalid WAV file: SubChunk1 ('fmt') not found!";
+                    }
+
+                    //streaming writers (ffmpeg et al.) cannot seek back and leave 0 or 0xFFFFFFFF as size
+                    _dataSizeKnown = _chunkRemaining != 0 && _chunkRemaining != 0xFFFFFFFFUL;
+                    _state = readingSamples;
+                }
 
+                else
+                {
+                    _chunkRemaining += _chunkRemaining & 1;     //chunks are padded to even size
+                    _state = skippingChunk;
+                }
 
-    /*
-    * When reading characters, std::istream_iterator skips whitespace by default
-    * (unless disabled with std::noskipws or equivalent)..
-    * http://www.enseignement.polytechnique.fr/informatique/INF478/docs/Cpp/en/cpp/iterator/istream_iterator.html#Notes
-    */
+                break;
+            }
 
-    std::noskipws(infile);
-    std::istream_iterator<unsigned char> begin(infile), end;
-    std::vector<unsigned char> fileData (begin, end);   //read complete file content
+            case readingFormatChunk:
+            {
+                DEBUG << "Validating SubChunk1";
 
-    DEBUG << "File data read and stored in buffer";
+                if (!require(_chunkRemaining))
+                {
+                    FATAL(InvalidFile) << "Invalid WAV file: Stream ended inside SubChunk1 ('fmt')!";
+                }
 
-    DEBUG << "Processing data and extracting samples";
+                _format = parseFormatChunk(_buffer.data() + _bufferBegin, _chunkRemaining);
+                _formatFound = true;
 
-    if(checkValidWave(fileData))
-    {
-        DEBUG << "Wave File chunkID verification successful";
+                if (!isTargetFormat(_format))
+                    _converter.reset(new AudioConverter(_format));
 
-        _fileData = fileData;   //wave is valid, store and proceed
+                _bufferBegin += _chunkRemaining;
+                _chunkRemaining = (_chunkRemaining & 1);
+                _state = _chunkRemaining ? skippingChunk : readingChunkHeader;
+                break;
+            }
 
-        DEBUG << "Begin decoding wave file";
+            case skippingChunk:
+            {
+                if (buffered() == 0 && !require(1))
+                {
+                    FATAL(InvalidFile) << "SubChunk2 ('data') not found!";
+                }
 
-        decode();
+                std::size_t skip = std::min<std::size_t>(buffered(), _chunkRemaining);
+                _bufferBegin += skip;
+                _chunkRemaining -= skip;
 
-        DEBUG << "File decoded successfully";
+                if (_chunkRemaining == 0)
+                    _state = readingChunkHeader;
 
-        return true;
-    }
+                break;
+            }
 
-    else
-    {
-        DEBUG << "Invalid WAV file";
-        FATAL(InvalidFile) << "Invalid WAV file!";
+            default:
+                return false;
+        }
     }
 
     return true;
 }
 
-int WaveFileData::processStreamHeader()
+std::size_t WaveStreamReader::readSamples(int16_t *samples, std::size_t maxSamples)
 {
-    DEBUG << "Processing Stream Header";
-    DEBUG << "Checking chunkID, should be RIFF";
-    unsigned char byteData;
-    std::string riff ("RIFF"), wave ("WAVE");
-    bool riffRead = false;                      //are 'RIFF' bytes read?
-    int currentByteCount = -1, chunkSize = 0;
+    if (_state != readingSamples)
+        return 0;
 
-    while (std::cin >> std::noskipws >> byteData)
-    {
-        _fileData.push_back(byteData);
-        currentByteCount++;
+    if (_converter)
+        return readConvertedSamples(samples, maxSamples);
 
-        if (!riffRead)
-        {
-            if (riff[currentByteCount] != byteData)     //checking RIFF header
-            {
-                FATAL(InvalidFile) << "Invalid WAV file : Incorrect subChunk1ID!";
-            }
+    if (_dataSizeKnown)
+        maxSamples = std::min<std::size_t>(maxSamples, _chunkRemaining / 2);
 
-            if (currentByteCount == 3)
-            {
-                riffRead = true;
-                DEBUG << "chunkID = RIFF confirmed!";
-                DEBUG << "Checking WAV file header, should be WAVE";
+    std::size_t samplesRead = 0;
 
-            }
+    while (samplesRead < maxSamples)
+    {
+        if (buffered() >= 2)    //drain what is already buffered
+        {
+            std::size_t count = std::min(maxSamples - samplesRead, buffered() / 2);
+            bytesToSamples(_buffer.data() + _bufferBegin, count, samples + samplesRead);
+            _bufferBegin += 2 * count;
+            samplesRead += count;
         }
 
-        else
+        else if (buffered() == 0 && (maxSamples - samplesRead) * 2 >= blockSize)
         {
-            if (currentByteCount >= 8)
-            {
-                if (wave[currentByteCount - 8] != byteData) //checking WAVE format
-                {
-                    DEBUG << "Error: Incorrect header";
-                    FATAL(InvalidFile) << "Invalid WAV file : Incorrect Header!";
-                }
+            //large request on an empty buffer, read straight into the destination
+            unsigned char *destination = reinterpret_cast<unsigned char *>(samples + samplesRead);
+            std::size_t bytesWanted = (maxSamples - samplesRead) * 2;
+            std::size_t bytesRead = readBlock(destination, bytesWanted);
+            std::size_t count = bytesRead / 2;
 
-                if (currentByteCount == 11)
-                {
-                    return chunkSize - 8;
-                    DEBUG << "wav header = WAVE confirmed!";
-                }
+            if (!isLittleEndian())
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    std::swap(destination[2 * i], destination[2 * i + 1]);
             }
 
-            else
+            if (bytesRead % 2)  //keep the dangling byte of an incomplete sample
             {
-                chunkSize = chunkSize | byteData << (8 * (currentByteCount - 4));   //calculating chunksize (filesize - 8)
+                _buffer[0] = destination[bytesRead - 1];
+                _bufferBegin = 0;
+                _bufferEnd = 1;
             }
+
+            samplesRead += count;
+
+            if (bytesRead < bytesWanted)
+                break;  //end of stream
+        }
+
+        else if (!require(2))
+        {
+            break;  //end of stream
         }
     }
-    FATAL(UnknownError) << "Error occurred while processing stream header!";
+
+    if (_dataSizeKnown)
+        _chunkRemaining -= 2 * samplesRead;
+
+    if (samplesRead == 0 && maxSamples > 0)
+        _state = finished;
+
+    return samplesRead;
 }
 
-int WaveFileData::seekToEndOfSubChunk1ID(int remainingBytes)
+std::size_t WaveStreamReader::readConvertedSamples(int16_t *samples, std::size_t maxSamples)
 {
-    DEBUG << "Checking SubChunk1ID, should be fmt";
+    const std::size_t frameSize = _format.blockAlign;
+    std::size_t samplesRead = 0;
 
-    unsigned char byteData;
-    std::string fmt ("fmt");
-    int fmtCount = 0, readBytes = 0;
-
-    while(std::cin>>std::noskipws>>byteData)
+    while (samplesRead < maxSamples)
     {
-        _fileData.push_back(byteData);
+        if (_convertedBegin < _converted.size())   //hand out what is already converted
+        {
+            std::size_t count = std::min(maxSamples - samplesRead, _converted.size() - _convertedBegin);
+            std::memcpy(samples + samplesRead, _converted.data() + _convertedBegin, count * sizeof(int16_t));
+            _convertedBegin += count;
+            samplesRead += count;
+            continue;
+        }
+
+        _converted.clear();
+        _convertedBegin = 0;
 
-        readBytes++;
+        if (_converterFlushed)
+            break;  //end of stream
 
-        if(byteData == fmt[fmtCount])   //probably 'fmt'
+        bool framesLeft = !_dataSizeKnown || _chunkRemaining >= frameSize;
+
+        if (framesLeft && require(frameSize))   //convert whole frames of a buffered block
         {
-            fmtCount++;
+            std::size_t bytes = buffered();
 
-            if(fmtCount == 3)           //definitely 'fmt'
-            {
-                DEBUG << "SubChunk1ID = fmt confirmed!";
+            if (_dataSizeKnown)
+                bytes = std::min<std::size_t>(bytes, _chunkRemaining);
 
-                std::cin>>std::noskipws>>byteData;
-                _fileData.push_back(byteData);
-                return readBytes + 1;   // +1 because the block is 4 bytes 'fmt' + ' ' an empty byte.
-            }
+            std::size_t numberOfFrames = bytes / frameSize;
+            _converter->convert(_buffer.data() + _bufferBegin, numberOfFrames, _converted);
 
-        }
+            _bufferBegin += numberOfFrames * frameSize;
 
-        else
-        {
-            fmtCount = 0;
+            if (_dataSizeKnown)
+                _chunkRemaining -= numberOfFrames * frameSize;
         }
 
-        if(readBytes > remainingBytes)
+        else
         {
-            DEBUG << "SubChunk1 ('fmt') not found";
-            FATAL(InvalidFile) << "Invalid WAV file: SubChunk1 ('fmt') not found!";
+            _converter->flush(_converted);
+            _converterFlushed = true;
         }
     }
-    FATAL(UnknownError) << "Error occurred while checking SubChunk1ID";
-    return -1;
-}
 
-int WaveFileData::validateSubChunk1(int remainingBytes)
-{
-    DEBUG << "Validating SubChunk1";
+    if (samplesRead == 0 && maxSamples > 0)
+        _state = finished;
 
-    unsigned char byteData;
-    std::vector<unsigned char> fmtBlock;
-    int currentByteCount = -1;
+    return samplesRead;
+}
 
+std::size_t WaveStreamReader::readBytes(std::vector<unsigned char>& bytes)
+{
+    std::size_t bytesRead = buffered();
+    bytes.insert(bytes.end(), _buffer.begin() + _bufferBegin, _buffer.begin() + _bufferEnd);
+    _bufferBegin = _bufferEnd = 0;
 
-    while(std::cin>>std::noskipws>>byteData)
+    while (true)
     {
-        _fileData.push_back(byteData);
-        currentByteCount++;
-        fmtBlock.push_back(byteData);               //storing 'fmt' data in a buffer, processing live is dangerous
-        DEBUG << "Storing 'fmt' data in a buffer";
+        std::size_t oldSize = bytes.size();
+        bytes.resize(oldSize + blockSize);
 
-        if(currentByteCount == 19)
-        {
-            break;
-        }
+        std::size_t count = readBlock(bytes.data() + oldSize, blockSize);
+        bytes.resize(oldSize + count);
+        bytesRead += count;
 
+        if (count < blockSize)
+            break;
     }
 
-    unsigned long subChunk1Size = fourBytesToInt(fmtBlock, 0);
+    _state = finished;
+    return bytesRead;
+}
 
-    if(subChunk1Size != 16)
-    {
-        FATAL(InvalidFile) << "Invalid WAV file: Not PCM, SubChunk1Size: " << subChunk1Size;
-    }
+std::size_t WaveStreamReader::expectedSamples() const noexcept
+{
+    if (!_dataSizeKnown)
+        return 0;
 
-    int audioFormat = twoBytesToInt(fmtBlock, 4);
+    if (_converter)
+        return _converter->expectedSamples(_chunkRemaining / _format.blockAlign);
 
-    if(audioFormat != 1)
+    return _chunkRemaining / 2;
+}
+
+SampleView::SampleView(const int16_t *data, std::size_t size, std::size_t firstSample) noexcept
+    : _data(data),
+      _size(size),
+      _firstSample(firstSample)
+{}
+
+MappedFile::MappedFile() noexcept
+    : _data(nullptr),
+      _size(0),
+#ifdef WIN32
+      _fileHandle(INVALID_HANDLE_VALUE),
+      _mappingHandle(nullptr)
+#else
+      _fileDescriptor(-1)
+#endif
+{}
+
+bool MappedFile::open(const std::string& fileName)
+{
+    close();
+
+#ifdef WIN32
+    _fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (_fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(_fileHandle, &fileSize) || fileSize.QuadPart == 0)
     {
-        FATAL(InvalidFile) << "Invalid WAV file: Not PCM, AudioFormat: " << audioFormat;
+        close();
+        return false;
     }
 
-    int numChannels = twoBytesToInt(fmtBlock, 6);
+    _mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
 
-    if(numChannels != 1)
+    if (_mappingHandle == nullptr)
     {
-        FATAL(InvalidFile) << "Invalid WAV file: Not Mono, NumChannels: " << numChannels;
+        close();
+        return false;
     }
 
-    unsigned long sampleRate = fourBytesToInt(fmtBlock, 8);
+    void *mapping = MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
 
-    if(sampleRate != 16000)
+    if (mapping == nullptr)
     {
-        FATAL(InvalidFile) << "Invalid WAV file: Not 16000Hz SampleRate, SampleRate: " << sampleRate;
+        close();
+        return false;
     }
 
-    unsigned long byteRate = fourBytesToInt(fmtBlock, 12);
+    _size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    _fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
 
-    int blockAlign = twoBytesToInt(fmtBlock, 16);
+    if (_fileDescriptor < 0)
+        return false;
 
-    int bitRate = twoBytesToInt(fmtBlock, 18); //BitsPerSample
+    struct stat fileStatus;
 
-    if(bitRate != 16)
+    if (fstat(_fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode) || fileStatus.st_size == 0)
     {
-        FATAL(InvalidFile) << "Invalid WAV file: Not 16 bits/sec, BitRate: " << bitRate;
+        close();
+        return false;
     }
 
-    if((byteRate != sampleRate * numChannels * bitRate/8) || (blockAlign != numChannels * bitRate/8))
+    void *mapping = mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+
+    if (mapping == MAP_FAILED)
     {
-        FATAL(InvalidFile) << "Incorrect header, ByteRate and/or BlockAlign values do not match!";
+        close();
+        return false;
     }
 
-    return currentByteCount + 1;
+#ifdef MADV_SEQUENTIAL
+    madvise(mapping, static_cast<std::size_t>(fileStatus.st_size), MADV_SEQUENTIAL);  //subtitles are processed in order
+#endif
+
+    _size = static_cast<std::size_t>(fileStatus.st_size);
+#endif
+
+    _data = static_cast<const unsigned char *>(mapping);
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+#ifdef WIN32
+    if (_data != nullptr)
+        UnmapViewOfFile(_data);
+
+    if (_mappingHandle != nullptr)
+        CloseHandle(_mappingHandle);
+
+    if (_fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(_fileHandle);
+
+    _mappingHandle = nullptr;
+    _fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (_data != nullptr)
+        munmap(const_cast<unsigned char *>(_data), _size);
+
+    if (_fileDescriptor >= 0)
+        ::close(_fileDescriptor);
+
+    _fileDescriptor = -1;
+#endif
+
+    _data = nullptr;
+    _size = 0;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+WaveFileData::WaveFileData(std::string fileName, bool isRawFile) noexcept    //file is stored on disk
+    : _fileName(std::move(fileName)),
+      _useMappedSamples(false),
+      _openMode(readFile),
+      _isRawFile(isRawFile)
+{
+    _samples.resize(0);
+}
+
+WaveFileData::WaveFileData(openMode mode, bool isRawFile) noexcept           //data being read from stream;
+    : _useMappedSamples(false),
+      _openMode(mode),
+      _isRawFile(isRawFile)
+{
+    _samples.resize(0);
+}
+
+bool WaveFileData::checkValidWave (const unsigned char *fileData, std::size_t fileSize)
+{
+    /*Offset  Size  Name             Description
+     * 0         4   ChunkID          Contains the letters "RIFF" in ASCII form
+     */
+
+    DEBUG << "Checking chunkID, should be RIFF";
+
+    if (fileSize < 12)
+        return false;
+
+    std::string chunkID (fileData, fileData + 4);
+    return chunkID == "RIFF";
 
 }
 
-int WaveFileData::seekToEndOfSubChunk2ID(int remainingBytes)
+bool WaveFileData::decode(const unsigned char *fileData, std::size_t fileSize, bool isMapped)     //decodes the wave file
 {
-    DEBUG << "Reading SubChunk2";
+    /* Wave file format :
+
+        Offset  Size  Name             Description
+
+        The canonical WAVE format starts with the RIFF header:
+
+        0         4   ChunkID          Contains the letters "RIFF" in ASCII form
+                                       (0x52494646 big-endian form).
+        4         4   ChunkSize        36 + SubChunk2Size, or more precisely:
+                                       4 + (8 + SubChunk1Size) + (8 + SubChunk2Size)
+                                       This is the size of the rest of the chunk
+                                       following this number.  This is the size of the
+                                       entire file in bytes minus 8 bytes for the
+                                       two fields not included in this count:
+                                       ChunkID and ChunkSize.
+        8         4   Format           Contains the letters "WAVE"
+                                       (0x57415645 big-endian form).
+
+        The "WAVE" format consists of two subchunks: "fmt " and "data":
+        The "fmt " subchunk describes the sound data's format:
+
+        12        4   Subchunk1ID      Contains the letters "fmt "
+                                       (0x666d7420 big-endian form).
+        16        4   Subchunk1Size    16 for PCM.  This is the size of the
+                                       rest of the Subchunk which follows this number.
+        20        2   AudioFormat      PCM = 1 (i.e. Linear quantization)
+                                       Values other than 1 indicate some
+                                       form of compression.
+        22        2   NumChannels      Mono = 1, Stereo = 2, etc.
+        24        4   SampleRate       8000, 44100, etc.
+        28        4   ByteRate         == SampleRate * NumChannels * BitsPerSample/8
+        32        2   BlockAlign       == NumChannels * BitsPerSample/8
+                                       The number of bytes for one sample including
+                                       all channels. I wonder what happens when
+                                       this number isn't an integer?
+        34        2   BitsPerSample    8 bits = 8, 16 bits = 16, etc.
+                  2   ExtraParamSize   if PCM, then doesn't exist
+                  X   ExtraParams      space for extra parameters
+
+        The "data" subchunk contains the size of the data and the actual sound:
+
+        36        4   Subchunk2ID      Contains the letters "data"
+                                       (0x64617461 big-endian form).
+        40        4   Subchunk2Size    == NumSamples * NumChannels * BitsPerSample/8
+                                       This is the number of bytes in the data.
+                                       You can also think of this as the size
+                                       of the read of the subchunk following this
+                                       number.
+        44        *   Data             The actual sound data.
 
-    unsigned char byteData;
-    //char *data = "data";
-    std::string data ("data");
-    int dataCount = 0, readBytes = 0;
+        SOURCE : http://soundfile.sapp.org/doc/WaveFormat/
 
-    while(std::cin>>std::noskipws>>byteData)
+        NOTE : I later found out that the subChunks may be located at different offsets
+               in presence of metadata like LIST INFO etc..
+
+               See : L#108
+
+     */
+
+    std::string format(fileData + 8, fileData + 12);
+
+    if(format != "WAVE")
     {
-        _fileData.push_back(byteData);
+        DEBUG << "Invalid WAV file format";
+        FATAL(InvalidFile) << "Invalid WAV file format : " << format;
+    }
 
-        readBytes++;
+    DEBUG << "File format is identified as WAV";
 
-        if(byteData == data[dataCount]) //probably 'data' subchunk
-        {
-            dataCount++;
+    /*
+     * Apparently, this is just not it. The `fmt ` and `data`  chunk may not necessarily be in continuation.
+     * There may occur inclusion of metadata. So, we'll need to find the location of these chunks.
+     * Walking the chunk headers (ID + size) locates them in place without scanning the audio itself.
+     */
 
-            if(dataCount == 4)  //definitely 'data' subchunk
-                return readBytes; //return end of 'data' subchunk ID
-        }
+    DEBUG << "Finding FMT and DATA subchunks";
 
-        else
+    std::size_t fmtIndex = 0, dataIndex = 0, chunkIndex = 12;
+    bool fmtFound = false, dataFound = false;
+
+    while (chunkIndex + 8 <= fileSize && !(fmtFound && dataFound))
+    {
+        std::string chunkID(fileData + chunkIndex, fileData + chunkIndex + 4);
+        unsigned long chunkSize = fourBytesToInt(fileData, fileSize, chunkIndex + 4);
+
+        if (chunkID == "fmt " && !fmtFound)
         {
-            dataCount = 0;
+            fmtIndex = chunkIndex;
+            fmtFound = true;
         }
 
-        if(readBytes > remainingBytes)
+        else if (chunkID == "data" && !dataFound)
         {
-            DEBUG << "SubChunk2 ('data') not found";
-            FATAL(InvalidFile) << "SubChunk2 ('data') not found!";
+            dataIndex = chunkIndex;
+            dataFound = true;
         }
+
+        chunkIndex += 8 + chunkSize + (chunkSize & 1);  //chunks are padded to even size
     }
-    FATAL(UnknownError) << "Error occurred while reading SubChunk2!";
-}
 
-int WaveFileData::getNumberOfSamples()
-{
-    unsigned char byteData;
-    int subChunk2Size = 0;
-    for(int i = 0; i < 4; i++)
+    if(!fmtFound)
+    {
+        DEBUG << "FMT subchunk not found!";
+        FATAL(InvalidFile) << "FMT subchunk not found!";
+    }
+
+    if(!dataFound)
+    {
+        DEBUG << "Data subchunk not found!";
+        FATAL(InvalidFile) << "Data subchunk not found!";
+    }
+
+    DEBUG << "FMT index : "<< fmtIndex <<" , DATA index : " << dataIndex;
+
+    unsigned long subChunk1Size = fourBytesToInt(fileData, fileSize, fmtIndex + 4);
+
+    if (subChunk1Size > fileSize - (fmtIndex + 8))
+    {
+        FATAL(InvalidFile) << "Incomplete FMT subchunk, SubChunk1Size : " << subChunk1Size;
+    }
+
+    WaveFormat waveFormat = parseFormatChunk(fileData + fmtIndex + 8, subChunk1Size);
+    int blockAlign = waveFormat.blockAlign;
+
+    unsigned long subChunk2Size = fourBytesToInt(fileData, fileSize, dataIndex + 4);
+    std::size_t samplesBegin = dataIndex + 8;   //dataIndex + 8 is usually 44 as per the specs
+
+    if (subChunk2Size > fileSize - samplesBegin)    //truncated files or streamed files with unknown size
+    {
+        DEBUG << "SubChunk2Size exceeds the file size, reading till the end of the file";
+        subChunk2Size = fileSize - samplesBegin;
+    }
+
+    std::size_t numSamples = subChunk2Size / blockAlign;
+
+    DEBUG << "Number of samples : " << numSamples;
+
+    if (!isTargetFormat(waveFormat))
+    {
+        DEBUG << "Converting samples to 16 bit PCM mono sampled at 16KHz";
+
+        AudioConverter converter(waveFormat);
+        const std::size_t framesPerBlock = WaveStreamReader::blockSize / blockAlign;
+
+        _samples.reserve(converter.expectedSamples(numSamples));
+
+        for (std::size_t frame = 0; frame < numSamples; frame += framesPerBlock)    //block by block, the input may be mapped
+            converter.convert(fileData + samplesBegin + frame * blockAlign, std::min(framesPerBlock, numSamples - frame), _samples);
+
+        converter.flush(_samples);
+
+        DEBUG << "Number of converted samples : " << _samples.size();
+    }
+
+    else if (isMapped && isLittleEndian() && samplesBegin % alignof(int16_t) == 0)
     {
-        std::cin>>std::noskipws>>byteData;
-        _fileData.push_back(byteData);
+        DEBUG << "Using samples in place from the mapped file";
 
-        subChunk2Size = subChunk2Size | byteData << (8 * i);
+        _mappedSamples = SampleView(reinterpret_cast<const int16_t *>(fileData + samplesBegin), numSamples);
+        _useMappedSamples = true;
     }
 
-    return subChunk2Size / 2; // in our case, wave file are 16 bit. So, 2 bytes = 1 sample. No. of Sample = size/2
+    else
+    {
+        DEBUG << "Reading samples";
+
+        _samples.resize(numSamples);
+        bytesToSamples(fileData + samplesBegin, numSamples, _samples.data());
+    }
+
+    DEBUG << "Successfully decoded";
+    return true;    //successfully decoded
 }
 
-bool WaveFileData::readSamplesFromStream(int numberOfSamples)
+bool WaveFileData::openFile ()
 {
-    DEBUG << "Reading and decoding samples from stream...";
+    DEBUG << "Trying to read from file : " << _fileName;
 
-    unsigned char byteData;
-    std::vector<unsigned char> twoBytes;
-    int two = 0, bytesRead = 0;
+    const unsigned char *fileData = nullptr;
+    std::size_t fileSize = 0;
+    bool isMapped = _mappedFile.open(_fileName);
 
-    while(std::cin>>std::noskipws>>byteData)
+    if (isMapped)
     {
-        _fileData.push_back(byteData);
+        DEBUG << "File mapped into memory";
 
-        two++; bytesRead++;
-        twoBytes.push_back(byteData);   //processing two bytes at a time
+        fileData = _mappedFile.data();
+        fileSize = _mappedFile.size();
+    }
+
+    else
+    {
+        DEBUG << "Unable to map file, reading file data into buffer";
 
-        if(two == 2)
+        std::ifstream infile (_fileName, std::ios::binary | std::ios::ate);
+
+        if (!infile)
         {
-            int16_t sample = twoBytesToInt(twoBytes, 0);    //16 bit PCM, 2 bytes = 1 sample
-            _samples.push_back(sample); //storing sample
-            DEBUG << "Storing sample";
-            twoBytes.clear();
-            two = 0;
+            FATAL(FileNotFound) << "Unable to open file : " << _fileName;
         }
 
-        if(bytesRead > numberOfSamples * 2)
+        std::streamsize size = infile.tellg();
+        infile.seekg(0, std::ios::beg);
+
+        _fileData.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+
+        if (size > 0 && !infile.read(reinterpret_cast<char *>(_fileData.data()), size))
         {
-            DEBUG << "\nLooks like number of bytes exceeds the expected amount! Still processing.";
+            FATAL(InvalidFile) << "Unable to read from file : " << _fileName;
         }
+
+        fileData = _fileData.data();
+        fileSize = _fileData.size();
     }
 
-    if(bytesRead < numberOfSamples * 2)
-    {
-		DEBUG << "\nReceived less number of samples than the expected amount! Still processing.";
+    if (_isRawFile) { // handle raw audio files
+        std::size_t numSamples = fileSize / 2; // size is in unit of byte, while one int_16 uses 2 bytes
+
+        if (isMapped && isLittleEndian())
+        {
+            _mappedSamples = SampleView(reinterpret_cast<const int16_t *>(fileData), numSamples);
+            _useMappedSamples = true;
+        }
+
+        else
+        {
+            _samples.resize(numSamples);
+            bytesToSamples(fileData, numSamples, _samples.data());
+
+            std::vector<unsigned char>().swap(_fileData);
+        }
+
+        DEBUG << "File data read";
+        DEBUG << "Decoding is skipped since it is raw audio file";
+        return true;
     }
 
-    DEBUG << "Samples read and decoded!";
+    DEBUG << "Processing data and extracting samples";
+
+    if(checkValidWave(fileData, fileSize))
+    {
+        DEBUG << "Wave File chunkID verification successful";
+
+        DEBUG << "Begin decoding wave file";
+
+        decode(fileData, fileSize, isMapped);
 
+        if (!isMapped)
+            std::vector<unsigned char>().swap(_fileData);   //samples are decoded, raw bytes are no longer needed
 
-    return -1;
+        DEBUG << "File decoded successfully";
+
+        return true;
+    }
 
+    else
+    {
+        DEBUG << "Invalid WAV file";
+        FATAL(InvalidFile) << "Invalid WAV file!";
+    }
+
+    return true;
 }
 
 bool WaveFileData::readStream()
 {
     DEBUG << "Reading WAV file from stream";
-    if (_isRawFile) {
-        DEBUG << "Raw audio mode is enabled. Turn to read stream using buffer...";
-        return readStreamUsingBuffer();
-    }
 
-    int remainingBytes = processStreamHeader();                 //processing wave header
-    remainingBytes -= seekToEndOfSubChunk1ID(remainingBytes);   //searching 'fmt' subchunk
-    remainingBytes -= validateSubChunk1(remainingBytes);        //processing 'fmt' subchunk
-    remainingBytes -= seekToEndOfSubChunk2ID(remainingBytes);   //searching 'data' subchunk
+    setStandardInputToBinary();
+    WaveStreamReader reader(std::cin, _isRawFile);
+
+    if (!_isRawFile)
+        reader.readHeader();    //processing wave header, stops at the beginning of samples
+
+    _samples.reserve(reader.expectedSamples());
+
+    DEBUG << "Reading and decoding samples from stream...";
 
-    int numberOfSamples = getNumberOfSamples();                 //getting number of samples
+    const std::size_t samplesPerBlock = WaveStreamReader::blockSize / 2;
+    std::size_t samplesRead;
 
-    if(remainingBytes != 2 * numberOfSamples)
+    do
     {
-        DEBUG << "\nLooks like there is some error in reading samples from the file. Still proceeding.";
-        DEBUG << "Potential error(s) in reading samples, still proceeding";
-    }
+        std::size_t oldSize = _samples.size();
+        _samples.resize(oldSize + samplesPerBlock);
 
-    return readSamplesFromStream(numberOfSamples);              //reading samples
+        samplesRead = reader.readSamples(_samples.data() + oldSize, samplesPerBlock);
+        _samples.resize(oldSize + samplesRead);
+    } while (samplesRead > 0);
 
+    DEBUG << "Samples read and decoded! Number of samples : " << _samples.size();
+
+    return true;
 }
 
 bool WaveFileData::readStreamUsingBuffer()
 {
-    if (_isRawFile) {
-        unsigned char byteData, byteData2;
-        while (std::cin >> std::noskipws >> byteData) {
-            std::cin >> std::noskipws >> byteData2;
-            _samples.push_back(((byteData2 << 8) | byteData));  //storing the stream into sample directly
-        }
-        return true;
-    }
+    setStandardInputToBinary();
+    WaveStreamReader reader(std::cin, _isRawFile);
 
-    unsigned char byteData;
+    reader.readBytes(_fileData);    //storing the stream into buffer
 
-    while(std::cin >> std::noskipws >> byteData)
+    if (_isRawFile)
     {
-        _fileData.push_back(byteData);  //storing the stream into buffer
+        _samples.resize(_fileData.size() / 2);
+        bytesToSamples(_fileData.data(), _samples.size(), _samples.data());
     }
 
-    if(checkValidWave(_fileData))   //checking if buffer has valid WAVE file data
+    else if(checkValidWave(_fileData.data(), _fileData.size()))   //checking if buffer has valid WAVE file data
     {
-        decode();   //decode the buffer
-        return true;
+        decode(_fileData.data(), _fileData.size(), false);   //decode the buffer
     }
 
     else
     {
-        FATAL(InvalidFile) << "Invalid WAV file: SubChunk2 ('data') not found!";
+        FATAL(InvalidFile) << "Invalid WAV file: Incorrect chunkID!";
     }
 
+    std::vector<unsigned char>().swap(_fileData);   //samples are decoded, raw bytes are no longer needed
     return true;
 
 }
@@ -633,31 +978,52 @@ bool WaveFileData::read()   //decided the function based on set mode
     return true;
 }
 
-/* Convert 4 bytes to int
- * Reference :
- * https://stackoverflow.com/a/2386134/6487831
- */
-
-unsigned long WaveFileData::fourBytesToInt (const std::vector<unsigned char>& fileData, int index)
+SampleView WaveFileData::getSamples() const noexcept
 {
-    // Process only if samples are within range
-    if(index+3 < fileData.size())
-        return ((fileData[index + 3] << 24) | (fileData[index + 2] << 16) | (fileData[index + 1] << 8) | fileData[index]);
+    if (_useMappedSamples)
+        return _mappedSamples;  //samples are located inside the mapped file
 
-    FATAL(InvalidFile) << "Tried accessing samples out of bounds.";
+    return SampleView(_samples.data(), _samples.size());
 }
 
-int WaveFileData::twoBytesToInt (const std::vector<unsigned char>& fileData, int index)
+SampleView WaveFileData::getSamples(long int firstSample, long int numberOfSamples)
 {
-    // Process only if samples are within range
-    if(index+1 < fileData.size())
-        return ((fileData[index + 1] << 8) | fileData[index]);
+    SampleView samples = getSamples();
 
-    // If file was damaged
-    FATAL(InvalidFile) << "Tried accessing samples out of bounds.";
+    if (firstSample < 0)    //window begins before the audio, trim the front
+    {
+        numberOfSamples += firstSample;
+        firstSample = 0;
+    }
+
+    if (numberOfSamples <= 0 || (std::size_t)firstSample >= samples.size())
+        return SampleView(nullptr, 0, firstSample);
+
+    std::size_t count = std::min<std::size_t>(numberOfSamples, samples.size() - firstSample);
+
+    return SampleView(samples.data() + firstSample, count, firstSample);
 }
 
-const std::vector<int16_t>& WaveFileData::getSamples() const noexcept
+SampleView SampleSource::getSamplesByTime(long int startTime, long int endTime, long int paddingSamples)
 {
-    return _samples;    //returning sample vector
+    /*
+     * 00:00:19,320 --> 00:00:21,056
+     * Why are you boring?
+     *
+     * startTime : 19320 ms, endTime : 21056 ms, paddingSamples : 8000
+     *
+     * firstSample       = 19320 ms * 16 samples/ms - 8000 = 301120
+     * numberOfSamples   = 1736  ms * 16 samples/ms + 2 * 8000 = 43776
+     *
+     */
+
+    long int firstSample = startTime * samplesPerMillisecond - paddingSamples;
+    long int numberOfSamples = (endTime - startTime) * samplesPerMillisecond + 2 * paddingSamples;
+
+    SampleView window = getSamples(firstSample, numberOfSamples);
+
+    if (window.firstSample() + window.size() <= (std::size_t)(startTime * samplesPerMillisecond))   //dialogue starts after the audio ends
+        return SampleView(nullptr, 0, startTime * samplesPerMillisecond);
+
+    return window;
 }
@@ -9,6 +9,7 @@
 
 #include "commons.h"
 #include "params.h"
+#include "audio_converter.h"
 
 enum openMode
 {
@@ -20,29 +21,124 @@ enum openMode
 
 int findIndex(std::vector<unsigned char>& fileData, const std::string& chunk); //returns the index of beginning of the "chunk" string
 
-class WaveFileData
+unsigned long fourBytesToInt (const unsigned char *fileData, std::size_t fileSize, std::size_t index); //convert 4 little endian bytes into unsigned long int
+int twoBytesToInt (const unsigned char *fileData, std::size_t fileSize, std::size_t index);            //convert 2 little endian bytes into integer
+void bytesToSamples (const unsigned char *bytes, std::size_t numberOfSamples, int16_t *samples);        //bulk convert little endian 16 bit PCM
+
+WaveFormat parseFormatChunk(const unsigned char *chunkData, std::size_t chunkSize); //parse and validate 'fmt ' chunk body (PCM 8/16/24/32 bit or float, any rate and channels)
+
+const long int samplesPerMillisecond = 16;   //audio is always processed at 16KHz
+
+class SampleView    //non-owning, read-only view over 16 bit PCM samples
+{
+    const int16_t * _data;
+    std::size_t _size;
+    std::size_t _firstSample;   //position of the first sample w.r.t. the beginning of the audio
+
+public:
+    SampleView(const int16_t *data = nullptr, std::size_t size = 0, std::size_t firstSample = 0) noexcept;
+
+    const int16_t * data() const noexcept { return _data; }
+    std::size_t size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    std::size_t firstSample() const noexcept { return _firstSample; }
+    long int startTime() const noexcept { return (long int)(_firstSample / samplesPerMillisecond); }   //in ms
+    long int endTime() const noexcept { return (long int)((_firstSample + _size) / samplesPerMillisecond); }
+    const int16_t * begin() const noexcept { return _data; }
+    const int16_t * end() const noexcept { return _data + _size; }
+    int16_t operator[](std::size_t index) const noexcept { return _data[index]; }
+};
+
+class SampleSource  //anything which serves 16KHz mono samples by their position in the audio
+{
+public:
+    virtual SampleView getSamples(long int firstSample, long int numberOfSamples) = 0;    //window clamped to the audio, empty if it lies beyond
+    SampleView getSamplesByTime(long int startTime, long int endTime, long int paddingSamples = 0);  //window [startTime, endTime) ms, widened by paddingSamples on both sides
+    virtual ~SampleSource() = default;
+};
+
+void setStandardInputToBinary() noexcept;   //no newline translation while piping audio
+
+class MappedFile    //read-only memory mapping of a file located on disk
+{
+    const unsigned char * _data;
+    std::size_t _size;
+#ifdef WIN32
+    void * _fileHandle, * _mappingHandle;  //HANDLEs, kept opaque to avoid pulling windows.h into the header
+#else
+    int _fileDescriptor;
+#endif
+
+public:
+    MappedFile() noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& fileName); //map complete file, returns false if the file could not be mapped
+    void close() noexcept;                  //unmap the file, if mapped
+
+    bool isOpen() const noexcept { return _data != nullptr; }
+    const unsigned char * data() const noexcept { return _data; }
+    std::size_t size() const noexcept { return _size; }
+
+    ~MappedFile();
+};
+
+class WaveStreamReader  //block oriented reader for wave or raw audio arriving through a stream or pipe
+{
+    enum readerState
+    {
+        readingRiffHeader,      //expecting 'RIFF' <size> 'WAVE'
+        readingChunkHeader,     //expecting <chunk ID> <chunk size>
+        readingFormatChunk,     //buffering the 'fmt ' chunk body
+        skippingChunk,          //discarding a chunk we are not interested in (LIST, fact, ...)
+        readingSamples,         //inside 'data' chunk
+        finished
+    };
+
+    std::istream& _stream;
+    std::vector<unsigned char> _buffer;     //block buffer, [_bufferBegin, _bufferEnd) is yet to be consumed
+    std::size_t _bufferBegin, _bufferEnd;
+    readerState _state;
+    bool _formatFound;
+    unsigned long _chunkRemaining;          //bytes left in the chunk currently being processed
+    bool _dataSizeKnown;                    //false for streamed wave files which carry placeholder sizes
+    WaveFormat _format;
+    std::unique_ptr<AudioConverter> _converter; //set if the stream is not 16KHz, mono, 16 bit
+    std::vector<int16_t> _converted;        //converted samples, [_convertedBegin, end) is yet to be handed out
+    std::size_t _convertedBegin;
+    bool _converterFlushed;
+
+    std::size_t buffered() const noexcept { return _bufferEnd - _bufferBegin; }
+    bool require(std::size_t numberOfBytes);  //make sure that many bytes are buffered, false on end of stream
+    std::size_t readBlock(unsigned char *destination, std::size_t numberOfBytes);   //single large read from the stream
+    std::size_t readConvertedSamples(int16_t *samples, std::size_t maxSamples);     //readSamples() for streams needing conversion
+
+public:
+    static const std::size_t blockSize = 1 << 16;
+
+    WaveStreamReader(std::istream& stream, bool isRawStream = false);
+
+    bool readHeader();                                              //advance the state machine till the beginning of samples
+    std::size_t readSamples(int16_t *samples, std::size_t maxSamples);  //decode up to maxSamples (16KHz mono), returns 0 at end of stream
+    std::size_t readBytes(std::vector<unsigned char>& bytes);       //append everything left in the stream, undecoded
+    std::size_t expectedSamples() const noexcept;                   //number of samples announced by the header, 0 if unknown
+};
+
+class WaveFileData : public SampleSource
 {
     std::string _fileName;                  //name/path of the wave file
     std::vector<unsigned char> _fileData;   //content of the wave file
-    std::vector<int16_t> _samples;          //the raw samples containing audio data : PCM, 16 bit, Sampled at 16Khz, mono
+    std::vector<int16_t> _samples;          //the raw samples containing audio data : PCM, 16 bit, Sampled at 16Khz, mono (converted if required)
+    MappedFile _mappedFile;                 //mapping of the wave file when reading from disk
+    SampleView _mappedSamples;              //samples located inside the mapping, valid only if _useMappedSamples
+    bool _useMappedSamples;                 //if the samples are served directly from the mapping
     openMode _openMode;                     //mode of reading file
     bool _isRawFile;                        //if the audio is raw audio file
 
     //when reading from file or buffer
-    bool checkValidWave (const std::vector<unsigned char>& fileData); //check if wave file is valid by reading the RIFF header
-    bool decode();  //decode the wave file and fill the _sample vector
-
-    //when reading from stream or pipe
-    int processStreamHeader();                      //check if stream is valid wave stream
-    int seekToEndOfSubChunk1ID(int remainingBytes); //reach till the end of 'fmt' Chunk ID + skip 1 byte (empty byte)
-    int validateSubChunk1(int remainingBytes);      //check the 'fmt' chunk for required wave file config (16 bit, 16KHz, mono, PCM)
-    int seekToEndOfSubChunk2ID(int remainingBytes); //reach till the end of 'data' Chunk ID
-    int getNumberOfSamples();                       //basically gets size of 'data' Chunk which contains size of samples
-    bool readSamplesFromStream(int numberOfSamples);//read the sample from stream and insert in the _sample vector
-
-    unsigned long fourBytesToInt (const std::vector<unsigned char>& fileData, int index); //convert 4 bytes into unsigned long int
-    int twoBytesToInt (const std::vector<unsigned char>& fileData, int index);            //convert 2 bytes into signed integer
-    double twoBytesToDouble (int sample);                                           //convert 2 bytes to double; not required rn
+    bool checkValidWave (const unsigned char *fileData, std::size_t fileSize); //check if wave file is valid by reading the RIFF header
+    bool decode(const unsigned char *fileData, std::size_t fileSize, bool isMapped);  //parse RIFF chunks in place, expose or copy the 'data' chunk
 
 public:
     WaveFileData(std::string fileName, bool isRawFile = false) noexcept;                    //initialize wave file for file on disk mode; pass file name
@@ -53,7 +149,8 @@ public:
     bool readStreamUsingBuffer();   //first store stream into buffer, then process
     bool read();                    //the main function which decides the open method using set mode
 
-    const std::vector<int16_t>& getSamples() const noexcept;  //returns the sample vector; time based coming soon
+    SampleView getSamples() const noexcept;  //returns view over all the samples, valid as long as this object lives
+    SampleView getSamples(long int firstSample, long int numberOfSamples) override;
 };
 
 #endif //CCALIGNER_READ_WAV_FILE_H
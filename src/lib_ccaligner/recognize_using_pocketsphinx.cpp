@@ -6,8 +6,59 @@
 
 #include "recognize_using_pocketsphinx.h"
 
-PocketsphinxAligner::PocketsphinxAligner(Params* parameters) noexcept
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+AcousticModel::AcousticModel(const std::string& modelPath, const std::string& logPath) : _decoder(nullptr)
+{
+    DEBUG << "Loading acoustic model " << modelPath << " to share";
+
+    _config = cmd_ln_init(nullptr, ps_args(), TRUE, "-hmm", modelPath.c_str(), "-logfn", logPath.c_str(), nullptr);
+
+    if (_config == nullptr) {
+        FATAL(UnknownError) << "Failed to create config object, see log for details";
+    }
+
+    //each aligner reads or generates a dictionary of its own and adds words to it, only the model is lent
+    {
+        std::lock_guard<std::mutex> lock(frontEndCreation());
+        _decoder = ps_init_model(_config);
+    }
+
+    if (_decoder == nullptr) {
+        cmd_ln_free_r(_config);
+        FATAL(UnknownError) << "Failed to load acoustic model " << modelPath << ", see log for details";
+    }
+}
+
+ps_decoder_t *AcousticModel::share(cmd_ln_t *config, ps_decoder_t *decoder)
+{
+    std::lock_guard<std::mutex> lock(_mutex), creating(frontEndCreation());
+    return ps_init_shared(config, decoder == nullptr ? _decoder : decoder);
+}
+
+void AcousticModel::release(ps_decoder_t *decoder)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    ps_free(decoder);
+}
+
+AcousticModel::~AcousticModel()
+{
+    ps_free(_decoder);
+    cmd_ln_free_r(_config);
+}
+
+PocketsphinxAligner::PocketsphinxAligner(Params* parameters, AcousticModel *model, const std::atomic<bool> *cancelled)
     : _parameters(parameters),
+    _model(model),
+    _cancelled(cancelled),
 
     //creating local copies
     _audioFileName(parameters->audioFileName),
@@ -29,7 +80,12 @@ PocketsphinxAligner::PocketsphinxAligner(Params* parameters) noexcept
 
     //processing subtitles file
     _subParserFactory(_subtitleFileName),
-    _parser(_subParserFactory.getParser())
+    _parser(parameters->liveAlign ? nullptr : _subParserFactory.getParser()),     //live captions are read as they arrive
+    _audio(nullptr),
+    _psWordDecoder(nullptr),
+    _psPhonemeDecoder(nullptr),
+    _configWord(nullptr),
+    _configPhoneme(nullptr)
     //_subtitles(_parser->getSubtitles())
 {
     DEBUG << "Initialising Aligner using PocketSphinx";
@@ -37,11 +93,43 @@ PocketsphinxAligner::PocketsphinxAligner(Params* parameters) noexcept
     if (_parameters->usingTranscript) {
         DEBUG << "Audio Filename: " << _audioFileName << " Transcript filename: " << _transcriptFileName;
     }
+    else if (_parameters->liveAlign) {
+        DEBUG << "Audio Filename: " << _audioFileName << " Caption stream: " << _subtitleFileName;
+    }
     else {
         _subtitles = _parser->getSubtitles();
         DEBUG << "Audio Filename: " << _audioFileName << " Subtitle filename: " << _subtitleFileName;
     }
 
+    if (parameters->streamAudio) {
+        INFO << "Streaming audio samples...";
+
+        //subtitles are walked in order of time, so that only the audio around the current one is required
+        std::stable_sort(_subtitles.begin(), _subtitles.end(), [](SubtitleItem *a, SubtitleItem *b) {
+            return a->getStartTime() < b->getStartTime();
+        });
+
+        long int longestDialogue = 0;
+
+        for (SubtitleItem *sub : _subtitles)
+            longestDialogue = std::max(longestDialogue, sub->getEndTime() - sub->getStartTime());
+
+        //twice the largest window, so that overlapping subtitles still find their audio; at least 10 seconds
+        std::size_t capacity = 2 * (longestDialogue * samplesPerMillisecond + 2 * recognitionWindow());
+        capacity = std::max<std::size_t>(capacity, 10000 * samplesPerMillisecond);
+
+        if (parameters->liveAlign)      //captions may arrive late, their audio is kept for as long as asked
+            capacity = parameters->history * samplesPerMillisecond;
+
+        if (parameters->readStream)
+            _stream = decltype(_stream)(new SampleStream(std::cin, parameters->audioIsRaw, capacity));
+        else
+            _stream = decltype(_stream)(new SampleStream(_audioFileName, parameters->audioIsRaw, capacity));
+
+        _audio = _stream.get();
+        return;
+    }
+
     INFO << "Reading and decoding audio samples...";
 
     if (parameters->readStream)
@@ -50,7 +138,7 @@ PocketsphinxAligner::PocketsphinxAligner(Params* parameters) noexcept
         _file = decltype(_file)(new WaveFileData(_audioFileName, parameters->audioIsRaw));
 
     _file->read();
-    _samples = _file->getSamples();
+    _audio = _file.get();
 }
 
 bool PocketsphinxAligner::generateGrammar(grammarName name) {
@@ -62,14 +150,116 @@ bool PocketsphinxAligner::generateGrammar(grammarName name) {
         INFO << "Note: You have chosen to generate a dictionary. Based on your TensorFlow configuration,";
         INFO << "this may take some time, please be patient. For alternatives, see docs.";
     }
+    //files are only written on request, or when a single part is generated to be reused by later runs
+    bool writeFiles = _parameters->dumpGrammar || !(name == complete_grammar || name == quick_dict || name == quick_lm);
+    _grammar = decltype(_grammar)(new Grammar());
+    _grammar->lexiconPath = _parameters->lexiconPath;
+    _grammar->pronunciationCachePath = _parameters->pronunciationCachePath;
+    _grammar->workspace = Workspace(_parameters->workspacePath);
+
     bool ret;
     if (!_parameters->usingTranscript)
-        ret = generate(_subtitles, name);
+        ret = generate(_subtitles, *_grammar, name, writeFiles);
     else
-        ret = generate(_transcriptFileName, name);
+        ret = generate(_transcriptFileName, *_grammar, name, writeFiles);
     return ret;
 }
 
+bool PocketsphinxAligner::usesGenerated(grammarName part, const std::string& path) const {
+    return _grammar && _grammar->has(part) && path == (part == dict ? _grammar->workspace.dictPath() : part == lm ? _grammar->workspace.lmPath() : _grammar->workspace.phoneticLmPath());
+}
+
+bool PocketsphinxAligner::addGeneratedWords(ps_decoder_t *ps) {
+    if (!usesGenerated(dict, _dictPath))
+        return false;
+
+    for (const auto& entry : _grammar->dictionary) {
+        //searches read from disk are updated once, with the last word
+        if (ps_add_word(ps, entry.first.c_str(), entry.second.c_str(), &entry == &_grammar->dictionary.back()) < 0)
+            WARNING << "Unable to add " << entry.first << " to the dictionary, see log for details";
+    }
+
+    return true;
+}
+
+bool PocketsphinxAligner::prunesDictionary() const {
+    return _parameters->pruneDict && !_parameters->liveAlign && !_dictPath.empty() && !usesGenerated(dict, _dictPath);
+}
+
+std::vector<std::string> PocketsphinxAligner::vocabulary() const {
+    std::vector<std::string> words;
+
+    if (!_parameters->usingTranscript) {
+        for (SubtitleItem *sub : _subtitles) {
+            std::vector<std::string> dialogue = sub->getIndividualWords();
+            words.insert(words.end(), dialogue.begin(), dialogue.end());
+        }
+    }
+
+    else {
+        std::istringstream transcript(getFileData(_transcriptFileName));
+        words.assign(std::istream_iterator<std::string>(transcript), std::istream_iterator<std::string>());
+    }
+
+    //as written, and as in the generated grammar
+    std::size_t numberOfWords = words.size();
+
+    for (std::size_t i = 0; i < numberOfWords; i++)
+        words.push_back(stringToLower(words[i]));
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+bool PocketsphinxAligner::loadPrunedDictionary(ps_decoder_t *ps) {
+    if (!prunesDictionary())
+        return false;
+
+    std::vector<std::string> words = vocabulary();
+    std::vector<const char *> keep;
+
+    for (const std::string& word : words)
+        keep.push_back(word.c_str());
+
+    keep.push_back(nullptr);
+
+    if (ps_load_dict_words(ps, _dictPath.c_str(), nullptr, keep.data()) < 0) {
+        FATAL(UnknownError) << "Failed to read the words of the subtitles from " << _dictPath << ", see log for details";
+    }
+
+    DEBUG << "Read " << words.size() << " words of the subtitles from " << _dictPath;
+    return true;
+}
+
+bool PocketsphinxAligner::setLanguageModel(ps_decoder_t *ps) {
+    if (!usesGenerated(lm, _lmPath))
+        return false;
+
+    ngram_model_t *model = _grammar->words.model(_configWord, ps_get_logmath(ps));
+
+    if (model == nullptr || ps_set_lm(ps, PS_DEFAULT_SEARCH, model) < 0 || ps_set_search(ps, PS_DEFAULT_SEARCH) < 0) {
+        FATAL(UnknownError) << "Failed to use the generated language model, see log for details";
+    }
+
+    ngram_model_free(model);    //each decoder has its own, scoring caches the last history
+    return true;
+}
+
+bool PocketsphinxAligner::setPhoneticLanguageModel(ps_decoder_t *ps) {
+    if (!usesGenerated(phone_lm, _phoneticLmPath))
+        return false;
+
+    ngram_model_t *model = _grammar->phones.model(_configPhoneme, ps_get_logmath(ps));
+
+    if (model == nullptr || ps_set_allphone(ps, PS_DEFAULT_SEARCH, model) < 0 || ps_set_search(ps, PS_DEFAULT_SEARCH) < 0) {
+        FATAL(UnknownError) << "Failed to use the generated phonetic language model, see log for details";
+    }
+
+    ngram_model_free(model);
+    return true;
+}
+
 bool PocketsphinxAligner::initDecoder(const std::string& modelPath, const std::string& lmPath, const std::string& dictPath, const std::string& fsgPath, const std::string& logPath) {
     DEBUG << "Initialising PocketSphinx decoder";
 
@@ -142,12 +332,28 @@ bool PocketsphinxAligner::initDecoder(const std::string& modelPath, const std::s
         FATAL(UnknownError) << "Failed to create config object, see log for details";
     }
 
-    _psWordDecoder = ps_init(_configWord);
+    //decoders sharing a model log where it does, opening another log would close it under those of other aligners
+    if (_model != nullptr)
+        cmd_ln_set_str_r(_configWord, "-logfn", nullptr);
+
+    //grammar generated in this run is already in memory, don't read it back
+    if (usesGenerated(lm, _lmPath))
+        cmd_ln_set_str_r(_configWord, "-lm", nullptr);
+
+    //the words of the subtitles are read from the dictionary once the decoder exists
+    if (usesGenerated(dict, _dictPath) || prunesDictionary())
+        cmd_ln_set_str_r(_configWord, "-dict", nullptr);
+
+    _psWordDecoder = initSharedDecoder(_configWord, nullptr);
 
     if (_psWordDecoder == nullptr) {
         FATAL(UnknownError) << "Failed to create recognizer, see log for details";
     }
 
+    loadPrunedDictionary(_psWordDecoder);
+    addGeneratedWords(_psWordDecoder);
+    setLanguageModel(_psWordDecoder);
+
     if (_parameters->searchPhonemes) {
         initPhonemeDecoder(_parameters->phoneticLmPath, _parameters->phonemeLogPath);
     }
@@ -181,43 +387,29 @@ bool PocketsphinxAligner::initPhonemeDecoder(const std::string& phoneticLmPath,
         FATAL(UnknownError) << "Failed to create config object, see log for details";
     }
 
-    _psPhonemeDecoder = ps_init(_configPhoneme);
+    //without -allphone the phoneme decoder would search with the word language model instead
+    if (usesGenerated(phone_lm, _phoneticLmPath))
+        cmd_ln_set_str_r(_configPhoneme, "-allphone", nullptr);
 
-    if (_psPhonemeDecoder == nullptr) {
-        FATAL(UnknownError) << "Failed to create phoneme recognizer, see log for details";
-    }
-
-    return true;
-
-}
+    if (usesGenerated(phone_lm, _phoneticLmPath) || usesGenerated(lm, _lmPath))
+        cmd_ln_set_str_r(_configPhoneme, "-lm", nullptr);
 
-int levenshtein_distance(const std::string &firstWord, const std::string &secondWord) {
-    const unsigned long int length1 = firstWord.size();
-    const unsigned long int length2 = secondWord.size();
+    if (_model != nullptr)
+        cmd_ln_set_str_r(_configPhoneme, "-logfn", nullptr);
 
-    std::vector<int> currentColumn(length2 + 1);
-    std::vector<int> previousColumn(length2 + 1);
+    _psPhonemeDecoder = initSharedDecoder(_configPhoneme, _psWordDecoder);  //same acoustic model, loaded once
 
-    for (int index2 = 0; index2 < length2 + 1; ++index2) {
-        previousColumn[index2] = index2;
+    if (_psPhonemeDecoder == nullptr) {
+        FATAL(UnknownError) << "Failed to create phoneme recognizer, see log for details";
     }
 
-    for (int index1 = 0; index1 < length1; ++index1) {
-        currentColumn[0] = index1 + 1;
+    setPhoneticLanguageModel(_psPhonemeDecoder);
 
-        for (int index2 = 0; index2 < length2; ++index2) {
-            const int compare = firstWord[index1] == secondWord[index2] ? 0 : 1;
-
-            currentColumn[index2 + 1] = std::min(std::min(currentColumn[index2] + 1, previousColumn[index2 + 1] + 1), previousColumn[index2] + compare);
-        }
-
-        currentColumn.swap(previousColumn);
-    }
+    return true;
 
-    return previousColumn[length2];
 }
 
-bool PocketsphinxAligner::findAndSetPhonemeTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub) {
+bool PocketsphinxAligner::findAndSetPhonemeTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub, long int utteranceStartsAt) {
     ps_start_stream(ps);
     int frame_rate = cmd_ln_int32_r(config, "-frate");
     ps_seg_t *iter = ps_seg_iter(ps);
@@ -234,7 +426,7 @@ bool PocketsphinxAligner::findAndSetPhonemeTimes(cmd_ln_t *config, ps_decoder_t
 
         std::string recognisedPhoneme(ps_seg_word(iter));
         //the time when utterance was marked, the times are w.r.t. to this
-        long int startTime = sub->getStartTime();
+        long int startTime = utteranceStartsAt;
         long int endTime = startTime;
 
         if (recognisedPhoneme == "SIL" || recognisedPhoneme == "BREATH" || recognisedPhoneme == "SMACK" || recognisedPhoneme == "NOISE" || recognisedPhoneme[0] == '+' || recognisedPhoneme[0] == '[')
@@ -258,7 +450,7 @@ bool PocketsphinxAligner::findAndSetPhonemeTimes(cmd_ln_t *config, ps_decoder_t
     return true;
 }
 
-recognisedBlock PocketsphinxAligner::findAndSetWordTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub) {
+recognisedBlock PocketsphinxAligner::findAndSetWordTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub, long int utteranceStartsAt, std::ostream& display) {
     ps_start_stream(ps);
     int frame_rate = cmd_ln_int32_r(config, "-frate");
     ps_seg_t *iter = ps_seg_iter(ps);
@@ -271,22 +463,15 @@ recognisedBlock PocketsphinxAligner::findAndSetWordTimes(cmd_ln_t *config, ps_de
         std::transform(eachWord.begin(), eachWord.end(), eachWord.begin(), ::tolower);
     }
 
-    int lastWordFoundAtIndex = -1;
-
     recognisedBlock currentBlock; //storing recognised words and their timing information
 
     while (iter != nullptr) {
-        int32 sf, ef, pprob;
-        float conf;
+        int32 sf, ef;
 
         ps_seg_frames(iter, &sf, &ef);
-        pprob = ps_seg_prob(iter, nullptr, nullptr, nullptr);
-        conf = logmath_exp(ps_get_logmath(ps), pprob);
-
-        std::string recognisedWord(ps_seg_word(iter));
 
         //the time when utterance was marked, the times are w.r.t. to this
-        long int startTime = sub->getStartTime();
+        long int startTime = utteranceStartsAt;
         long int endTime = startTime;
 
         /*
@@ -303,75 +488,131 @@ recognisedBlock PocketsphinxAligner::findAndSetWordTimes(cmd_ln_t *config, ps_de
             FATAL(InvalidParameters) << "Error setting start and end time.";
 
         //storing recognised words and their timing information
-        currentBlock.recognisedString.push_back(recognisedWord);
+        currentBlock.recognisedString.push_back(ps_seg_word(iter));
         currentBlock.recognisedWordStartTimes.push_back(startTime);
         currentBlock.recognisedWordEndTimes.push_back(endTime);
 
+        iter = ps_seg_next(iter);
+    }
 
-        /*
-        * Suppose this is the case :
-        *
-        * Actual      : [Why] would you use a tomato just why
-        * Recognised: would you use a tomato just [why]
-        *
-        * So, if we search whole recognised sentence for actual words one by one, then Why[1] of Actual will get associated
-        * with why[7] of recognised. Thus limiting the number of words it can look ahead.
-        *
-        */
+    /*
+    * Suppose this is the case :
+    *
+    * Actual      : [Why] would you use a tomato just why
+    * Recognised: would you use a tomato just [why]
+    *
+    * So, if we search whole recognised sentence for actual words, then Why[1] of Actual may get associated
+    * with why[7] of recognised. Thus limiting the number of words it can look ahead, and aligning the two
+    * sequences as a whole instead of taking the first close word, so that a misrecognised word can not
+    * pull the later ones out of place.
+    *
+    */
+
+    std::vector<int> matches = matchWords(words, currentBlock.recognisedString, _searchWindow);
+
+    for (std::size_t i = 0; i < matches.size(); i++) {
+        int wordIndex = matches[i];
+
+        if (wordIndex < 0)
+            continue;
 
-        int searchWindowSize = _searchWindow;
+        sub->setWordRecognisedStatusByIndex(true, wordIndex);
+        sub->setWordTimesByIndex(currentBlock.recognisedWordStartTimes[i], currentBlock.recognisedWordEndTimes[i], wordIndex);
 
-        /*
-        Recognised: so have you can you've brought seven
-        |
-        ---------------
-        |               |
-        Actual      : I think you've brought with you
-
-        Recognised  : so have you can you've brought seven
-        |
-        -------------------
-        |                  |
-        Actual      : I think you've brought with you
+        if (_parameters->displayRecognised) {
+            display << "Possible Match : " << words[wordIndex];
+            display << "\t\tStart : \t\t" << sub->getWordStartTimeByIndex(wordIndex);
+            display << "\tEnd : \t\t" << sub->getWordEndTimeByIndex(wordIndex);
+            display << "\tDuration : \t\t" << sub->getWordEndTimeByIndex(wordIndex) - sub->getWordStartTimeByIndex(wordIndex);
+            display << "\n";
+        }
+    }
 
-        */
+    return currentBlock;
+}
 
-        //Do not try to search silence and words like [BREATH] et cetera..
-        if (recognisedWord == "<s>" || recognisedWord == "</s>" || recognisedWord[0] == '[' || recognisedWord == "<sil>")
-            goto skipSearchingThisWord;
+std::vector<LatticeWord> readLattice(ps_decoder_t *ps, cmd_ln_t *config, long int utteranceStartsAt) {
+    std::vector<LatticeWord> latticeWords;
 
-        for (int wordIndex = lastWordFoundAtIndex + 1; wordIndex < words.size(); wordIndex++) {
-            if (wordIndex >(int) currentBlock.recognisedString.size() + searchWindowSize)
-                break;
+    //posteriors of its links are computed by the best path search, along with the segmentation
+    ps_lattice_t *dag = ps_get_lattice(ps);
 
-            int distance = levenshtein_distance(words[wordIndex], recognisedWord);
-            int largerLength = words[wordIndex].size() > recognisedWord.size() ? words[wordIndex].size() : recognisedWord.size();
+    if (dag == nullptr)
+        return latticeWords;
 
-            if (distance < largerLength * 0.25)   //at least 75% must match
-            {
+    int frame_rate = cmd_ln_int32_r(config, "-frate");
+    logmath_t *lmath = ps_lattice_get_logmath(dag);
 
-                lastWordFoundAtIndex = wordIndex;
-                sub->setWordRecognisedStatusByIndex(true, wordIndex);
-                sub->setWordTimesByIndex(startTime, endTime, wordIndex);
+    for (ps_latnode_iter_t *itor = ps_latnode_iter(dag); itor != nullptr; itor = ps_latnode_iter_next(itor)) {
+        ps_latnode_t *node = ps_latnode_iter_node(itor);
+        ps_latlink_t *link = nullptr;
+        int32 posterior = ps_latnode_prob(dag, node, &link);   //of its most probable exit, which gives the end
 
-                if (_parameters->displayRecognised) {
-                    std::cout << "Possible Match : " << words[wordIndex];
-                    std::cout << "\t\tStart : \t\t" << sub->getWordStartTimeByIndex(wordIndex);
-                    std::cout << "\tEnd : \t\t" << sub->getWordEndTimeByIndex(wordIndex);
-                    std::cout << "\tDuration : \t\t" << sub->getWordEndTimeByIndex(wordIndex) - sub->getWordStartTimeByIndex(wordIndex);
-                    std::cout << "\n";
-                }
+        if (link == nullptr)    //unreachable, or the end of the lattice
+            continue;
 
+        long int startTime = utteranceStartsAt + ps_latnode_times(node, nullptr, nullptr) * 1000 / frame_rate;
+        long int endTime = utteranceStartsAt + ps_latlink_times(link, nullptr) * 1000 / frame_rate;
+
+        latticeWords.push_back({ps_latnode_baseword(dag, node), startTime, endTime, logmath_exp(lmath, posterior)});
+    }
+
+    return latticeWords;
+}
+
+int PocketsphinxAligner::findWordTimesInLattice(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub, long int utteranceStartsAt, std::ostream& display) {
+    std::vector<LatticeWord> latticeWords = readLattice(ps, config, utteranceStartsAt);
+
+    std::vector<std::string> words = sub->getIndividualWords();
+    long int lowerBound = utteranceStartsAt;
+    int found = 0;
+
+    for (int wordIndex = 0; wordIndex < (int) words.size(); wordIndex++) {
+        if (sub->getWordRecognisedStatusByIndex(wordIndex)) {
+            lowerBound = sub->getWordEndTimeByIndex(wordIndex);
+            continue;
+        }
+
+        //starting between its neighbours in the best hypothesis, so the order of words is kept
+        long int upperBound = LONG_MAX;
+
+        for (int next = wordIndex + 1; next < (int) words.size(); next++) {
+            if (sub->getWordRecognisedStatusByIndex(next)) {
+                upperBound = sub->getWordStartTimeByIndex(next);
                 break;
             }
+        }
 
+        std::string word = stringToLower(words[wordIndex]);
+        const LatticeWord *best = nullptr;
+
+        for (const LatticeWord &candidate : latticeWords) {
+            if (candidate.word == word && candidate.startTime >= lowerBound && candidate.startTime < upperBound && candidate.posterior > 0
+                && (best == nullptr || candidate.posterior > best->posterior))
+                best = &candidate;
         }
 
-    skipSearchingThisWord:
-        iter = ps_seg_next(iter);
+        if (best == nullptr)
+            continue;
+
+        //alternatives of a word often overlap the words the best hypothesis has around it
+        long int endTime = std::min(best->endTime, upperBound);
+
+        sub->setWordRecognisedStatusByIndex(true, wordIndex);
+        sub->setWordTimesByIndex(best->startTime, endTime, wordIndex);
+        lowerBound = endTime;
+        found++;
+
+        if (_parameters->displayRecognised) {
+            display << "Lattice Match  : " << words[wordIndex];
+            display << "\t\tStart : \t\t" << best->startTime;
+            display << "\tEnd : \t\t" << endTime;
+            display << "\tPosterior : \t" << best->posterior;
+            display << "\n";
+        }
     }
 
-    return currentBlock;
+    return found;
 }
 
 bool PocketsphinxAligner::printWordTimes(cmd_ln_t *config, ps_decoder_t *ps) {
@@ -393,128 +634,421 @@ bool PocketsphinxAligner::printWordTimes(cmd_ln_t *config, ps_decoder_t *ps) {
     return true;
 }
 
-bool PocketsphinxAligner::recognise() {
-    int subCount = 1;
-    bool useApproxTimeOnly = false;
-    initFile(_outputFileName, _parameters->outputFormat);
+long int PocketsphinxAligner::recognitionWindow() const noexcept {
+    if (_audioWindow)
+        return _audioWindow * samplesPerMillisecond;
+
+    return _sampleWindow;
+}
 
-    long int recognitionWindow = 0;
+bool PocketsphinxAligner::prepareFeatures() {
+    //front end parameters are known only once the decoder has read feat.params of the model
+    bool useCache = !_parameters->featureCachePath.empty();
+    _features = decltype(_features)(new FeatureStore());
 
-    if (_audioWindow) {
-        recognitionWindow = _audioWindow * 16;
+    if (useCache && _file) {    //streamed audio can not be hashed without reading it, so it is only stored
+        uint64_t key = FeatureStore::cacheKey(_file->getSamples(), _configWord);
+        std::string cacheFileName = FeatureStore::cacheFileName(_parameters->featureCachePath, key);
+
+        if (_features->load(cacheFileName, key, _configWord)) {
+            INFO << "Using cached features : " << cacheFileName;
+
+            if (_parameters->trimSilence)
+                _speech = detectSpeech(_file->getSamples(), vadOptions());
+
+            return true;
+        }
     }
 
-    else if (_sampleWindow) {
-        recognitionWindow = _sampleWindow;
+    INFO << "Extracting features...";
+
+    if (_parameters->trimSilence) {     //found in the same pass, streamed audio can not be read twice
+        SpeechTracker tracker(*_audio, vadOptions());
+        _features->compute(tracker, _configWord);
+        _speech = tracker.finish();
     }
 
-    INFO << "Recognising and aligning..";
+    else {
+        _features->compute(*_audio, _configWord);
+    }
 
-    for (SubtitleItem *sub : _subtitles) {
-        if (sub->getDialogue().empty())
-            continue;
+    if (useCache)
+        _features->save(FeatureStore::cacheFileName(_parameters->featureCachePath, _features->key()));
+
+    return true;
+}
 
+VadOptions PocketsphinxAligner::vadOptions() const noexcept {
+    VadOptions options;
+    options.aggressiveness = _parameters->vadAggressiveness;
+    return options;
+}
 
-        //first assigning approx timestamps
-        CurrentSub currSub(sub);
-        currSub.run();
+SampleView PocketsphinxAligner::trimToSpeech(const SampleView& window) const {
+    long int first = window.firstSample(), end = first + window.size();
+    SpeechSegment speech = speechWithin(detectSpeech(window, vadOptions()), first, end);
 
-        //let's correct the timestamps :)
+    if (speech.numberOfSamples == 0)    //rather all of it than nothing, the dialogue may be spoken over music
+        return window;
 
-        long int dialogueStartsAt = sub->getStartTime();
-        long int dialogueLastsFor = (sub->getEndTime() - dialogueStartsAt);
+    return SampleView(window.data() + (speech.firstSample - first), speech.numberOfSamples, speech.firstSample);
+}
 
-        long int samplesAlreadyRead = dialogueStartsAt * 16;
-        long int samplesToBeRead = dialogueLastsFor * 16;
+long int PocketsphinxAligner::decodeDialogue(ps_decoder_t *ps, SubtitleItem *sub, RecognitionContext& context) {
+    if (_cancelled != nullptr && *_cancelled)
+        throw AlignmentCancelled("Alignment of " + _audioFileName + " was cancelled");
 
-        if ((samplesAlreadyRead - recognitionWindow) >= 0)
-        {
-            if(samplesAlreadyRead >= _samples.size()) //start time of subtitle is out of sample range.
-            {
-                DEBUG << "Subtitle frame exists beyond audio clip length, aligning approximately. [Start : "<<sub->getStartTime()<<" | End : "<<sub->getEndTime()<<"]";
-                useApproxTimeOnly = true;
-            }
+    long int dialogueStartsAt = sub->getStartTime();
+
+    if (!_features) {
+        //samples of the dialogue along with the recognition window on either side, clamped to the audio
+        SampleView window = _audio->getSamplesByTime(dialogueStartsAt, sub->getEndTime(), recognitionWindow());
+
+        if (_parameters->trimSilence)
+            window = trimToSpeech(window);
+
+        ps_start_utt(ps);
+        ps_process_raw(ps, window.data(), window.size(), FALSE, FALSE);
+        ps_end_utt(ps);
+
+        return window.empty() ? -1 : window.startTime();
+    }
 
-            samplesAlreadyRead -= recognitionWindow;
+    //frames which begin inside the window
+    long int shift = _features->frameShift();
+    long int firstSample = std::max(dialogueStartsAt * samplesPerMillisecond - recognitionWindow(), 0L);
+    long int endSample = sub->getEndTime() * samplesPerMillisecond + recognitionWindow();
 
+    if (_parameters->trimSilence) {
+        SpeechSegment speech = speechWithin(_speech, firstSample, endSample);
+
+        if (speech.numberOfSamples > 0) {
+            firstSample = speech.firstSample;
+            endSample = speech.firstSample + speech.numberOfSamples;
         }
-        else
-            samplesAlreadyRead = 0;
+    }
 
-        if ((samplesToBeRead + (2 * recognitionWindow)) < _samples.size())
-            samplesToBeRead += (2 * recognitionWindow);
+    std::size_t firstFrame = (firstSample + shift - 1) / shift;
+    std::size_t lastFrame = std::min<std::size_t>(std::max(endSample, 0L) / shift, _features->size());
+    bool beyondAudio = (std::size_t)(dialogueStartsAt * samplesPerMillisecond) >= _features->size() * shift;
 
-        else
-            samplesToBeRead = _samples.size() - 1;
+    if (beyondAudio || lastFrame < firstFrame)
+        lastFrame = firstFrame;
 
-        /*
-        * 00:00:19,320 --> 00:00:21,056
-        * Why are you boring?
-        *
-        * dialogueStartsAt : 19320 ms
-        * dialogueEndsAt   : 21056 ms
-        * dialogueLastsFor : 1736 ms
-        *
-        * SamplesAlreadyRead = 19320 ms * 16 samples/ms = 309120 samples
-        * SampleToBeRead     = 1736  ms * 16 samples/ms = 27776 samples
-        *
-        */
+    mfcc_t **frames = _features->copyFrames(firstFrame, lastFrame - firstFrame, context.featureBuffer, context.featureRows);
+
+    //start from the mean of the complete audio, not from whatever the previous dialogue left behind
+    ps_set_cmn(ps, _features->mean().data());
 
-        if(!useApproxTimeOnly) //subtitle frame exists within audio clip length, process those samples
-        {
-            const int16_t *sample = _samples.data();
+    ps_start_utt(ps);
+    ps_process_cep(ps, frames, (int)context.featureRows.size(), FALSE, FALSE);
+    ps_end_utt(ps);
 
-            _rvWord = ps_start_utt(_psWordDecoder);
-            _rvWord = ps_process_raw(_psWordDecoder, sample + samplesAlreadyRead, samplesToBeRead, FALSE, FALSE);
-            _rvWord = ps_end_utt(_psWordDecoder);
+    return beyondAudio ? -1 : (long int)(firstFrame * 1000 / _features->frameRate());
+}
 
-            _hypWord = ps_get_hyp(_psWordDecoder, &_scoreWord);
+bool PocketsphinxAligner::recogniseDialogue(SubtitleItem *sub, RecognitionContext& context) {
+    if (sub->getDialogue().empty())
+        return false;
 
-            if (_hypWord == nullptr) {
-                _hypWord = "nullptr";
+    //first assigning approx timestamps
+    CurrentSub currSub(sub);
+    currSub.run();
 
-                if (_parameters->displayRecognised) {
-                    std::cout << "\n\n-----------------------------------------\n\n";
-                    std::cout << "Recognised: " << _hypWord << "\n";
-                }
+    //let's correct the timestamps :)
+
+    if (_parameters->forcedAlignment && forceAlignDialogue(sub, context))
+        return true;
 
+    long int dialogueStartsAt = sub->getStartTime();
+    long int utteranceStartsAt = decodeDialogue(context.wordDecoder, sub, context);
+
+    if (utteranceStartsAt < 0) { //start time of subtitle is out of sample range.
+        DEBUG << "Subtitle frame exists beyond audio clip length, aligning approximately. [Start : "<<sub->getStartTime()<<" | End : "<<sub->getEndTime()<<"]";
+        return true;
+    }
+
+    //subtitle frame exists within audio clip length, process those samples
+    std::ostream& display = *context.display;
+    int32 score;
+    const char *hyp = ps_get_hyp(context.wordDecoder, &score);
+
+    if (hyp == nullptr) {
+        if (_parameters->displayRecognised) {
+            display << "\n\n-----------------------------------------\n\n";
+            display << "Recognised: " << "nullptr" << "\n";
+        }
+
+        return false;
+    }
+
+    if (_parameters->displayRecognised) {
+        display << "\n\n-----------------------------------------\n\n";
+        display << "Start time of dialogue : " << dialogueStartsAt << "\n";
+        display << "End time of dialogue   : " << sub->getEndTime() << "\n\n";
+        display << "Recognised  : " << hyp << "\n";
+        display << "Actual      : " << sub->getDialogue() << "\n\n";
+    }
+
+    //finding and aligning words from subtitle
+    recognisedBlock currBlock = findAndSetWordTimes(_configWord, context.wordDecoder, sub, utteranceStartsAt, display);
+
+    //words of the dialogue the best hypothesis missed may still be among its alternatives
+    if (_parameters->useLattice)
+        findWordTimesInLattice(_configWord, context.wordDecoder, sub, utteranceStartsAt, display);
+
+    //trying to align non recognised words
+    currSub.alignNonRecognised(currBlock);
+
+    if (_parameters->searchPhonemes)
+        recognisePhonemes(sub, context);
+
+    return true;
+}
+
+bool PocketsphinxAligner::forceAlignDialogue(SubtitleItem *sub, RecognitionContext& context) {
+    ps_decoder_t *ps = context.wordDecoder;
+    const char *alignSearch = "forced";
+    std::string lmSearch(ps_get_search(ps));
+
+    std::string transcript;
+    for (const std::string& word : sub->getIndividualWords())
+        transcript += stringToLower(word) + " ";
+
+    //a linear HMM of the words of dialogue, between silences, replacing the one of previous dialogue
+    if (ps_set_align(ps, alignSearch, transcript.c_str()) < 0 || ps_set_search(ps, alignSearch) < 0) {
+        WARNING << "Could not build forced alignment of dialogue, recognising instead. [Start : " << sub->getStartTime() << " | End : " << sub->getEndTime() << "]";
+        ps_set_search(ps, lmSearch.c_str());
+        return false;
+    }
+
+    long int utteranceStartsAt = decodeDialogue(ps, sub, context);
+
+    if (utteranceStartsAt < 0) { //start time of subtitle is out of sample range.
+        DEBUG << "Subtitle frame exists beyond audio clip length, aligning approximately. [Start : "<<sub->getStartTime()<<" | End : "<<sub->getEndTime()<<"]";
+        ps_set_search(ps, lmSearch.c_str());
+        return true;
+    }
+
+    int32 score;
+    const char *hyp = ps_get_hyp(ps, &score);
+
+    if (hyp == nullptr) {   //audio too short to hold every phone of the dialogue
+        DEBUG << "Forced alignment did not reach the end of dialogue, recognising instead. [Start : " << sub->getStartTime() << " | End : " << sub->getEndTime() << "]";
+        ps_set_search(ps, lmSearch.c_str());
+        return false;
+    }
+
+    if (_parameters->displayRecognised) {
+        std::ostream& display = *context.display;
+        display << "\n\n-----------------------------------------\n\n";
+        display << "Start time of dialogue : " << sub->getStartTime() << "\n";
+        display << "End time of dialogue   : " << sub->getEndTime() << "\n\n";
+        display << "Aligned     : " << hyp << "\n";
+        display << "Actual      : " << sub->getDialogue() << "\n\n";
+    }
+
+    int frame_rate = cmd_ln_int32_r(_configWord, "-frate");
+    int wordIndex = 0;
+
+    //every word of dialogue is aligned, in order, between the silences <s> and </s>
+    for (ps_seg_t *iter = ps_seg_iter(ps); iter != nullptr; iter = ps_seg_next(iter)) {
+        std::string alignedWord(ps_seg_word(iter));
+
+        if (alignedWord == "<s>" || alignedWord == "</s>")
+            continue;
+
+        int32 sf, ef;
+        ps_seg_frames(iter, &sf, &ef);
+
+        sub->setWordRecognisedStatusByIndex(true, wordIndex);
+        sub->setWordTimesByIndex(utteranceStartsAt + sf * 1000 / frame_rate, utteranceStartsAt + ef * 1000 / frame_rate, wordIndex);
+        wordIndex++;
+    }
+
+    //phones come with the same alignment, no need to run the phoneme decoder
+    if (_parameters->searchPhonemes) {
+        int start, duration, filler;
+
+        for (int i = 0; const char *phone = ps_get_aligned_phone(ps, i, &start, &duration, &filler); i++) {
+            if (filler)     //SIL, NOISE et cetera..
                 continue;
 
+            long int startTime = utteranceStartsAt + start * 1000 / frame_rate;
+            long int endTime = utteranceStartsAt + (start + duration - 1) * 1000 / frame_rate;
+            sub->addPhoneme(phone, startTime, endTime);
+        }
+    }
+
+    ps_set_search(ps, lmSearch.c_str());
+    return true;
+}
+
+int PocketsphinxAligner::printDialogue(SubtitleItem *sub, int subCount) {
+    switch (_parameters->outputFormat)  //decide on basis of set output format
+    {
+        case srt:       subCount = printSRTContinuous(_outputFileName, subCount, sub, _parameters->printOption);
+            break;
+
+        case xml:       printXMLContinuous(_outputFileName, sub);
+            break;
+
+        case json:      printJSONContinuous(_outputFileName, sub);
+            break;
+
+        case karaoke:   subCount = printKaraokeContinuous(_outputFileName, subCount, sub, _parameters->printOption);
+            break;
+
+        default:    FATAL(InvalidParameters) << "An error occurred while choosing output format!";
+    }
+
+    return subCount;
+}
+
+void PocketsphinxAligner::initWorkerDecoders(std::size_t numberOfWorkers) {
+    //worker 0 uses the decoders of the aligner itself, every other worker gets its own sharing their acoustic model
+    while (_workerWordDecoders.size() + 1 < numberOfWorkers) {
+        ps_decoder_t *wordDecoder = initSharedDecoder(_configWord, _psWordDecoder);
+
+        if (wordDecoder == nullptr) {
+            FATAL(UnknownError) << "Failed to create recognizer, see log for details";
+        }
+
+        _workerWordDecoders.push_back(wordDecoder);
+        setLanguageModel(wordDecoder);
+
+        if (_parameters->searchPhonemes) {
+            ps_decoder_t *phonemeDecoder = initSharedDecoder(_configPhoneme, _psPhonemeDecoder);    //and its dictionary
+
+            if (phonemeDecoder == nullptr) {
+                FATAL(UnknownError) << "Failed to create phoneme recognizer, see log for details";
             }
 
-            if (_parameters->displayRecognised) {
-                std::cout << "\n\n-----------------------------------------\n\n";
-                std::cout << "Start time of dialogue : " << dialogueStartsAt << "\n";
-                std::cout << "End time of dialogue   : " << sub->getEndTime() << "\n\n";
-                std::cout << "Recognised  : " << _hypWord << "\n";
-                std::cout << "Actual      : " << sub->getDialogue() << "\n\n";
+            _workerPhonemeDecoders.push_back(phonemeDecoder);
+            setPhoneticLanguageModel(phonemeDecoder);
+        }
+    }
+}
+
+ps_decoder_t *PocketsphinxAligner::initSharedDecoder(cmd_ln_t *config, ps_decoder_t *decoder) {
+    if (_model != nullptr)
+        return _model->share(config, decoder);
+
+    std::lock_guard<std::mutex> lock(frontEndCreation());
+    return ps_init_shared(config, decoder);
+}
+
+void PocketsphinxAligner::freeDecoder(ps_decoder_t *decoder) {
+    if (_model != nullptr)
+        _model->release(decoder);
+    else
+        ps_free(decoder);
+}
+
+void PocketsphinxAligner::recogniseInParallel(int& subCount) {
+    std::size_t numberOfSubtitles = _subtitles.size();
+    std::size_t numberOfWorkers = std::max<std::size_t>(1, std::min<std::size_t>(_parameters->threads, numberOfSubtitles));
+
+    DEBUG << "Recognising using " << numberOfWorkers << " worker threads";
+    initWorkerDecoders(numberOfWorkers);
+
+    //longest dialogues are handed out first, so that no worker is left with a long one at the very end
+    std::vector<std::size_t> order(numberOfSubtitles);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return _subtitles[a]->getEndTime() - _subtitles[a]->getStartTime() > _subtitles[b]->getEndTime() - _subtitles[b]->getStartTime();
+    });
+
+    std::vector<std::string> displayed(numberOfSubtitles);     //recognised text, shown once the dialogue is printed
+    std::vector<char> finished(numberOfSubtitles, 0), printable(numberOfSubtitles, 0);
+    std::size_t next = 0;
+    std::exception_ptr failure;
+    std::mutex mutex;
+    std::condition_variable dialogueFinished;
+
+    auto work = [&](RecognitionContext context) {
+        std::ostringstream display;
+        context.display = &display;
+
+        while (true) {
+            std::size_t index;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (next == numberOfSubtitles)
+                    return;
+
+                index = order[next++];
             }
 
-            //finding and aligning words from subtitle
-            recognisedBlock currBlock = findAndSetWordTimes(_configWord, _psWordDecoder, sub);
+            try {
+                display.str("");
+                bool print = recogniseDialogue(_subtitles[index], context);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                displayed[index] = display.str();
+                printable[index] = print;
+                finished[index] = 1;
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
 
-            //trying to align non recognised words
-            currSub.alignNonRecognised(currBlock);
+                if (!failure)
+                    failure = std::current_exception();
 
-            if (_parameters->searchPhonemes)
-                recognisePhonemes(sample + samplesAlreadyRead, samplesToBeRead, sub);
+                next = numberOfSubtitles;   //no more work for anyone
+            }
+
+            dialogueFinished.notify_all();
         }
+    };
 
-        switch (_parameters->outputFormat)  //decide on basis of set output format
-        {
-            case srt:       subCount = printSRTContinuous(_outputFileName, subCount, sub, _parameters->printOption);
-                break;
+    std::vector<std::thread> workers;
+    workers.emplace_back(work, RecognitionContext(_psWordDecoder, _psPhonemeDecoder, nullptr));
 
-            case xml:       printXMLContinuous(_outputFileName, sub);
-                break;
+    for (std::size_t i = 0; i + 1 < numberOfWorkers; i++)
+        workers.emplace_back(work, RecognitionContext(_workerWordDecoders[i], _parameters->searchPhonemes ? _workerPhonemeDecoders[i] : nullptr, nullptr));
 
-            case json:      printJSONContinuous(_outputFileName, sub);
-                break;
+    //results are written in the order of subtitles, as soon as they are available
+    for (std::size_t index = 0; index < numberOfSubtitles; index++) {
+        std::unique_lock<std::mutex> lock(mutex);
+        dialogueFinished.wait(lock, [&] { return finished[index] || failure; });
 
-            case karaoke:   subCount = printKaraokeContinuous(_outputFileName, subCount, sub, _parameters->printOption);
-                break;
+        if (failure)
+            break;
+
+        lock.unlock();
+
+        std::cout << displayed[index];
+
+        if (printable[index])
+            subCount = printDialogue(_subtitles[index], subCount);
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+bool PocketsphinxAligner::recognise() {
+    int subCount = 1;
+    initFile(_outputFileName, _parameters->outputFormat);
+
+    INFO << "Recognising and aligning..";
+
+    if (_parameters->threads > 1) {
+        recogniseInParallel(subCount);
+    }
+
+    else {
+        RecognitionContext context(_psWordDecoder, _psPhonemeDecoder, &std::cout);
 
-            default:    FATAL(InvalidParameters) << "An error occurred while choosing output format!";
+        for (SubtitleItem *sub : _subtitles) {
+            if (recogniseDialogue(sub, context))
+                subCount = printDialogue(sub, subCount);
         }
     }
 
@@ -525,14 +1059,117 @@ bool PocketsphinxAligner::recognise() {
     return true;
 }
 
+bool PocketsphinxAligner::alignLive() {
+    int subCount = 1;
+    initFile(_outputFileName, _parameters->outputFormat);
+
+    INFO << "Aligning captions as their audio arrives..";
+
+    //captions arrive on a stream of their own, read alongside the audio; shared with the reader so that it can be left
+    //waiting for captions which never come, should aligning fail
+    struct Captions {
+        std::deque<std::unique_ptr<SubtitleItem>> received;     //in order of arrival, waiting for their audio
+        bool ended = false;
+        std::exception_ptr failure;
+        std::mutex mutex;
+        std::condition_variable arrived;
+    };
+
+    std::shared_ptr<Captions> captions = std::make_shared<Captions>();
+    std::string captionStreamName = _subtitleFileName;
+
+    std::thread reader([captions, captionStreamName] {
+        try {
+            CaptionStream stream(captionStreamName);
+
+            while (std::unique_ptr<SubtitleItem> cue = stream.next()) {
+                std::lock_guard<std::mutex> lock(captions->mutex);
+                captions->received.push_back(std::move(cue));
+                captions->arrived.notify_all();
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(captions->mutex);
+            captions->failure = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(captions->mutex);
+        captions->ended = true;
+        captions->arrived.notify_all();
+    });
+
+    RecognitionContext context(_psWordDecoder, _psPhonemeDecoder, &std::cout);
+    long int lookahead = _parameters->latency * samplesPerMillisecond;
+    long int history = _parameters->history * samplesPerMillisecond;
+    long int samplesArrived = 0;
+    bool audioEnded = false;
+
+    try {
+        while (true) {
+            std::unique_ptr<SubtitleItem> cue;
+
+            {
+                std::unique_lock<std::mutex> lock(captions->mutex);
+
+                if (audioEnded)     //the rest is aligned with the audio there is, as it comes
+                    captions->arrived.wait(lock, [&] { return !captions->received.empty() || captions->ended; });
+
+                if (captions->failure)
+                    std::rethrow_exception(captions->failure);
+
+                //in the order received, each once its audio and the lookahead after it have arrived
+                if (!captions->received.empty() && (audioEnded || captions->received.front()->getEndTime() * samplesPerMillisecond + lookahead <= samplesArrived)) {
+                    cue = std::move(captions->received.front());
+                    captions->received.pop_front();
+                }
+
+                else if (audioEnded && captions->ended) {
+                    break;
+                }
+            }
+
+            if (!cue) {     //more audio is needed, waits till it arrives
+                SampleView block = _audio->getSamples(samplesArrived, liveBlockSamples);
+                samplesArrived += block.size();
+                audioEnded = block.empty();
+                continue;
+            }
+
+            if (cue->getEndTime() * samplesPerMillisecond < samplesArrived - history)
+                WARNING << "Caption " << cue->getSubNo() << " arrived after its audio was discarded, aligning approximately";
+
+            if (recogniseDialogue(cue.get(), context))
+                subCount = printDialogue(cue.get(), subCount);
+        }
+    }
+    catch (...) {
+        reader.detach();    //may still be waiting for captions
+        throw;
+    }
+
+    reader.join();
+
+    printFileEnd(_outputFileName, _parameters->outputFormat);
+
+    INFO << "Finished live alignment..";
+
+    return true;
+}
+
 bool PocketsphinxAligner::align() {
     if (_parameters->grammarType != no_grammar)
         generateGrammar(_parameters->grammarType);
 
     initDecoder(_parameters->modelPath, _parameters->lmPath, _parameters->dictPath, _parameters->fsgPath, _parameters->alignerLogPath);
 
-    if (_parameters->transcribe || _parameters->usingTranscript) {
-        transcribe();
+    if (_parameters->precomputeFeatures && !(_parameters->transcribe || _parameters->usingTranscript))
+        prepareFeatures();
+
+    if (_parameters->liveAlign) {
+        alignLive();
+    }
+    else if (_parameters->transcribe || _parameters->usingTranscript) {
+        transcribe();   //segments the audio with its own voice activity detection, always decodes samples
     }
     else {
         if (_parameters->useFSG)
@@ -545,37 +1182,26 @@ bool PocketsphinxAligner::align() {
 
 }
 
-bool PocketsphinxAligner::recognisePhonemes(const int16_t *sample, int readLimit, SubtitleItem *sub) {
-    _rvPhoneme = ps_start_utt(_psPhonemeDecoder);
-    _rvPhoneme = ps_process_raw(_psPhonemeDecoder, sample, readLimit, FALSE, FALSE);
-    _rvPhoneme = ps_end_utt(_psPhonemeDecoder);
+bool PocketsphinxAligner::recognisePhonemes(SubtitleItem *sub, RecognitionContext& context) {
+    long int utteranceStartsAt = decodeDialogue(context.phonemeDecoder, sub, context);
 
-    _hypPhoneme = ps_get_hyp(_psPhonemeDecoder, &_scorePhoneme);
+    int32 score;
+    const char *hyp = ps_get_hyp(context.phonemeDecoder, &score);
 
-    if (_hypPhoneme == nullptr) {
-        _hypPhoneme = "nullptr";
-
-        if (_parameters->displayRecognised)
-            std::cout << "Phonemes: " << _hypPhoneme << "\n";
-    }
+    if (_parameters->displayRecognised)
+        *context.display << "Phonemes: " << (hyp == nullptr ? "nullptr" : hyp) << "\n";
 
-    else {
-        if (_parameters->displayRecognised)
-            std::cout << "Phonemes: " << _hypPhoneme << "\n";
-
-        findAndSetPhonemeTimes(_configPhoneme, _psPhonemeDecoder, sub);
-    }
+    if (hyp != nullptr)
+        findAndSetPhonemeTimes(_configPhoneme, context.phonemeDecoder, sub, utteranceStartsAt);
 
     return true;
 }
 
-int PocketsphinxAligner::findTranscribedWordTimings(cmd_ln_t *config, ps_decoder_t *ps, int index) {
+void PocketsphinxAligner::findTranscribedWordTimings(cmd_ln_t *config, ps_decoder_t *ps, long int utteranceStartsAt, AlignedData& words) {
     int frame_rate = cmd_ln_int32_r(config, "-frate");
     ps_seg_t *iter = ps_seg_iter(ps);
-    int printedTillIndex = index;
 
     while (iter != nullptr) {
-        index++;
         int32 sf, ef, pprob;
         float conf;
 
@@ -584,12 +1210,19 @@ int PocketsphinxAligner::findTranscribedWordTimings(cmd_ln_t *config, ps_decoder
         conf = logmath_exp(ps_get_logmath(ps), pprob);
 
         std::string recognisedWord(ps_seg_word(iter));
-        long startTime = sf * 1000 / frame_rate, endTime = ef * 1000 / frame_rate;
+        long startTime = utteranceStartsAt + sf * 1000 / frame_rate, endTime = utteranceStartsAt + ef * 1000 / frame_rate;
 
-        _alignedData.addNewWord(recognisedWord, startTime, endTime, conf);
+        words.addNewWord(recognisedWord, startTime, endTime, conf);
 
         iter = ps_seg_next(iter);
     }
+}
+
+void PocketsphinxAligner::printTranscribed(const AlignedData& words) {
+    int printedTillIndex = _alignedData._words.size();
+
+    for (std::size_t i = 0; i < words._words.size(); i++)
+        _alignedData.addNewWord(words._words[i], words._wordStartTimes[i], words._wordEndTimes[i], words._wordConf[i]);
 
     if (_parameters->outputFormat == xml)
         printTranscriptionAsXMLContinuous(_outputFileName, &_alignedData, printedTillIndex);
@@ -599,71 +1232,191 @@ int PocketsphinxAligner::findTranscribedWordTimings(cmd_ln_t *config, ps_decoder
 
     else if (_parameters->outputFormat == srt)
         printTranscriptionAsSRTContinuous(_outputFileName, &_alignedData, printedTillIndex);
-
-    return index;
 }
 
 bool PocketsphinxAligner::transcribe() {
     INFO << "Transcribing...";
 
-    //pointer to samples
-    const int16_t *sample = _samples.data();
+    std::size_t numberOfWorkers = std::max<std::size_t>(1, _parameters->threads);
 
-    //creating partition of 2048 bytes
-    int numberOfPartitions = _samples.size() / 2048, remainingSamples = _samples.size() % 2048;
+    DEBUG << "Transcribing using " << numberOfWorkers << " worker threads";
+    initWorkerDecoders(numberOfWorkers);
 
-    //index of the word : used for sub and output handling
-    int index = 0;
+    struct Utterance {
+        long int firstSample;
+        std::vector<int16_t> samples;       //copied, the stream only keeps a window of the audio
+        AlignedData words;
+        std::string hypothesis;
+        bool finished;
+    };
 
-    bool utt_started, in_speech;
+    //every utterance starts from the cepstral mean the decoders began with, not from the utterance decoded before it
+    std::vector<mfcc_t> initialMean(ps_get_cmn(_psWordDecoder, nullptr));
+    ps_get_cmn(_psWordDecoder, initialMean.data());
 
-    _rvWord = ps_start_utt(_psWordDecoder);
-    utt_started = FALSE;
+    std::deque<std::unique_ptr<Utterance>> utterances;     //in time order, until printed
+    std::deque<Utterance *> queued;                         //not yet taken by a worker
+    bool segmented = false;
+    std::exception_ptr failure;
+    std::mutex mutex;
+    std::condition_variable changed;
 
-    printTranscriptionHeader(_outputFileName, _parameters->outputFormat);
+    auto work = [&](ps_decoder_t *ps) {
+        while (true) {
+            Utterance *utterance;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return !queued.empty() || segmented || failure; });
 
-    for (int i = 0; i <= numberOfPartitions; i++) {
-        if (i == numberOfPartitions)
-            ps_process_raw(_psWordDecoder, sample, remainingSamples, FALSE, FALSE);
+                if (queued.empty() || failure)
+                    return;
 
-        else
-            ps_process_raw(_psWordDecoder, sample, 2048, FALSE, FALSE);
+                utterance = queued.front();
+                queued.pop_front();
+            }
 
-        in_speech = ps_get_in_speech(_psWordDecoder);
+            changed.notify_all();   //room in the queue
 
-        if (in_speech && !utt_started) {
-            utt_started = TRUE;
-        }
+            try {
+                if (!initialMean.empty())
+                    ps_set_cmn(ps, initialMean.data());
+
+                //a stream of its own, so that frames are counted from its start and noise is estimated on it alone
+                ps_start_stream(ps);
+
+                if (ps_start_utt(ps) < 0 || ps_process_raw(ps, utterance->samples.data(), utterance->samples.size(), FALSE, FALSE) < 0 || ps_end_utt(ps) < 0)
+                    FATAL(UnknownError) << "Failed to decode utterance at " << utterance->firstSample / samplesPerMillisecond << " ms, see log for details";
+
+                const char *hyp = ps_get_hyp(ps, nullptr);
 
-        if (!in_speech && utt_started) {
-            ps_end_utt(_psWordDecoder);
-            _hypWord = ps_get_hyp(_psWordDecoder, nullptr);
+                if (hyp != nullptr) {
+                    utterance->hypothesis = hyp;
+                    findTranscribedWordTimings(_configWord, ps, utterance->firstSample / samplesPerMillisecond, utterance->words);
+                }
+
+                std::vector<int16_t>().swap(utterance->samples);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                utterance->finished = true;
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
 
-            if (_hypWord != nullptr) {
-                if (_parameters->displayRecognised)
-                    std::cout << "Recognised: " << _hypWord << "\n";
-                index = findTranscribedWordTimings(_configWord, _psWordDecoder, index);
+                if (!failure)
+                    failure = std::current_exception();
             }
 
-            ps_start_utt(_psWordDecoder);
-            utt_started = FALSE;
+            changed.notify_all();
         }
+    };
 
-        sample += 2048;
+    std::vector<std::thread> workers;
+    workers.emplace_back(work, _psWordDecoder);
 
-    }
+    for (std::size_t i = 0; i + 1 < numberOfWorkers; i++)
+        workers.emplace_back(work, _workerWordDecoders[i]);
 
-    _rvWord = ps_end_utt(_psWordDecoder);
+    //results are written in time order, as soon as the utterances before them are done
+    auto printFinished = [&](bool wait) {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
 
-    if (utt_started) {
-        _hypWord = ps_get_hyp(_psWordDecoder, nullptr);
-        if (_hypWord != nullptr) {
-            if (_parameters->displayRecognised)
-                std::cout << "Recognised: " << _hypWord << "\n";
-            index = findTranscribedWordTimings(_configWord, _psWordDecoder, index);
+            if (wait)
+                changed.wait(lock, [&] { return utterances.empty() || utterances.front()->finished || failure; });
+
+            if (utterances.empty() || !utterances.front()->finished || failure)
+                return;
+
+            std::unique_ptr<Utterance> utterance = std::move(utterances.front());
+            utterances.pop_front();
+            lock.unlock();
+
+            if (_parameters->displayRecognised && !utterance->hypothesis.empty())
+                std::cout << "Recognised: " << utterance->hypothesis << "\n";
+
+            printTranscribed(utterance->words);
         }
+    };
+
+    auto enqueue = [&](const std::vector<SpeechSegment>& segments, const std::vector<int16_t>& history, long int historyStart) {
+        for (const SpeechSegment& segment : segments) {
+            std::unique_ptr<Utterance> utterance(new Utterance());
+            utterance->firstSample = segment.firstSample;
+            utterance->finished = false;
+
+            auto first = history.begin() + (segment.firstSample - historyStart);
+            utterance->samples.assign(first, first + segment.numberOfSamples);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            queued.push_back(utterance.get());
+            utterances.push_back(std::move(utterance));
+            changed.notify_all();
+
+            //reading ahead of the workers would only hold more of the audio in memory
+            changed.wait(lock, [&] { return queued.size() < 2 * numberOfWorkers || failure; });
+        }
+    };
+
+    printTranscriptionHeader(_outputFileName, _parameters->outputFormat);
+
+    try {
+        VadOptions options = vadOptions();
+        options.maximumSegment = _parameters->maxUtterance;
+
+        VoiceActivityDetector detector(options);
+        std::vector<int16_t> history;       //samples from historyStart on, segments not yet complete may need them
+        long int historyStart = 0;
+
+        //processing partitions of 2048 samples
+        for (long int i = 0; ; i++) {
+            SampleView partition = _audio->getSamples(i * 2048, 2048);  //last partition holds the remaining samples
+
+            if (partition.empty())
+                break;
+
+            history.insert(history.end(), partition.data(), partition.data() + partition.size());
+            enqueue(detector.process(partition), history, historyStart);
+
+            //dropped once half of it is unneeded, so that every sample is moved about once
+            long int unneeded = detector.keepFrom() - historyStart;
+
+            if (unneeded > 0 && (std::size_t) unneeded * 2 >= history.size()) {
+                history.erase(history.begin(), history.begin() + unneeded);
+                historyStart += unneeded;
+            }
+
+            printFinished(false);
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (failure)
+                break;
+        }
+
+        enqueue(detector.finish(), history, historyStart);
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!failure)
+            failure = std::current_exception();
     }
 
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        segmented = true;
+    }
+
+    changed.notify_all();
+    printFinished(true);
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    if (failure)
+        std::rethrow_exception(failure);
+
     printTranscriptionFooter(_outputFileName, _parameters->outputFormat);
 
     INFO << "Finished transcription.";
@@ -680,15 +1433,12 @@ bool PocketsphinxAligner::alignWithFSG() {
     int subCount = 1;
     initFile(_outputFileName, _parameters->outputFormat);
 
-    long int recognitionWindow = 0;
+    RecognitionContext context(_psWordDecoder, _psPhonemeDecoder, &std::cout);
 
-    if (_audioWindow) {
-        recognitionWindow = _audioWindow * 16;
-    }
-
-    else if (_sampleWindow) {
-        recognitionWindow = _sampleWindow;
-    }
+    //each dialogue gets its grammar as a search of the warm decoder, the language model search stays as fallback
+    const std::string lmSearch(ps_get_search(_psWordDecoder)), fsgSearch("dialogue");
+    logmath_t *lmath = ps_get_logmath(_psWordDecoder);
+    float32 languageWeight = cmd_ln_float32_r(_configWord, "-lw");
 
     for (SubtitleItem *sub : _subtitles) {
         if (sub->getDialogue().empty())
@@ -700,56 +1450,27 @@ bool PocketsphinxAligner::alignWithFSG() {
         currSub.run();
 
         long int dialogueStartsAt = sub->getStartTime();
-        std::string fsgname(_fsgPath + std::to_string(dialogueStartsAt));
-        fsgname += ".fsg";
-
-        cmd_ln_t *subConfig;
-        subConfig = cmd_ln_init(nullptr,
-            ps_args(), TRUE,
-            "-hmm", _modelPath.c_str(),
-            "-lm", _lmPath.c_str(),
-            "-dict", _dictPath.c_str(),
-            "-logfn", _logPath.c_str(),
-            "-fsg", fsgname.c_str(),
-            //                          "-lw", "1.0",
-            //                          "-beam", "1e-80",
-            //                          "-wbeam", "1e-60",
-            //                          "-pbeam", "1e-80",
-            nullptr);
+        fsg_model_t *fsg;
 
-        if (subConfig == nullptr) {
-            fprintf(stderr, "Failed to create config object, see log for details\n");
-            return -1;
+        if (_fsgPath.empty()) {
+            fsg = CreateSubtitleFSG(sub, lmath, languageWeight);
         }
 
-        ps_reinit(_psWordDecoder, subConfig);
-
-        if (_psWordDecoder == nullptr) {
-            fprintf(stderr, "Failed to create recognizer, see log for details\n");
-            return -1;
+        else {  //grammars supplied by the user, one file per dialogue
+            std::string fsgname(_fsgPath + std::to_string(dialogueStartsAt));
+            fsgname += ".fsg";
+            fsg = fsg_model_readfile(fsgname.c_str(), lmath, languageWeight);
         }
 
-        long int dialogueLastsFor = (sub->getEndTime() - dialogueStartsAt);
-
-        long int samplesAlreadyRead = dialogueStartsAt * 16;
-        long int samplesToBeRead = dialogueLastsFor * 16;
-
-        if ((samplesAlreadyRead - recognitionWindow) >= 0)
-            samplesAlreadyRead -= recognitionWindow;
-        else
-            samplesAlreadyRead = 0;
-
-        if ((samplesToBeRead + (2 * recognitionWindow)) < _samples.size())
-            samplesToBeRead += (2 * recognitionWindow);
-
-        else
-            samplesToBeRead = _samples.size() - 1;
+        if (fsg == nullptr || ps_set_fsg(_psWordDecoder, fsgSearch.c_str(), fsg) < 0 || ps_set_search(_psWordDecoder, fsgSearch.c_str()) < 0) {
+            WARNING << "Unable to use FSG of dialogue starting at " << dialogueStartsAt << ", using language model instead. See log for details";
+            ps_set_search(_psWordDecoder, lmSearch.c_str());
+        }
 
-        const int16_t *sample = _samples.data();
+        if (fsg != nullptr)
+            fsg_model_free(fsg);    //retained by the search
 
-        _rvWord = ps_start_utt(_psWordDecoder);
-        _rvWord = ps_process_raw(_psWordDecoder, sample + samplesAlreadyRead, samplesToBeRead, FALSE, FALSE);
-        _rvWord = ps_end_utt(_psWordDecoder);
+        long int utteranceStartsAt = decodeDialogue(_psWordDecoder, sub, context);
 
         _hypWord = ps_get_hyp(_psWordDecoder, &_scoreWord);
 
@@ -773,29 +1494,17 @@ bool PocketsphinxAligner::alignWithFSG() {
             std::cout << "Actual      : " << sub->getDialogue() << "\n\n";
         }
 
-        recognisedBlock currBlock = findAndSetWordTimes(subConfig, _psWordDecoder, sub);
-
-        switch (_parameters->outputFormat)  //decide on basis of set output format
-        {
-        case srt:       subCount = printSRTContinuous(_outputFileName, subCount, sub, _parameters->printOption);
-            break;
-
-        case xml:       printXMLContinuous(_outputFileName, sub);
-            break;
-
-        case json:      printJSONContinuous(_outputFileName, sub);
-            break;
+        recognisedBlock currBlock = findAndSetWordTimes(_configWord, _psWordDecoder, sub, utteranceStartsAt, std::cout);
 
-        case karaoke:   subCount = printKaraokeContinuous(_outputFileName, subCount, sub, _parameters->printOption);
-            break;
-
-        default:        FATAL(UnknownError) << "An error occurred while choosing output format!";
-        }
+        if (_parameters->useLattice)
+            findWordTimesInLattice(_configWord, _psWordDecoder, sub, utteranceStartsAt, std::cout);
 
-
-        cmd_ln_free_r(subConfig);
+        subCount = printDialogue(sub, subCount);
     }
 
+    ps_set_search(_psWordDecoder, lmSearch.c_str());
+    ps_unset_search(_psWordDecoder, fsgSearch.c_str());
+
     printFileEnd(_outputFileName, _parameters->outputFormat);
 
     return true;
@@ -825,11 +1534,15 @@ bool PocketsphinxAligner::printAligned(const std::string& outputFileName, output
 
 PocketsphinxAligner::~PocketsphinxAligner() {
 
-    ps_free(_psWordDecoder);
+    for (ps_decoder_t *decoder : _workerWordDecoders)
+        freeDecoder(decoder);
+
+    for (ps_decoder_t *decoder : _workerPhonemeDecoders)
+        freeDecoder(decoder);
+
+    freeDecoder(_psWordDecoder);
     cmd_ln_free_r(_configWord);
 
-    if (_parameters->searchPhonemes) {
-        ps_free(_psPhonemeDecoder);
-        cmd_ln_free_r(_configPhoneme);
-    }
+    freeDecoder(_psPhonemeDecoder);
+    cmd_ln_free_r(_configPhoneme);
 }
@@ -9,14 +9,61 @@
 
 #include "srtparser.h"
 #include "read_wav_file.h"
+#include "sample_stream.h"
+#include "feature_store.h"
 #include "pocketsphinx.h"
 #include "grammar_tools.h"
 #include "generate_approx_timestamp.h"
 #include "commons.h"
 #include "params.h"
 #include "output_handler.h"
+#include "word_matcher.h"
+#include "voice_activity_detection.h"
+#include "caption_stream.h"
 
-int levenshtein_distance(const std::string& firstWord, const std::string& secondWord);
+#include <atomic>
+#include <mutex>
+
+struct LatticeWord      //a word hypothesised by the decoder, with the probability it was spoken then
+{
+    std::string word;
+    long int startTime, endTime;
+    double posterior;
+};
+
+//words of the lattice the best hypothesis of the last utterance was found in, times offset by utteranceStartsAt
+std::vector<LatticeWord> readLattice(ps_decoder_t *ps, cmd_ln_t *config, long int utteranceStartsAt);
+
+struct RecognitionContext   //what a thread needs to recognise dialogues on its own
+{
+    ps_decoder_t * wordDecoder, * phonemeDecoder;
+    std::vector<mfcc_t> featureBuffer;      //writable copy of the frames being decoded
+    std::vector<mfcc_t *> featureRows;
+    std::ostream * display;                 //where recognised text is shown, if displayRecognised
+
+    RecognitionContext(ps_decoder_t *word, ps_decoder_t *phoneme, std::ostream *out) noexcept
+        : wordDecoder(word), phonemeDecoder(phoneme), display(out) {}
+};
+
+struct AlignmentCancelled : public std::runtime_error {    //thrown out of align() when cancelled, before the next dialogue is decoded
+    AlignmentCancelled(std::string reason) noexcept : std::runtime_error(std::move(reason)) {}
+};
+
+class AcousticModel     //loaded once and lent to the decoders of any number of aligners, e.g. the jobs of a batch
+{
+    cmd_ln_t * _config;
+    ps_decoder_t * _decoder;                //holds the model only, without dictionary or search
+    std::mutex _mutex;                      //decoders sharing the model are created and freed one at a time
+
+public:
+    AcousticModel(const std::string& modelPath, const std::string& logPath);
+    AcousticModel(const AcousticModel&) = delete;
+    AcousticModel& operator=(const AcousticModel&) = delete;
+
+    ps_decoder_t *share(cmd_ln_t *config, ps_decoder_t *decoder = nullptr);    //new decoder sharing the model, or decoder and its dictionary; nullptr on failure
+    void release(ps_decoder_t *decoder);
+    ~AcousticModel();
+};
 
 class PocketsphinxAligner
 {
@@ -24,38 +71,68 @@ private:
     std::string _audioFileName, _subtitleFileName, _transcriptFileName, _outputFileName;          //input and output filenames
 
     std::unique_ptr<WaveFileData> _file;
+    std::unique_ptr<SampleStream> _stream;  //used instead of _file when streaming audio
+    SampleSource * _audio;                  //whichever of the above serves the samples
+    std::unique_ptr<FeatureStore> _features;    //features of the complete audio, decoded instead of the samples if set
+    static const long int liveBlockSamples = 1600;  //audio read at a time while waiting for live captions, 100 ms
+    std::vector<SpeechSegment> _speech;     //of the complete audio, found along with its features when trimming windows
+    std::unique_ptr<Grammar> _grammar;              //generated in this run, handed to decoders in memory
     SubtitleParserFactory _subParserFactory;
-    SubtitleParser * _parser;
+    std::unique_ptr<SubtitleParser> _parser;
     std::vector <SubtitleItem*> _subtitles;
-    std::vector<int16_t> _samples;
 
     AlignedData _alignedData;
     Params* _parameters;
+    AcousticModel * _model;                 //shared with other aligners, if given
+    const std::atomic<bool> * _cancelled;   //checked before each dialogue, if given
 
     std::string _modelPath, _lmPath, _dictPath, _fsgPath, _logPath, _phoneticLmPath, _phonemeLogPath;
     long int _audioWindow, _sampleWindow, _searchWindow;
 
     ps_decoder_t * _psWordDecoder, * _psPhonemeDecoder;
+    std::vector<ps_decoder_t *> _workerWordDecoders, _workerPhonemeDecoders;   //one per additional worker thread
     cmd_ln_t * _configWord, * _configPhoneme;
     char const * _hypWord, * _hypPhoneme;
     int _rvWord, _rvPhoneme;
     int32 _scoreWord, _scorePhoneme;
 
     bool printWordTimes(cmd_ln_t *config, ps_decoder_t *ps);
-    int findTranscribedWordTimings(cmd_ln_t *config, ps_decoder_t *ps, int index);
-    recognisedBlock findAndSetWordTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub);
-    bool findAndSetPhonemeTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub);
+    void findTranscribedWordTimings(cmd_ln_t *config, ps_decoder_t *ps, long int utteranceStartsAt, AlignedData& words);
+    void printTranscribed(const AlignedData& words);    //append words of the next utterance to the aligned data and output
+    recognisedBlock findAndSetWordTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub, long int utteranceStartsAt, std::ostream& display);
+    int findWordTimesInLattice(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub, long int utteranceStartsAt, std::ostream& display);   //time words missing from the best hypothesis, returns how many
+    bool findAndSetPhonemeTimes(cmd_ln_t *config, ps_decoder_t *ps, SubtitleItem *sub, long int utteranceStartsAt);
+    long int recognitionWindow() const noexcept;    //samples searched on either side of a dialogue
+    VadOptions vadOptions() const noexcept;
+    SampleView trimToSpeech(const SampleView& window) const;   //from the first to the last speech in the window, all of it if there is none
+    bool prepareFeatures();                         //compute features of the complete audio, or load them from the cache
+    long int decodeDialogue(ps_decoder_t *ps, SubtitleItem *sub, RecognitionContext& context);  //decode dialogue and its window as one utterance, returns the time it begins at or -1 if beyond audio
+    bool recogniseDialogue(SubtitleItem *sub, RecognitionContext& context);    //align words of one dialogue, false if it should not be printed
+    bool forceAlignDialogue(SubtitleItem *sub, RecognitionContext& context);   //viterbi align the known words of one dialogue, false if they could not be aligned
+    bool recognisePhonemes(SubtitleItem *sub, RecognitionContext& context);
+    void recogniseInParallel(int& subCount);        //dialogues shared among worker threads, printed in order
+    void initWorkerDecoders(std::size_t numberOfWorkers);
+    ps_decoder_t *initSharedDecoder(cmd_ln_t *config, ps_decoder_t *decoder);  //sharing the acoustic model and dictionary of decoder, or the lent model if nullptr
+    void freeDecoder(ps_decoder_t *decoder);
+    int printDialogue(SubtitleItem *sub, int subCount);
     bool reInitDecoder(cmd_ln_t *config, ps_decoder_t *ps);
+    bool usesGenerated(grammarName part, const std::string& path) const;   //whether the decoders would otherwise read the part back from path
+    bool addGeneratedWords(ps_decoder_t *ps);       //add the generated dictionary, shared with the decoders created from ps
+    bool prunesDictionary() const;                  //whether only the words of the subtitles are read from the dictionary
+    std::vector<std::string> vocabulary() const;    //words of the subtitles or transcript
+    bool loadPrunedDictionary(ps_decoder_t *ps);    //read the words of vocabulary() from the dictionary file
+    bool setLanguageModel(ps_decoder_t *ps);        //search with the generated language model
+    bool setPhoneticLanguageModel(ps_decoder_t *ps);
     bool initPhonemeDecoder(const std::string& phoneticLmPath, const std::string& phonemeLogPath);
 
 public:
-    PocketsphinxAligner(Params* parameters) noexcept;
+    PocketsphinxAligner(Params* parameters, AcousticModel *model = nullptr, const std::atomic<bool> *cancelled = nullptr);
     bool initDecoder(const std::string& modelPath, const std::string& lmPath, const std::string& dictPath, const std::string& fsgPath, const std::string& logPath);
     bool generateGrammar(grammarName name);
     bool recognise();
     bool alignWithFSG();
+    bool alignLive();                               //captions and audio read as they arrive, each caption aligned once its audio is there
     bool align();
-    bool recognisePhonemes(const int16_t *sample, int readLimit, SubtitleItem *sub);
     bool transcribe();
     bool printAligned(const std::string& outputFileName, outputFormats format) const noexcept;
     ~PocketsphinxAligner();
@@ -0,0 +1,143 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "sample_stream.h"
+#include "webrtc/common_audio/ring_buffer.h"
+
+SampleStream::SampleStream(const std::string& fileName, bool isRawFile, std::size_t capacity)
+    : _fileStream(fileName, std::ios::binary),
+      _ringBuffer(nullptr),
+      _capacity(capacity),
+      _firstBuffered(0),
+      _samplesRead(0),
+      _endOfStream(false)
+{
+    DEBUG << "Streaming audio from file : " << fileName;
+
+    if (!_fileStream)
+    {
+        FATAL(FileNotFound) << "Unable to open file : " << fileName;
+    }
+
+    open(_fileStream, isRawFile);
+}
+
+SampleStream::SampleStream(std::istream& stream, bool isRawFile, std::size_t capacity)
+    : _ringBuffer(nullptr),
+      _capacity(capacity),
+      _firstBuffered(0),
+      _samplesRead(0),
+      _endOfStream(false)
+{
+    DEBUG << "Streaming audio from stream";
+
+    if (&stream == &std::cin)
+        setStandardInputToBinary();
+
+    open(stream, isRawFile);
+}
+
+void SampleStream::open(std::istream& stream, bool isRawFile)
+{
+    _reader = decltype(_reader)(new WaveStreamReader(stream, isRawFile));
+
+    if (!isRawFile)
+        _reader->readHeader();  //fails early on invalid audio, before any decoding is done
+
+    _ringBuffer = WebRtc_CreateBuffer(_capacity, sizeof(int16_t));
+
+    if (_ringBuffer == nullptr)
+    {
+        FATAL(UnknownError) << "Unable to allocate audio buffer of " << _capacity << " samples!";
+    }
+
+    _block.resize(std::min(_capacity, WaveStreamReader::blockSize / 2));
+    _window.resize(_capacity);
+
+    DEBUG << "Audio buffer holds " << _capacity / samplesPerMillisecond << " ms";
+}
+
+void SampleStream::fill(std::size_t upto, std::size_t keepFrom)
+{
+    while (_samplesRead < upto && !_endOfStream)
+    {
+        std::size_t space = WebRtc_available_write(_ringBuffer);
+
+        if (space == 0)     //ring is full, let go of the oldest samples
+        {
+            std::size_t discardable = keepFrom > _firstBuffered ? keepFrom - _firstBuffered : 0;
+            std::size_t discard = std::min(std::min(discardable, _block.size()), WebRtc_available_read(_ringBuffer));
+
+            if (discard == 0)
+                break;  //rest of the window does not fit
+
+            WebRtc_MoveReadPtr(_ringBuffer, (int)discard);
+            _firstBuffered += discard;
+            continue;
+        }
+
+        std::size_t count = _reader->readSamples(_block.data(), std::min(space, _block.size()));
+
+        if (count == 0)
+        {
+            DEBUG << "End of audio stream, number of samples : " << _samplesRead;
+            _endOfStream = true;
+            break;
+        }
+
+        WebRtc_WriteBuffer(_ringBuffer, _block.data(), count);
+        _samplesRead += count;
+    }
+}
+
+SampleView SampleStream::getSamples(long int firstSample, long int numberOfSamples)
+{
+    if (firstSample < 0)    //window begins before the audio, trim the front
+    {
+        numberOfSamples += firstSample;
+        firstSample = 0;
+    }
+
+    if (numberOfSamples <= 0)
+        return SampleView(nullptr, 0, firstSample);
+
+    std::size_t begin = firstSample, end = begin + numberOfSamples;
+
+    if (end - begin > _capacity)
+    {
+        WARNING << "Requested audio window of " << (end - begin) / samplesPerMillisecond << " ms exceeds the buffer, trimming it";
+        end = begin + _capacity;
+    }
+
+    fill(end, begin);
+
+    if (begin < _firstBuffered)
+    {
+        DEBUG << "Samples before " << _firstBuffered << " are already discarded, trimming the window";
+        begin = _firstBuffered;
+    }
+
+    end = std::min(end, _samplesRead);
+
+    if (begin >= end)
+        return SampleView(nullptr, 0, firstSample);
+
+    //peek : skip to the window, read it and move back so that nothing is consumed
+    std::size_t offset = begin - _firstBuffered, count = end - begin;
+    void *data = nullptr;
+
+    WebRtc_MoveReadPtr(_ringBuffer, (int)offset);
+    WebRtc_ReadBuffer(_ringBuffer, &data, _window.data(), count);   //points into the ring unless the window wraps
+    WebRtc_MoveReadPtr(_ringBuffer, -(int)(offset + count));
+
+    return SampleView(static_cast<const int16_t *>(data), count, begin);
+}
+
+SampleStream::~SampleStream()
+{
+    if (_ringBuffer != nullptr)
+        WebRtc_FreeBuffer(_ringBuffer);
+}
@@ -0,0 +1,41 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_SAMPLE_STREAM_H
+#define CCALIGNER_SAMPLE_STREAM_H
+
+#include "read_wav_file.h"
+
+struct RingBuffer;
+
+class SampleStream : public SampleSource    //audio read on demand, only a sliding window of it is kept in memory
+{
+    std::ifstream _fileStream;              //when reading from a file on disk
+    std::unique_ptr<WaveStreamReader> _reader;
+    RingBuffer * _ringBuffer;               //the most recent samples, [_firstBuffered, _samplesRead) of the audio
+    std::size_t _capacity;
+    std::size_t _firstBuffered, _samplesRead;
+    std::vector<int16_t> _block;            //samples read from the stream, on their way to the ring buffer
+    std::vector<int16_t> _window;           //windows which wrap around the end of the ring buffer are copied here
+    bool _endOfStream;
+
+    void open(std::istream& stream, bool isRawFile);
+    void fill(std::size_t upto, std::size_t keepFrom);  //read till sample 'upto', discarding old samples but none after 'keepFrom'
+
+public:
+    SampleStream(const std::string& fileName, bool isRawFile, std::size_t capacity);   //read from file on disk
+    SampleStream(std::istream& stream, bool isRawFile, std::size_t capacity);         //read from stream/pipe
+    SampleStream(const SampleStream&) = delete;
+    SampleStream& operator=(const SampleStream&) = delete;
+
+    //windows should be requested in (mostly) increasing order; a view is valid only till the next request
+    SampleView getSamples(long int firstSample, long int numberOfSamples) override;
+
+    std::size_t capacity() const noexcept { return _capacity; }
+    ~SampleStream();
+};
+
+#endif //CCALIGNER_SAMPLE_STREAM_H
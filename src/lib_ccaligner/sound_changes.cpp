@@ -0,0 +1,533 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "sound_changes.h"
+#include <cwctype>
+#include <map>
+
+namespace {
+    const int maximumGroups = 9;
+
+    std::size_t atomEnd(const std::wstring& pattern, std::size_t at)    //one past the atom beginning at at
+    {
+        if (pattern[at] == L'\\')
+            return at + 2;
+
+        if (pattern[at] == L'[')
+        {
+            for (at++; at < pattern.size() && pattern[at] != L']'; at++)
+                if (pattern[at] == L'\\')
+                    at++;
+
+            return at + 1;
+        }
+
+        if (pattern[at] == L'(')
+        {
+            int depth = 0;
+
+            for (; at < pattern.size(); at++)
+            {
+                if (pattern[at] == L'\\')
+                    at++;
+                else if (pattern[at] == L'[')
+                    at = atomEnd(pattern, at) - 1;
+                else if (pattern[at] == L'(')
+                    depth++;
+                else if (pattern[at] == L')' && --depth == 0)
+                    return at + 1;
+            }
+
+            return at;
+        }
+
+        return at + 1;
+    }
+
+    int groupNumber(const std::wstring& pattern, std::size_t at)    //number of the capturing group opened at at
+    {
+        int number = 0;
+
+        for (std::size_t i = 0; i <= at; i++)
+        {
+            if (pattern[i] == L'\\')
+                i++;
+            else if (pattern[i] == L'[')
+                i = atomEnd(pattern, i) - 1;
+            else if (pattern[i] == L'(' && pattern.compare(i, 3, L"(?:") != 0)
+                number++;
+        }
+
+        return number;
+    }
+}
+
+SoundChange::SoundChange(const std::wstring& pattern, const std::wstring& replacement)
+    : _requiredClasses(),
+    _requiredPairs(),
+    _anchored(true),
+    _numberOfGroups(0),
+    _previous(-1) {
+
+    if (!pattern.empty())
+        _numberOfGroups = groupNumber(pattern, pattern.size() - 1);
+
+    if (_numberOfGroups > maximumGroups)
+        FATAL(InvalidParameters) << "Sound change rule has more than " << maximumGroups << " groups";
+
+    _program.push_back({Instruction::Save, 0, 0});
+
+    std::size_t at = 0;
+    compile(pattern, at, 0);
+
+    if (at != pattern.size())
+        FATAL(InvalidParameters) << "Unbalanced ) at position " << at << " of sound change rule";
+
+    _program.push_back({Instruction::Save, 1, 0});
+    _program.push_back({Instruction::Match, 0, 0});
+
+    //symbols that may begin a match, following every branch until something is consumed
+    std::vector<std::pair<int, bool>> pending(1, std::make_pair(0, false));
+    std::vector<bool> seen(_program.size() * 2);
+
+    while (!pending.empty())
+    {
+        int pc = pending.back().first;
+        bool afterBegin = pending.back().second;
+        pending.pop_back();
+
+        if (seen[pc * 2 + afterBegin])
+            continue;
+
+        seen[pc * 2 + afterBegin] = true;
+        const Instruction& instruction = _program[pc];
+
+        switch (instruction.op)
+        {
+            case Instruction::Symbol:
+                _first |= _sets[instruction.x];
+                _anchored = _anchored && afterBegin;
+                break;
+
+            case Instruction::Split:
+                pending.emplace_back(instruction.x, afterBegin);
+                pending.emplace_back(instruction.y, afterBegin);
+                break;
+
+            case Instruction::Begin:
+                pending.emplace_back(pc + 1, true);
+                break;
+
+            case Instruction::Save:
+            case Instruction::End:
+                pending.emplace_back(pc + 1, afterBegin);
+                break;
+
+            case Instruction::Match:    //regex_replace steps over empty matches, which is not done here
+                FATAL(InvalidParameters) << "Sound change rule can match nothing";
+        }
+    }
+
+    parseFormat(replacement);
+}
+
+void SoundChange::compile(const std::wstring& pattern, std::size_t& at, int optional)
+{
+    while (at < pattern.size() && pattern[at] != L')')
+    {
+        std::size_t end = atomEnd(pattern, at);
+
+        if (end > pattern.size())
+            FATAL(InvalidParameters) << "Unterminated atom at position " << at << " of sound change rule";
+
+        if (end < pattern.size() && pattern[end] == L'?')
+        {
+            std::size_t split = _program.size();
+            _program.push_back({Instruction::Split, static_cast<int>(split + 1), 0});
+
+            emitAtom(pattern, at, optional + 1);
+            _program[split].y = static_cast<int>(_program.size());
+            _previous = -1;
+            at = end + 1;
+        }
+
+        else if (end < pattern.size() && pattern[end] == L'{')
+        {
+            std::size_t close = pattern.find(L'}', end);
+
+            if (close == std::wstring::npos || close == end + 1 || pattern.find_first_not_of(L"0123456789", end + 1) != close)
+                FATAL(InvalidParameters) << "Only {n} repetitions are supported, at position " << end << " of sound change rule";
+
+            int count = std::stoi(pattern.substr(end + 1, close - end - 1));
+
+            for (int i = 0; i < count; i++)
+            {
+                std::size_t again = at;
+                emitAtom(pattern, again, optional);
+            }
+
+            at = close + 1;
+        }
+
+        else
+            emitAtom(pattern, at, optional);
+
+        if (at < pattern.size() && (pattern[at] == L'?' || pattern[at] == L'{' || pattern[at] == L'*' || pattern[at] == L'+'))
+            FATAL(InvalidParameters) << "Unsupported quantifier at position " << at << " of sound change rule";
+    }
+}
+
+void SoundChange::emitAtom(const std::wstring& pattern, std::size_t& at, int optional)
+{
+    wchar_t c = pattern[at];
+    SymbolSet set;
+
+    switch (c)
+    {
+        case L'^':
+            _program.push_back({Instruction::Begin, 0, 0});
+            _previous = -1;
+            at++;
+            return;
+
+        case L'$':
+            _program.push_back({Instruction::End, 0, 0});
+            _previous = -1;
+            at++;
+            return;
+
+        case L'(':
+        {
+            bool capturing = pattern.compare(at, 3, L"(?:") != 0;
+            int group = capturing ? groupNumber(pattern, at) : 0;
+
+            if (!capturing)
+                at += 3;
+            else
+            {
+                _program.push_back({Instruction::Save, group * 2, 0});
+                at++;
+            }
+
+            compile(pattern, at, optional);
+
+            if (at >= pattern.size())
+                FATAL(InvalidParameters) << "Unbalanced ( in sound change rule";
+
+            at++;
+
+            if (capturing)
+                _program.push_back({Instruction::Save, group * 2 + 1, 0});
+
+            return;
+        }
+
+        case L'[':
+        {
+            bool negated = pattern[at + 1] == L'^';
+            at += negated ? 2 : 1;
+
+            while (pattern[at] != L']')
+            {
+                wchar_t low = pattern[at] == L'\\' ? pattern[++at] : pattern[at];
+                wchar_t high = low;
+                at++;
+
+                if (pattern[at] == L'-' && pattern[at + 1] != L']')
+                {
+                    high = pattern[at + 1] == L'\\' ? pattern[at + 2] : pattern[at + 1];
+                    at += pattern[at + 1] == L'\\' ? 3 : 2;
+                }
+
+                if (symbol(low) == 256 || symbol(high) == 256)
+                    FATAL(InvalidParameters) << "Sound change rules can only name Latin-1 characters";
+
+                for (std::size_t s = symbol(low); s <= symbol(high); s++)
+                    set.set(s);
+            }
+
+            at++;
+
+            if (negated)
+                set.flip();
+
+            break;
+        }
+
+        case L'\\':
+            set.set(symbol(pattern[at + 1]));
+            at += 2;
+            break;
+
+        case L'.': case L'*': case L'+': case L'?': case L'{': case L'}': case L'|': case L']': case L')':
+            FATAL(InvalidParameters) << "Unsupported syntax at position " << at << " of sound change rule";
+
+        default:
+            if (symbol(c) == 256)
+                FATAL(InvalidParameters) << "Sound change rules can only name Latin-1 characters";
+
+            set.set(symbol(c));
+            at++;
+    }
+
+    _program.push_back({Instruction::Symbol, static_cast<int>(_sets.size()), 0});
+    _sets.push_back(set);
+
+    if (optional == 0)
+    {
+        if (_previous >= 0)
+            _adjacent.emplace_back(_sets[_previous], set);
+
+        _required.push_back(set);
+        _previous = static_cast<int>(_sets.size()) - 1;
+    }
+}
+
+void SoundChange::parseFormat(const std::wstring& replacement)
+{
+    _format.emplace_back(-1, L"");
+
+    for (std::size_t i = 0; i < replacement.size(); i++)
+    {
+        if (replacement[i] != L'$')
+        {
+            _format.back().second += replacement[i];
+            continue;
+        }
+
+        if (i + 1 < replacement.size() && replacement[i + 1] == L'$')
+        {
+            _format.back().second += L'$';
+            i++;
+        }
+
+        else if (i + 1 < replacement.size() && std::iswdigit(replacement[i + 1]))
+        {
+            //like regex_replace, up to two digits are read
+            int group = replacement[++i] - L'0';
+
+            if (i + 1 < replacement.size() && std::iswdigit(replacement[i + 1]))
+                group = group * 10 + (replacement[++i] - L'0');
+
+            _format.emplace_back(group <= _numberOfGroups ? group : -1, L"");
+        }
+
+        else
+            FATAL(InvalidParameters) << "Only $n and $$ are supported in the replacement of a sound change rule";
+    }
+}
+
+bool SoundChange::run(int pc, std::size_t pos, const std::wstring& word, int *saves) const
+{
+    for (;;)
+    {
+        const Instruction& instruction = _program[pc];
+
+        switch (instruction.op)
+        {
+            case Instruction::Symbol:
+                if (pos == word.size() || !_sets[instruction.x][symbol(word[pos])])
+                    return false;
+
+                pos++;
+                pc++;
+                break;
+
+            case Instruction::Split:
+            {
+                int preferred[(maximumGroups + 1) * 2];
+                std::copy(saves, saves + (_numberOfGroups + 1) * 2, preferred);
+
+                if (run(instruction.x, pos, word, preferred))
+                {
+                    std::copy(preferred, preferred + (_numberOfGroups + 1) * 2, saves);
+                    return true;
+                }
+
+                pc = instruction.y;
+                break;
+            }
+
+            case Instruction::Save:
+                saves[instruction.x] = static_cast<int>(pos);
+                pc++;
+                break;
+
+            case Instruction::Begin:
+                if (pos != 0)
+                    return false;
+
+                pc++;
+                break;
+
+            case Instruction::End:
+                if (pos != word.size())
+                    return false;
+
+                pc++;
+                break;
+
+            case Instruction::Match:
+                return true;
+        }
+    }
+}
+
+void SoundChange::classify(const Classes& classes)
+{
+    auto classesOf = [&classes](const SymbolSet& set) {
+        uint64_t mask = 0;
+
+        for (std::size_t s = 0; s < alphabetSize; s++)
+            if (set[s])
+                mask |= uint64_t(1) << classes[s];
+
+        return mask;
+    };
+
+    //fewest bits set rule out the most words
+    auto mostSelective = [](std::vector<uint64_t> masks, uint64_t *selected, std::size_t size) {
+        std::sort(masks.begin(), masks.end(), [](uint64_t a, uint64_t b) { return std::bitset<64>(a).count() < std::bitset<64>(b).count(); });
+
+        for (std::size_t i = 0; i < size; i++)
+            selected[i] = i < masks.size() ? masks[i] : 0;
+    };
+
+    std::vector<uint64_t> required, pairs;
+
+    for (const SymbolSet& set : _required)
+        required.push_back(classesOf(set));
+
+    for (const auto& adjacent : _adjacent)
+    {
+        uint64_t firsts = classesOf(adjacent.first), seconds = classesOf(adjacent.second), mask = 0;
+
+        for (uint8_t first = 0; first < 64; first++)
+            for (uint8_t second = 0; second < 64; second++)
+                if ((firsts >> first & 1) && (seconds >> second & 1))
+                    mask |= pair(first, second);
+
+        pairs.push_back(mask);
+    }
+
+    mostSelective(required, _requiredClasses.data(), _requiredClasses.size());
+    mostSelective(pairs, _requiredPairs.data(), _requiredPairs.size());
+}
+
+bool SoundChange::apply(std::wstring& word) const
+{
+    std::wstring result;
+    std::size_t copied = 0, start = 0;
+    int saves[(maximumGroups + 1) * 2];
+    bool matched = false;
+
+    while (start < word.size())
+    {
+        std::size_t pos = start;
+
+        for (; pos < word.size() && !(_anchored && pos > 0); pos++)
+        {
+            if (!_first[symbol(word[pos])])
+                continue;
+
+            std::fill(saves, saves + (_numberOfGroups + 1) * 2, -1);
+
+            if (run(0, pos, word, saves))
+                break;
+        }
+
+        if (pos >= word.size() || (_anchored && pos > 0))
+            break;
+
+        matched = true;
+        result.append(word, copied, saves[0] - copied);
+
+        for (const auto& piece : _format)
+        {
+            if (piece.first >= 0 && saves[piece.first * 2] >= 0 && saves[piece.first * 2 + 1] >= 0)
+                result.append(word, saves[piece.first * 2], saves[piece.first * 2 + 1] - saves[piece.first * 2]);
+
+            result += piece.second;
+        }
+
+        copied = start = static_cast<std::size_t>(saves[1]);
+    }
+
+    if (!matched)
+        return false;
+
+    result.append(word, copied, std::wstring::npos);
+
+    bool changed = result != word;
+    word.swap(result);
+    return changed;
+}
+
+SoundChanges::SoundChanges(const std::vector<std::pair<std::wstring, std::wstring>>& rules)
+{
+    _rules.reserve(rules.size());
+
+    for (const auto& rule : rules)
+        _rules.emplace_back(rule.first, rule.second);
+
+    //symbols in the same sets of every rule are one class, a word is then described by 64 bits
+    std::map<std::vector<bool>, uint8_t> signatures;
+
+    for (std::size_t s = 0; s < SoundChange::alphabetSize; s++)
+    {
+        std::vector<bool> signature;
+
+        for (const SoundChange& rule : _rules)
+            for (const SoundChange::SymbolSet& set : rule.sets())
+                signature.push_back(set[s]);
+
+        auto found = signatures.emplace(signature, static_cast<uint8_t>(signatures.size()));
+        _classes[s] = found.first->second;
+    }
+
+    if (signatures.size() > 64)
+        FATAL(InvalidParameters) << "Sound change rules tell apart " << signatures.size() << " classes of characters, at most 64 are supported";
+
+    for (SoundChange& rule : _rules)
+        rule.classify(_classes);
+}
+
+std::wstring SoundChanges::apply(std::wstring word) const
+{
+    uint64_t present = 0, pairs = 0;
+
+    auto describe = [&](const std::wstring& word) {
+        present = pairs = 0;
+
+        for (std::size_t i = 0; i < word.size(); i++)
+        {
+            uint8_t current = _classes[SoundChange::symbol(word[i])];
+            present |= uint64_t(1) << current;
+
+            if (i > 0)
+                pairs |= SoundChange::pair(_classes[SoundChange::symbol(word[i - 1])], current);
+        }
+    };
+
+    describe(word);
+
+    for (const SoundChange& rule : _rules)
+    {
+        if (!rule.possible(present, pairs))
+            continue;
+
+        // Repeatedly apply rule until there is no more change
+        bool changed = false;
+
+        while (rule.apply(word))
+            changed = true;
+
+        if (changed)
+            describe(word);
+    }
+
+    return word;
+}
@@ -0,0 +1,92 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_SOUND_CHANGES_H
+#define CCALIGNER_SOUND_CHANGES_H
+
+#include "commons.h"
+#include <array>
+#include <bitset>
+
+/*
+ * Sound change rules compiled once, instead of running them as std::wregex.
+ *
+ * A rule is written as an ECMAScript regex and a regex_replace format, restricted to what g2p_rules.cpp uses :
+ * literals, classes [..] and [^..], capturing and (?:..) groups, the quantifiers ? and {n}, the anchors ^ and $,
+ * \ escapes, and $n / $$ in the replacement. Patterns are matched over Latin-1, every other character is one
+ * symbol that no pattern can name. Each rule becomes a small program of symbol sets, splits and captures, run
+ * with the priorities of ECMAScript, so it replaces exactly what regex_replace would.
+ */
+
+class SoundChange   //one rule
+{
+public:
+    static const std::size_t alphabetSize = 257;    //Latin-1 and everything else
+    typedef std::bitset<alphabetSize> SymbolSet;
+    typedef std::array<uint8_t, alphabetSize> Classes; //of every symbol, symbols no rule tells apart share one
+
+    static std::size_t symbol(wchar_t c) noexcept { return static_cast<std::size_t>(c) < 256 ? static_cast<std::size_t>(c) : 256; }
+
+private:
+    struct Instruction
+    {
+        enum Op { Symbol, Split, Save, Begin, End, Match } op;
+        int x, y;           //set of Symbol, preferred and other branch of Split, slot of Save
+    };
+
+    std::vector<Instruction> _program;
+    std::vector<SymbolSet> _sets;
+    std::vector<SymbolSet> _required;                   //a symbol of each must be in the word for a match
+    std::vector<std::pair<SymbolSet, SymbolSet>> _adjacent; //and a symbol of the first followed by one of the second
+    std::array<uint64_t, 3> _requiredClasses;           //the most selective of them, as classes, 0 if unused
+    std::array<uint64_t, 2> _requiredPairs;             //and as hashed pairs of classes
+    std::vector<std::pair<int, std::wstring>> _format;  //group to insert, or -1, followed by literal text
+    SymbolSet _first;                                   //symbols a match can begin with
+    bool _anchored;                                     //matches only at the beginning of the word
+    int _numberOfGroups;
+
+    int _previous;                                      //mandatory set the next one follows, while compiling
+
+    void compile(const std::wstring& pattern, std::size_t& at, int optional);     //a sequence, up to ) or the end
+    void emitAtom(const std::wstring& pattern, std::size_t& at, int optional);
+    void parseFormat(const std::wstring& replacement);
+    bool run(int pc, std::size_t pos, const std::wstring& word, int *saves) const;
+
+public:
+    SoundChange(const std::wstring& pattern, const std::wstring& replacement);
+
+    const std::vector<SymbolSet>& sets() const noexcept { return _sets; }
+    void classify(const Classes& classes);              //at most 64 classes
+    static uint64_t pair(uint8_t first, uint8_t second) noexcept { return uint64_t(1) << ((first * 7u + second) % 64); }
+
+    //could match a word with symbols of these classes, following each other as in these pairs
+    bool possible(uint64_t present, uint64_t pairs) const noexcept
+    {
+        for (uint64_t required : _requiredClasses)
+            if (required != 0 && (required & present) == 0)
+                return false;
+
+        for (uint64_t required : _requiredPairs)
+            if (required != 0 && (required & pairs) == 0)
+                return false;
+
+        return true;
+    }
+    bool apply(std::wstring& word) const;               //replace every match once, true if the word changed
+};
+
+class SoundChanges  //rules applied in order, each until it changes nothing more
+{
+    std::vector<SoundChange> _rules;
+    SoundChange::Classes _classes;
+
+public:
+    explicit SoundChanges(const std::vector<std::pair<std::wstring, std::wstring>>& rules);
+
+    std::wstring apply(std::wstring word) const;
+};
+
+#endif //CCALIGNER_SOUND_CHANGES_H
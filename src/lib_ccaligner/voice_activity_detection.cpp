@@ -5,38 +5,236 @@
 */
 
 #include "voice_activity_detection.h"
+#include "commons.h"
 
-void performVAD(std::vector<int16_t>& sample)
+#include <algorithm>
+#include <mutex>
+
+static VadInst * createVad(int aggressiveness)
 {
-    VadInst* vad = WebRtcVad_Create();  //Creating VAD handle
+    static std::mutex creation;     //creating a handle sets up the global function table of webRTC's signal processing
+    VadInst *vad;
+
+    {
+        std::lock_guard<std::mutex> lock(creation);
+        vad = WebRtcVad_Create();
+    }
+
     if (!vad)
+        FATAL(UnknownError) << "Can't create WebRTC VAD handle.";
+
+    if (WebRtcVad_Init(vad))
+    {
+        WebRtcVad_Free(vad);
+        FATAL(UnknownError) << "Can't initialize WebRTC VAD handle.";
+    }
+
+    if (WebRtcVad_set_mode(vad, aggressiveness))
     {
-        throw std::runtime_error("Can't create WebRTC VAD handle.");
+        WebRtcVad_Free(vad);
+        FATAL(InvalidParameters) << "Can't set WebRTC VAD aggressiveness to " << aggressiveness << ", it should be from 0 to 3.";
     }
 
-    int error = WebRtcVad_Init(vad);    //Initializing VAD handle
-    if (error)
+    return vad;
+}
+
+VoiceActivityDetector::VoiceActivityDetector(const VadOptions& options)
+    : _vad(nullptr),
+      _frameSamples(options.frameLength * samplesPerMillisecond),
+      _hangoverSamples(options.hangover * samplesPerMillisecond),
+      _minimumSpeechSamples(options.minimumSpeech * samplesPerMillisecond),
+      _paddingSamples(options.padding * samplesPerMillisecond),
+      _maxSegmentSamples(options.maximumSegment * samplesPerMillisecond),
+      _started(false),
+      _samplesSeen(0),
+      _previousSegmentEnd(0),
+      _segmentStart(0),
+      _lastVoicedEnd(0),
+      _lastPauseEnd(-1),
+      _voicedSamples(0),
+      _inSpeech(false)
+{
+    if (WebRtcVad_ValidRateAndFrameLength(16000, _frameSamples) != 0)
+        FATAL(InvalidParameters) << "WebRTC VAD classifies frames of 10, 20 or 30 ms, not " << options.frameLength << " ms.";
+
+    if (_maxSegmentSamples > 0)
+        _maxSegmentSamples = std::max(_maxSegmentSamples, 2 * _frameSamples);
+
+    _vad = createVad(options.aggressiveness);
+    _frame.reserve(_frameSamples);
+}
+
+VoiceActivityDetector::~VoiceActivityDetector()
+{
+    WebRtcVad_Free(_vad);
+}
+
+void VoiceActivityDetector::close(long int end)
+{
+    if (end > _segmentStart && _voicedSamples >= _minimumSpeechSamples)
     {
-        throw std::runtime_error("Can't initialize WebRTC VAD handle.");
+        _segments.push_back({_segmentStart, end - _segmentStart});
+        _previousSegmentEnd = std::max(_previousSegmentEnd, end);
     }
 
-    const int aggressiveness = 2;       //Aggressiveness : 1/2/3 . Higher means higher cut-off.
-    error = WebRtcVad_set_mode(vad, aggressiveness);
-    if (error)
+    _inSpeech = false;
+}
+
+void VoiceActivityDetector::classify(const int16_t *frame, long int frameStart)
+{
+    long int frameEnd = frameStart + _frameSamples;
+    int isActive = WebRtcVad_Process(_vad, 16000, frame, _frameSamples);
+
+    if (isActive < 0)
+        FATAL(UnknownError) << "WebRTC VAD failed to classify the frame at " << frameStart / samplesPerMillisecond << " ms";
+
+    if (isActive)
     {
-        throw std::runtime_error("Can't set WebRTC VAD aggressiveness.");
+        if (!_inSpeech)
+        {
+            _inSpeech = true;
+            _segmentStart = std::max(_previousSegmentEnd, frameStart - _paddingSamples);
+            _lastPauseEnd = -1;
+            _voicedSamples = 0;
+        }
+
+        _lastVoicedEnd = frameEnd;
+        _voicedSamples += _frameSamples;
     }
 
-    const int16_t * temp = sample.data();   //16 bit ,16KHz, mono PCM samples
+    else if (_inSpeech)
+    {
+        _lastPauseEnd = frameEnd;
+
+        if (frameEnd - _lastVoicedEnd >= _hangoverSamples)
+        {
+            close(std::min(_lastVoicedEnd + _paddingSamples, frameEnd));
+            return;
+        }
+    }
 
-    for(int i=0, ms =0;i<sample.size();i+=160, ms+=10)  // currently checking in 10ms frames, most likely to change
+    if (_inSpeech && _maxSegmentSamples > 0 && frameEnd - _segmentStart >= _maxSegmentSamples)
     {
-        int isActive = WebRtcVad_Process(vad, 16000, temp, 160);    // 1 = voice , 0 = not voice
-        std::cout<<ms<<" ms : "<<isActive<<std::endl;
-        temp = temp + 160;
+        long int cut = _lastPauseEnd > _segmentStart + _maxSegmentSamples / 2 ? _lastPauseEnd : frameEnd;
 
+        close(cut);
+        _inSpeech = true;   //the rest of it goes on as the next segment
+        _segmentStart = std::max(cut, _previousSegmentEnd);
+        _lastPauseEnd = -1;
+        _voicedSamples = 0;
     }
+}
+
+std::vector<SpeechSegment> VoiceActivityDetector::process(const SampleView& samples)
+{
+    if (!_started)      //positions follow those of the views
+    {
+        _started = true;
+        _samplesSeen = _previousSegmentEnd = samples.firstSample();
+    }
+
+    const int16_t *data = samples.data();
+    std::size_t remaining = samples.size();
+
+    while (remaining > 0)
+    {
+        if (_frame.empty() && remaining >= (std::size_t) _frameSamples)    //whole frames are classified in place
+        {
+            classify(data, _samplesSeen);
+            data += _frameSamples;
+            remaining -= _frameSamples;
+            _samplesSeen += _frameSamples;
+            continue;
+        }
+
+        std::size_t taken = std::min(remaining, (std::size_t) _frameSamples - _frame.size());
+        _frame.insert(_frame.end(), data, data + taken);
+        data += taken;
+        remaining -= taken;
+        _samplesSeen += taken;
+
+        if (_frame.size() == (std::size_t) _frameSamples)
+        {
+            classify(_frame.data(), _samplesSeen - _frameSamples);
+            _frame.clear();
+        }
+    }
+
+    std::vector<SpeechSegment> completed;
+    completed.swap(_segments);
+    return completed;
+}
+
+std::vector<SpeechSegment> VoiceActivityDetector::finish()
+{
+    if (_inSpeech)      //a partial frame at the end is never classified, it only pads the last segment
+        close(std::min(_lastVoicedEnd + _paddingSamples, _samplesSeen));
+
+    std::vector<SpeechSegment> completed;
+    completed.swap(_segments);
+    return completed;
+}
+
+long int VoiceActivityDetector::keepFrom() const noexcept
+{
+    if (_inSpeech)
+        return _segmentStart;
+
+    long int nextFrameStart = _samplesSeen - (long int) _frame.size();
+    return std::max(_previousSegmentEnd, nextFrameStart - _paddingSamples);
+}
+
+std::vector<SpeechSegment> detectSpeech(const SampleView& window, const VadOptions& options)
+{
+    VoiceActivityDetector detector(options);
+    std::vector<SpeechSegment> segments = detector.process(window), last = detector.finish();
+
+    segments.insert(segments.end(), last.begin(), last.end());
+    return segments;
+}
+
+SpeechTracker::SpeechTracker(SampleSource& source, const VadOptions& options)
+    : _source(source), _detector(options), _fed(0)
+{
+}
+
+SampleView SpeechTracker::getSamples(long int firstSample, long int numberOfSamples)
+{
+    SampleView samples = _source.getSamples(firstSample, numberOfSamples);
+    long int first = samples.firstSample(), end = first + samples.size();
+
+    if (first <= _fed && end > _fed)    //only what follows the samples fed already, read again or skipped ones are not
+    {
+        std::vector<SpeechSegment> completed = _detector.process(SampleView(samples.data() + (_fed - first), end - _fed, _fed));
+        _speech.insert(_speech.end(), completed.begin(), completed.end());
+        _fed = end;
+    }
+
+    return samples;
+}
+
+std::vector<SpeechSegment> SpeechTracker::finish()
+{
+    std::vector<SpeechSegment> last = _detector.finish();
+    _speech.insert(_speech.end(), last.begin(), last.end());
+    return std::move(_speech);
+}
+
+SpeechSegment speechWithin(const std::vector<SpeechSegment>& speech, long int firstSample, long int endSample)
+{
+    auto first = std::lower_bound(speech.begin(), speech.end(), firstSample, [](const SpeechSegment& segment, long int sample) {
+        return segment.firstSample + segment.numberOfSamples <= sample;
+    });
+
+    auto last = first;
+
+    while (last != speech.end() && last->firstSample < endSample)
+        ++last;
 
-    WebRtcVad_Free(vad);
+    if (first == last)
+        return {firstSample, 0};
 
+    long int start = std::max(firstSample, first->firstSample);
+    long int end = std::min(endSample, (last - 1)->firstSample + (last - 1)->numberOfSamples);
+    return {start, end - start};
 }
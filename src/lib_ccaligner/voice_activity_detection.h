@@ -7,7 +7,73 @@
 
 #include "read_wav_file.h"
 #include <webrtc/common_audio/vad/include/webrtc_vad.h>
+#include <vector>
 
-void performVAD(std::vector<int16_t>& sample);  //use webRTC's VAD to check if a window of sample has voice.
+struct SpeechSegment    //samples [firstSample, firstSample + numberOfSamples) of the audio
+{
+    long int firstSample, numberOfSamples;
+};
+
+struct VadOptions       //all lengths in ms
+{
+    int aggressiveness;             //0 to 3, higher is quicker to call a frame non speech
+    long int frameLength;           //10, 20 or 30, frames webRTC's VAD classifies
+    long int hangover;              //without voice before speech ends, shorter pauses are merged into it
+    long int minimumSpeech;         //of voice a segment needs, shorter bursts are taken as noise
+    long int padding;               //of non speech kept on both sides of speech
+    long int maximumSegment;        //longer speech is cut, at its latest pause if it has one; 0 for no limit
+
+    VadOptions() noexcept
+        : aggressiveness(2), frameLength(30), hangover(300), minimumSpeech(90), padding(200), maximumSegment(0) {}
+};
+
+/*
+ * Splits audio into segments of speech using webRTC's VAD. Samples are fed in order, window after window, and
+ * segments are returned as soon as they are complete, positioned like the views fed; the non speech lies between
+ * them. Each instance has its own VAD handle, so workers may run one each in parallel.
+ */
+
+class VoiceActivityDetector
+{
+    VadInst * _vad;
+    long int _frameSamples, _hangoverSamples, _minimumSpeechSamples, _paddingSamples, _maxSegmentSamples;
+    std::vector<int16_t> _frame;            //samples of a frame not yet complete
+    bool _started;                          //whether samples were fed yet
+    long int _samplesSeen, _previousSegmentEnd;
+    long int _segmentStart, _lastVoicedEnd, _lastPauseEnd, _voicedSamples;  //of the segment open while _inSpeech
+    bool _inSpeech;
+    std::vector<SpeechSegment> _segments;   //closed, not yet returned
+
+    void classify(const int16_t *frame, long int frameStart);
+    void close(long int end);
+
+public:
+    explicit VoiceActivityDetector(const VadOptions& options = VadOptions());
+    VoiceActivityDetector(const VoiceActivityDetector&) = delete;
+    VoiceActivityDetector& operator=(const VoiceActivityDetector&) = delete;
+    ~VoiceActivityDetector();
+
+    std::vector<SpeechSegment> process(const SampleView& samples);  //samples following the previous ones, returns the segments they complete
+    std::vector<SpeechSegment> finish();                            //end of audio, returns the segment still open
+    long int keepFrom() const noexcept;     //first sample a segment not yet returned may contain
+};
+
+class SpeechTracker : public SampleSource  //serves the samples of another source, finding the speech in them as they are read in order
+{
+    SampleSource& _source;
+    VoiceActivityDetector _detector;
+    long int _fed;                          //samples before it were fed to the detector
+    std::vector<SpeechSegment> _speech;
+
+public:
+    SpeechTracker(SampleSource& source, const VadOptions& options = VadOptions());
+    SampleView getSamples(long int firstSample, long int numberOfSamples) override;
+    std::vector<SpeechSegment> finish();    //speech in all samples read
+};
+
+std::vector<SpeechSegment> detectSpeech(const SampleView& window, const VadOptions& options = VadOptions());  //speech of a complete window
+
+//span from the first to the last speech in samples [firstSample, endSample), clamped to them; empty if there is none
+SpeechSegment speechWithin(const std::vector<SpeechSegment>& speech, long int firstSample, long int endSample);
 
 #endif //VOICE_ACTIVITY_DETECTION_H
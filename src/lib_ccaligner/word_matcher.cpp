@@ -0,0 +1,222 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "word_matcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+const std::size_t WordPattern::maxLength;
+
+int levenshtein_distance(const std::string &firstWord, const std::string &secondWord) {
+    const std::string &shorter = firstWord.size() < secondWord.size() ? firstWord : secondWord;
+    const std::string &longer = &shorter == &firstWord ? secondWord : firstWord;
+
+    WordPattern pattern;
+
+    if (pattern.assign(shorter))
+        return pattern.distance(longer);
+
+    const unsigned long int length1 = firstWord.size();
+    const unsigned long int length2 = secondWord.size();
+
+    std::vector<int> currentColumn(length2 + 1);
+    std::vector<int> previousColumn(length2 + 1);
+
+    for (int index2 = 0; index2 < length2 + 1; ++index2) {
+        previousColumn[index2] = index2;
+    }
+
+    for (int index1 = 0; index1 < length1; ++index1) {
+        currentColumn[0] = index1 + 1;
+
+        for (int index2 = 0; index2 < length2; ++index2) {
+            const int compare = firstWord[index1] == secondWord[index2] ? 0 : 1;
+
+            currentColumn[index2 + 1] = std::min(std::min(currentColumn[index2] + 1, previousColumn[index2 + 1] + 1), previousColumn[index2] + compare);
+        }
+
+        currentColumn.swap(previousColumn);
+    }
+
+    return previousColumn[length2];
+}
+
+WordPattern::WordPattern() noexcept : _word(nullptr)
+{
+    std::memset(_masks, 0, sizeof(_masks));
+}
+
+bool WordPattern::assign(const std::string& word) noexcept
+{
+    if (_word != nullptr)  //only the characters of the previous word are set
+    {
+        for (unsigned char character : *_word)
+            _masks[character] = 0;
+    }
+
+    _word = nullptr;
+
+    if (word.size() > maxLength)
+        return false;
+
+    for (std::size_t i = 0; i < word.size(); i++)
+        _masks[static_cast<unsigned char>(word[i])] |= uint64_t(1) << i;
+
+    _word = &word;
+    return true;
+}
+
+int WordPattern::distance(const std::string& text) const noexcept
+{
+    /*
+     * Myers' algorithm, as formulated by Hyyrö : the vertical (Pv, Mv) and horizontal (Ph, Mh) differences of a
+     * column of the edit distance matrix are kept as bit vectors, one bit per character of the word, so a column
+     * is computed in a few word operations. The last row is tracked in score.
+     */
+
+    const std::size_t length = _word->size();
+
+    if (length == 0)
+        return static_cast<int>(text.size());
+
+    const uint64_t lastRow = uint64_t(1) << (length - 1);
+    uint64_t pv = ~uint64_t(0), mv = 0;
+    int score = static_cast<int>(length);
+
+    for (unsigned char character : text)
+    {
+        uint64_t eq = _masks[character];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        if (ph & lastRow)
+            score++;
+        else if (mh & lastRow)
+            score--;
+
+        ph = (ph << 1) | 1;     //the first row grows by one with every character of text
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+
+    return score;
+}
+
+static bool isFillerWord(const std::string& recognisedWord)    //silence and noise, like <sil> and [BREATH]
+{
+    return recognisedWord.empty() || recognisedWord == "<s>" || recognisedWord == "</s>" || recognisedWord[0] == '[' || recognisedWord == "<sil>";
+}
+
+std::vector<int> matchWords(const std::vector<std::string>& words, const std::vector<std::string>& recognised, unsigned long searchWindow)
+{
+    const long numberOfWords = static_cast<long>(words.size()), numberOfRecognised = static_cast<long>(recognised.size());
+    const long reach = static_cast<long>(searchWindow) + 1;
+    const long matchScore = 1L << 16;   //more than any distance, a match always outweighs how well words agree
+
+    std::vector<int> matches(recognised.size(), -1);
+
+    if (numberOfWords == 0)
+        return matches;
+
+    struct Candidate
+    {
+        long recognisedIndex, wordIndex, score;
+        long previous;      //candidate matched before it, -1 if it is the first
+    };
+
+    std::vector<Candidate> candidates;
+
+    //best chain of candidates ending at dialogue word j, and ending at or before it, over the rows done so far
+    std::vector<long> endingScore(words.size(), 0), bestScore(words.size(), 0);
+    std::vector<long> endingCandidate(words.size(), -1), bestCandidate(words.size(), -1);
+    long knownUpTo = -1;    //bestScore is valid up to this word
+
+    WordPattern pattern;
+
+    for (long i = 0; i < numberOfRecognised; i++)
+    {
+        const std::string &recognisedWord = recognised[i];
+
+        if (isFillerWord(recognisedWord))
+            continue;
+
+        //the band of row i is around both its position and the diagonal, both of its ends only move right
+        const long diagonal = i * numberOfWords / numberOfRecognised;
+        const long first = std::max(0L, std::min(i, diagonal) - reach), last = std::min(numberOfWords - 1, std::max(i, diagonal) + reach);
+
+        if (first > last)
+            continue;
+
+        for (long j = knownUpTo + 1; j <= last; j++)
+        {
+            bestScore[j] = j > 0 ? bestScore[j - 1] : 0;
+            bestCandidate[j] = j > 0 ? bestCandidate[j - 1] : -1;
+        }
+
+        knownUpTo = std::max(knownUpTo, last);
+
+        const bool bitParallel = pattern.assign(recognisedWord);
+        const std::size_t rowBegins = candidates.size();
+
+        for (long j = first; j <= last; j++)
+        {
+            const std::string &word = words[j];
+            const std::size_t longer = std::max(word.size(), recognisedWord.size());
+            const std::size_t lengthDifference = longer - std::min(word.size(), recognisedWord.size());
+
+            if (lengthDifference * 4 >= longer)     //the distance is at least the difference of lengths
+                continue;
+
+            int distance = bitParallel ? pattern.distance(word) : levenshtein_distance(recognisedWord, word);
+
+            if (static_cast<std::size_t>(distance) * 4 >= longer)   //at least 75% must match
+                continue;
+
+            //chained only to candidates of earlier rows, each recognised word is matched once
+            long before = j > 0 ? bestScore[j - 1] : 0;
+            long previous = j > 0 ? bestCandidate[j - 1] : -1;
+            candidates.push_back({i, j, before + matchScore - distance, previous});
+        }
+
+        if (candidates.size() == rowBegins)
+            continue;
+
+        long updatedFrom = last + 1;
+
+        for (std::size_t c = rowBegins; c < candidates.size(); c++)
+        {
+            const Candidate &candidate = candidates[c];
+
+            if (candidate.score > endingScore[candidate.wordIndex])     //ties keep the earlier recognised word
+            {
+                endingScore[candidate.wordIndex] = candidate.score;
+                endingCandidate[candidate.wordIndex] = static_cast<long>(c);
+                updatedFrom = std::min(updatedFrom, candidate.wordIndex);
+            }
+        }
+
+        for (long j = updatedFrom; j <= knownUpTo; j++)
+        {
+            bestScore[j] = j > 0 ? bestScore[j - 1] : 0;
+            bestCandidate[j] = j > 0 ? bestCandidate[j - 1] : -1;
+
+            if (endingScore[j] > bestScore[j])      //ties keep the earlier dialogue word
+            {
+                bestScore[j] = endingScore[j];
+                bestCandidate[j] = endingCandidate[j];
+            }
+        }
+    }
+
+    for (long c = knownUpTo >= 0 ? bestCandidate[knownUpTo] : -1; c >= 0; c = candidates[c].previous)
+        matches[candidates[c].recognisedIndex] = static_cast<int>(candidates[c].wordIndex);
+
+    return matches;
+}
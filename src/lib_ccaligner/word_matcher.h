@@ -0,0 +1,45 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_WORD_MATCHER_H
+#define CCALIGNER_WORD_MATCHER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+int levenshtein_distance(const std::string& firstWord, const std::string& secondWord);
+
+class WordPattern   //a word of up to 64 characters, prepared for bit-parallel (Myers) edit distance
+{
+    uint64_t _masks[256];                   //bit i set where the character is at position i of the word
+    const std::string *_word;
+
+public:
+    static const std::size_t maxLength = 64;
+
+    WordPattern() noexcept;
+    WordPattern(const WordPattern&) = delete;
+    WordPattern& operator=(const WordPattern&) = delete;
+
+    bool assign(const std::string& word) noexcept;          //false if it is too long, the word must outlive the pattern
+    int distance(const std::string& text) const noexcept;   //edit distance from the word to text
+};
+
+/*
+ * Optimal monotone matching of the recognised words to the words of a dialogue, found in one pass of a banded
+ * alignment. A recognised word may only be matched to a dialogue word if at least 75% of the longer of the two agree.
+ * The most words are matched and, of those matchings, the one differing least; silence and noise are never matched.
+ * The recognised word at position p is only matched to dialogue words within searchWindow + 1 of p, or of where the
+ * diagonal of the two sequences is at p, so the cost grows with the length of the dialogue times the window.
+ *
+ * Returns the index of the dialogue word each recognised word is matched to, or -1.
+ * The dialogue words are expected in lowercase, as recognised.
+ */
+
+std::vector<int> matchWords(const std::vector<std::string>& words, const std::vector<std::string>& recognised, unsigned long searchWindow);
+
+#endif //CCALIGNER_WORD_MATCHER_H
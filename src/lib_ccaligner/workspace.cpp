@@ -0,0 +1,138 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include "workspace.h"
+#include "commons.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sys/stat.h>
+
+#ifdef WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+const char * const Workspace::defaultDirectory = "tempFiles";
+
+static const char * const subDirectories[] = {"corpus", "dict", "vocab", "fsg", "lm"};
+
+static bool exists(const std::string& path)
+{
+    struct stat status;
+    return stat(path.c_str(), &status) == 0;
+}
+
+static bool makeDirectory(const std::string& path)     //and its parents, true if it exists afterwards
+{
+    for (std::size_t slash = path.find_first_of("/\\", 1); ; slash = path.find_first_of("/\\", slash + 1))
+    {
+        std::string parent = path.substr(0, slash);
+
+#ifdef WIN32
+        int rv = _mkdir(parent.c_str());
+#else
+        int rv = mkdir(parent.c_str(), 0777);
+#endif
+
+        if (rv != 0 && errno != EEXIST)
+            return false;
+
+        if (slash == std::string::npos)
+            return true;
+    }
+}
+
+static bool removeRecursively(const std::string& path)
+{
+#ifdef WIN32
+    return std::system(("rmdir /s /q \"" + path + "\"").c_str()) == 0;
+#else
+    struct stat status;
+
+    if (lstat(path.c_str(), &status) != 0)
+        return false;
+
+    if (!S_ISDIR(status.st_mode))   //links are removed, not followed
+        return unlink(path.c_str()) == 0;
+
+    DIR *directory = opendir(path.c_str());
+
+    if (directory == nullptr)
+        return false;
+
+    bool removed = true;
+
+    while (struct dirent *entry = readdir(directory))
+    {
+        std::string name(entry->d_name);
+
+        if (name != "." && name != "..")
+            removed = removeRecursively(path + "/" + name) && removed;
+    }
+
+    closedir(directory);
+    return rmdir(path.c_str()) == 0 && removed;
+#endif
+}
+
+Workspace::Workspace(std::string directory) : _directory(std::move(directory))
+{
+    while (_directory.size() > 1 && (_directory.back() == '/' || _directory.back() == '\\'))
+        _directory.pop_back();
+}
+
+std::string Workspace::unique(const std::string& parent)
+{
+    static std::atomic<unsigned long> counter(0);   //jobs of the same process
+    std::string prefix = Workspace(parent).path("job-" + std::to_string(std::time(nullptr)) + "-" + std::to_string(getpid()) + "-");
+    std::string directory;
+
+    do
+        directory = prefix + std::to_string(counter++);
+    while (exists(directory));
+
+    return directory;
+}
+
+std::string Workspace::path(const std::string& name) const
+{
+    return _directory.empty() ? name : _directory + "/" + name;
+}
+
+void Workspace::create() const
+{
+    DEBUG << "Creating workspace at " << _directory << "/";
+
+    for (const char *subDirectory : subDirectories)
+    {
+        if (!makeDirectory(path(subDirectory)))
+            FATAL(UnknownError) << "Unable to create directory " << path(subDirectory) << " : " << strerror(errno);
+    }
+}
+
+bool Workspace::remove() const
+{
+    if (_directory.empty() || !exists(_directory))
+        return true;
+
+    DEBUG << "Removing workspace " << _directory << "/";
+
+    if (!removeRecursively(_directory))
+    {
+        WARNING << "Unable to remove workspace " << _directory << "/";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,46 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_WORKSPACE_H
+#define CCALIGNER_WORKSPACE_H
+
+#include <string>
+
+/*
+ * Directory the files of one job are kept in : the generated grammar, the g2p
+ * exchange files and the logs. Jobs with different workspaces may run in the
+ * same working directory at the same time.
+ *
+ *  <directory>/corpus/     corpus.txt, phoneticCorpus.txt
+ *  <directory>/dict/       complete.dict, g2p.dict
+ *  <directory>/vocab/      complete.vocab, g2p.vocab
+ *  <directory>/fsg/        <dialogue start in ms>.fsg
+ *  <directory>/lm/         complete.lm, phoneticCorpus.txt.arpabo
+ */
+
+class Workspace
+{
+    std::string _directory;
+
+public:
+    static const char * const defaultDirectory;         //tempFiles, shared by every job run from the same directory
+
+    explicit Workspace(std::string directory = defaultDirectory);
+
+    static std::string unique(const std::string& parent = defaultDirectory);  //parent/job-<time>-<pid>-<n>, not existing yet
+
+    const std::string& directory() const noexcept { return _directory; }
+    std::string path(const std::string& name) const;    //name inside the workspace
+
+    std::string lmPath() const { return path("lm/complete.lm"); }
+    std::string dictPath() const { return path("dict/complete.dict"); }
+    std::string phoneticLmPath() const { return path("lm/phoneticCorpus.txt.arpabo"); }
+
+    void create() const;                                //with its sub directories, if they don't exist
+    bool remove() const;                                //with everything inside
+};
+
+#endif //CCALIGNER_WORKSPACE_H
@@ -98,6 +98,48 @@ ps_default_search_args(cmd_ln_t *);
 POCKETSPHINX_EXPORT
 ps_decoder_t *ps_init(cmd_ln_t *config);
 
+/**
+ * Initialize a decoder sharing the acoustic model of another one.
+ *
+ * Works like ps_init(), but the model definition, transition matrices
+ * and Gaussian parameters already loaded by <code>model</code> are
+ * shared instead of being read again, so any number of decoders cost
+ * roughly the memory of one acoustic model.  The dictionary is shared
+ * too if it is read from the same files.  Everything else used while
+ * decoding (feature computation, cepstral mean, searches) stays
+ * private, so the decoders may be used from different threads.
+ * The shared parameters are read-only and are released with the last
+ * decoder using them.  If <code>config</code> names another acoustic
+ * model, or its computation module can not be shared, the model is
+ * loaded as ps_init() does.
+ *
+ * @note Decoders sharing a model must be created and freed one at a
+ * time and must not be adapted with ps_update_mllr().  Words may be
+ * added with ps_add_word() only to a decoder whose dictionary is its
+ * own, not to one sharing its dictionary with another decoder.
+ * Calling ps_reinit() on either decoder loads a private model again.
+ *
+ * @param config a command-line structure, as for ps_init().
+ * @param model a decoder whose acoustic model should be shared, or
+ * NULL to behave as ps_init().
+ */
+POCKETSPHINX_EXPORT
+ps_decoder_t *ps_init_shared(cmd_ln_t *config, ps_decoder_t *model);
+
+/**
+ * Initialize a decoder holding only an acoustic model.
+ *
+ * Loads the acoustic model of <code>config</code> as ps_init() does,
+ * but no dictionary, language model or search, so the decoder can not
+ * decode by itself.  It is meant to be passed as <code>model</code> to
+ * ps_init_shared(), which then reads the dictionary of each new decoder
+ * from its own configuration.
+ *
+ * @param config a command-line structure, as for ps_init().
+ */
+POCKETSPHINX_EXPORT
+ps_decoder_t *ps_init_model(cmd_ln_t *config);
+
 /**
  * Reinitialize the decoder with updated configuration.
  *
@@ -197,6 +239,28 @@ fe_t *ps_get_fe(ps_decoder_t *ps);
 POCKETSPHINX_EXPORT
 feat_t *ps_get_feat(ps_decoder_t *ps);
 
+/**
+ * Get the live cepstral mean the next utterance starts from.
+ *
+ * @param mean Array receiving one value per cepstral coefficient, or
+ *             NULL to only get their number.
+ * @return Number of cepstral coefficients, or 0 if the decoder does
+ *         not normalize the cepstral mean.
+ */
+POCKETSPHINX_EXPORT
+int ps_get_cmn(ps_decoder_t *ps, mfcc_t *mean);
+
+/**
+ * Set the live cepstral mean the next utterance starts from.
+ *
+ * @param mean One value per cepstral coefficient, as returned by
+ *             ps_get_cmn().
+ * @return 0 for success, <0 if the decoder does not normalize the
+ *         cepstral mean.
+ */
+POCKETSPHINX_EXPORT
+int ps_set_cmn(ps_decoder_t *ps, mfcc_t const *mean);
+
 /**
  * Adapt current acoustic model using a linear transform.
  *
@@ -229,6 +293,26 @@ POCKETSPHINX_EXPORT
 int ps_load_dict(ps_decoder_t *ps, char const *dictfile,
                  char const *fdictfile, char const *format);
 
+/**
+ * Reload the pronunciation dictionary from a file, keeping only some
+ * of its words.
+ *
+ * Like ps_load_dict(), but words of dictfile that are not in words are
+ * skipped while it is read, so the dictionary and its triphone
+ * mappings grow with the words kept, not with the size of the file.
+ * Alternate pronunciations of kept words are kept, the filler
+ * dictionary is read completely.
+ *
+ * @param dictfile Path to dictionary file to load.
+ * @param fdictfile Path to filler dictionary to load, or NULL to keep
+ *                  the existing filler dictionary.
+ * @param words NULL terminated array of words to keep, compared as
+ *              configured by -dictcase.
+ */
+POCKETSPHINX_EXPORT
+int ps_load_dict_words(ps_decoder_t *ps, char const *dictfile,
+                       char const *fdictfile, char const *const *words);
+
 /**
  * Dump the current pronunciation dictionary to a file.
  *
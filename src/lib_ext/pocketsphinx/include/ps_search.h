@@ -83,6 +83,11 @@ extern "C" {
  */
 typedef struct ps_search_iter_s ps_search_iter_t;
 
+/**
+ * Name of the search created from the configuration, e.g. from -lm.
+ */
+#define PS_DEFAULT_SEARCH  "_default"
+
 
 /**
  * Actives search with the provided name.
@@ -293,6 +298,47 @@ int ps_set_allphone(ps_decoder_t *ps, const char *name, ngram_model_t *lm);
 POCKETSPHINX_EXPORT
 int ps_set_allphone_file(ps_decoder_t *ps, const char *name, const char *path);
 
+/**
+ * Adds new search aligning the audio to a known word sequence.
+ *
+ * Creates a state alignment search for the space separated words,
+ * framed by silence, which are looked up in the dictionary.  After
+ * the utterance ps_get_hyp() returns the words and ps_seg_iter()
+ * their frames, or NULL if the end of the words was not reached.
+ * The search can be activated using ps_set_search().
+ *
+ * @return 0 on success, -1 if a word is not in the dictionary.
+ * @see ps_set_search
+ */
+POCKETSPHINX_EXPORT
+int ps_set_align(ps_decoder_t *ps, const char *name, const char *words);
+
+/**
+ * Get the word, phone and state alignment of the last utterance.
+ *
+ * @return alignment owned by the search, or NULL if the current search
+ *         was not added with ps_set_align() or did not reach the end of
+ *         its words.
+ * @see ps_set_align
+ */
+POCKETSPHINX_EXPORT
+struct ps_alignment_s *ps_get_alignment(ps_decoder_t *ps);
+
+/**
+ * Get a phone of the alignment of the last utterance.
+ *
+ * @param n index of the phone, from 0.
+ * @param out_start output: first frame of the phone.
+ * @param out_duration output: number of frames of the phone.
+ * @param out_filler output: whether it is a filler phone, e.g. silence.
+ * @return name of the context independent phone, or NULL if there is
+ *         no alignment (see ps_get_alignment()) or n is past its last
+ *         phone.
+ */
+POCKETSPHINX_EXPORT
+const char *ps_get_aligned_phone(ps_decoder_t *ps, int n, int *out_start,
+                                 int *out_duration, int *out_filler);
+
 #ifdef __cplusplus
 }
 #endif
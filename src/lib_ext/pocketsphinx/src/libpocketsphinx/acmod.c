@@ -135,6 +135,65 @@ acmod_init_am(acmod_t *acmod)
     return 0;
 }
 
+static int
+acmod_same_str(acmod_t *acmod, acmod_t *model, char const *name)
+{
+    char const *a = cmd_ln_str_r(acmod->config, name);
+    char const *b = cmd_ln_str_r(model->config, name);
+
+    if (a == NULL || b == NULL)
+        return a == b;
+    return 0 == strcmp(a, b);
+}
+
+/**
+ * Use the model parameters of another acmod, if it was loaded from
+ * the same files with the same parameters.
+ *
+ * @return 0 if shared, <0 if they have to be loaded.
+ */
+static int
+acmod_share_am(acmod_t *acmod, acmod_t *model)
+{
+    static char const *files[] = { "_mdef", "_tmat", "_mean", "_var",
+                                   "_mixw", "_sendump", "_senmgau",
+                                   "-feat", "-svspec", "-lda", NULL };
+    static char const *floats[] = { "-tmatfloor", "-varfloor",
+                                    "-mixwfloor", NULL };
+    char const **name;
+    ps_mgau_t *mgau;
+
+    for (name = files; *name; ++name) {
+        if (!acmod_same_str(acmod, model, *name))
+            return -1;
+    }
+    for (name = floats; *name; ++name) {
+        if (cmd_ln_float32_r(acmod->config, *name)
+            != cmd_ln_float32_r(model->config, *name))
+            return -1;
+    }
+    /* Scores are kept in the log base they were computed with, and
+     * adaptation would change the parameters of every user. */
+    if (logmath_get_base(acmod->lmath) != logmath_get_base(model->lmath)
+        || cmd_ln_int32_r(acmod->config, "-ceplen")
+           != cmd_ln_int32_r(model->config, "-ceplen")
+        || cmd_ln_int32_r(acmod->config, "-ldadim")
+           != cmd_ln_int32_r(model->config, "-ldadim")
+        || cmd_ln_str_r(acmod->config, "-mllr")
+        || model->mllr)
+        return -1;
+
+    if (model->mgau->vt->share == NULL
+        || (mgau = (*model->mgau->vt->share)(model->mgau, acmod)) == NULL)
+        return -1;
+
+    E_INFO("Sharing acoustic model parameters with another decoder\n");
+    acmod->mdef = bin_mdef_retain(model->mdef);
+    acmod->tmat = tmat_retain(model->tmat);
+    acmod->mgau = mgau;
+    return 0;
+}
+
 static int
 acmod_init_feat(acmod_t *acmod)
 {
@@ -224,8 +283,9 @@ acmod_feat_mismatch(acmod_t *acmod, feat_t *fcb)
     return FALSE;
 }
 
-acmod_t *
-acmod_init(cmd_ln_t *config, logmath_t *lmath, fe_t *fe, feat_t *fcb)
+static acmod_t *
+acmod_init_model(cmd_ln_t *config, logmath_t *lmath, fe_t *fe, feat_t *fcb,
+                 acmod_t *model)
 {
     acmod_t *acmod;
 
@@ -261,8 +321,9 @@ acmod_init(cmd_ln_t *config, logmath_t *lmath, fe_t *fe, feat_t *fcb)
             goto error_out;
     }
 
-    /* Load acoustic model parameters. */
-    if (acmod_init_am(acmod) < 0)
+    /* Share or load acoustic model parameters. */
+    if ((model == NULL || acmod_share_am(acmod, model) < 0)
+        && acmod_init_am(acmod) < 0)
         goto error_out;
 
 
@@ -295,6 +356,18 @@ error_out:
     return NULL;
 }
 
+acmod_t *
+acmod_init(cmd_ln_t *config, logmath_t *lmath, fe_t *fe, feat_t *fcb)
+{
+    return acmod_init_model(config, lmath, fe, fcb, NULL);
+}
+
+acmod_t *
+acmod_init_shared(cmd_ln_t *config, logmath_t *lmath, acmod_t *model)
+{
+    return acmod_init_model(config, lmath, NULL, NULL, model);
+}
+
 void
 acmod_free(acmod_t *acmod)
 {
@@ -94,6 +94,7 @@ struct ps_mllr_s {
  * Acoustic model parameter structure. 
  */
 typedef struct ps_mgau_s ps_mgau_t;
+typedef struct acmod_s acmod_t;
 
 typedef struct ps_mgaufuncs_s {
     char const *name;
@@ -108,6 +109,8 @@ typedef struct ps_mgaufuncs_s {
     int (*transform)(ps_mgau_t *mgau,
                      ps_mllr_t *mllr);
     void (*free)(ps_mgau_t *mgau);
+    /* Create a model for acmod sharing the parameters of mgau, NULL if not supported. */
+    ps_mgau_t *(*share)(ps_mgau_t *mgau, acmod_t *acmod);
 } ps_mgaufuncs_t;    
 
 struct ps_mgau_s {
@@ -199,7 +202,6 @@ struct acmod_s {
     frame_idx_t n_feat_frame; /**< Number of frames active in feat_buf */
     frame_idx_t feat_outidx;  /**< Start of active frames in feat_buf */
 };
-typedef struct acmod_s acmod_t;
 
 /**
  * Initialize an acoustic model.
@@ -219,6 +221,28 @@ typedef struct acmod_s acmod_t;
  */
 acmod_t *acmod_init(cmd_ln_t *config, logmath_t *lmath, fe_t *fe, feat_t *fcb);
 
+/**
+ * Initialize an acoustic model sharing the parameters of another one.
+ *
+ * The model definition, transition matrices and Gaussian/mixture
+ * weight parameters of <code>model</code> are shared and not loaded
+ * again, feature computation and all per-utterance state are private
+ * to the new object.  Parameters are released when the last acmod
+ * using them is freed, in any order.  Falls back to loading the model
+ * if <code>config</code> names other model files or the computation
+ * module can not share its parameters.
+ *
+ * @note Shared parameters must not be adapted with
+ *       acmod_update_mllr(), as that changes them for every user.
+ *
+ * @param config a command-line object containing parameters.
+ * @param lmath global log-math parameters.
+ * @param model an acoustic model to share parameters with, or NULL
+ *              to load them as acmod_init() does.
+ * @return a newly initialized acmod_t, or NULL on failure.
+ */
+acmod_t *acmod_init_shared(cmd_ln_t *config, logmath_t *lmath, acmod_t *model);
+
 /**
  * Adapt acoustic model using a linear transform.
  *
@@ -57,6 +57,7 @@
 #include <sphinxbase/byteorder.h>
 #include <sphinxbase/case.h>
 #include <sphinxbase/err.h>
+#include <sphinxbase/sbthread.h>
 
 /* Local headers. */
 #include "mdef.h"
@@ -264,17 +265,19 @@ bin_mdef_read_text(cmd_ln_t *config, const char *filename)
 bin_mdef_t *
 bin_mdef_retain(bin_mdef_t *m)
 {
-    ++m->refcnt;
+    sbatomic_add(&m->refcnt, 1);
     return m;
 }
 
 int
 bin_mdef_free(bin_mdef_t * m)
 {
+    int refcnt;
+
     if (m == NULL)
         return 0;
-    if (--m->refcnt > 0)
-        return m->refcnt;
+    if ((refcnt = sbatomic_add(&m->refcnt, -1)) > 0)
+        return refcnt;
 
     switch (m->alloc_mode) {
     case BIN_MDEF_FROM_TEXT:
@@ -115,7 +115,7 @@ struct cd_tree_s {
  */
 typedef struct bin_mdef_s bin_mdef_t;
 struct bin_mdef_s {
-	int refcnt;
+	int volatile refcnt; /**< Updated atomically, dictionaries of decoders on other threads retain it */
 	int32 n_ciphone;    /**< Number of base (CI) phones */
 	int32 n_phone;	    /**< Number of base (CI) phones + (CD) triphones */
 	int32 n_emit_state; /**< Number of emitting states per phone (0 for heterogeneous) */
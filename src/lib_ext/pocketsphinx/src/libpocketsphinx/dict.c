@@ -37,10 +37,12 @@
 
 /* System headers. */
 #include <string.h>
+#include <ctype.h>
 
 /* SphinxBase headers. */
 #include <sphinxbase/pio.h>
 #include <sphinxbase/strfuncs.h>
+#include <sphinxbase/sbthread.h>
 
 /* Local headers. */
 #include "dict.h"
@@ -145,8 +147,40 @@ dict_add_word(dict_t * d, char const *word, s3cipid_t const * p, int32 np)
 }
 
 
+/*
+ * Whether a word of the main dictionary is kept, alternate
+ * pronunciations word(2) belong to word.  The word ends at the first
+ * white space.
+ */
+static int
+dict_keep_word(hash_table_t *words, char *word)
+{
+    char *end, *open, saved;
+    void *val;
+    int keep;
+
+    if (words == NULL)
+        return TRUE;
+
+    for (end = word; *end && !isspace((unsigned char)*end); ++end)
+        ;
+    if (end > word && end[-1] == ')') {
+        for (open = end - 1; open > word && *open != '('; --open)
+            ;
+        if (open > word)
+            end = open;
+    }
+
+    saved = *end;
+    *end = '\0';
+    keep = hash_table_lookup(words, word, &val) == 0;
+    *end = saved;
+
+    return keep;
+}
+
 static int32
-dict_read(FILE * fp, dict_t * d)
+dict_read(FILE * fp, dict_t * d, hash_table_t *words)
 {
     lineiter_t *li;
     char **wptr;
@@ -179,6 +213,8 @@ dict_read(FILE * fp, dict_t * d)
 
         if (nwd == 0)           /* Empty line */
             continue;
+        if (!dict_keep_word(words, wptr[0]))
+            continue;
         /* wptr[0] is the word-string and wptr[1..nwd-1] the pronunciation sequence */
         if (nwd == 1) {
             E_ERROR("Line %d: No pronunciation for word '%s'; ignored\n",
@@ -250,6 +286,12 @@ dict_write(dict_t *dict, char const *filename, char const *format)
 
 dict_t *
 dict_init(cmd_ln_t *config, bin_mdef_t * mdef)
+{
+    return dict_init_words(config, mdef, NULL);
+}
+
+dict_t *
+dict_init_words(cmd_ln_t *config, bin_mdef_t * mdef, hash_table_t *words)
 {
     FILE *fp, *fp2;
     int32 n;
@@ -276,8 +318,13 @@ dict_init(cmd_ln_t *config, bin_mdef_t * mdef)
             return NULL;
         }
         for (li = lineiter_start(fp); li; li = lineiter_next(li)) {
+            char *word = li->buf;
+
+            while (isspace((unsigned char)*word))
+                ++word;
             if (0 != strncmp(li->buf, "##", 2)
-                && 0 != strncmp(li->buf, ";;", 2))
+                && 0 != strncmp(li->buf, ";;", 2)
+                && dict_keep_word(words, word))
                 n++;
         }
 	fseek(fp, 0L, SEEK_SET);
@@ -331,7 +378,7 @@ dict_init(cmd_ln_t *config, bin_mdef_t * mdef)
     /* Digest main dictionary file */
     if (fp) {
         E_INFO("Reading main dictionary: %s\n", dictfile);
-        dict_read(fp, d);
+        dict_read(fp, d, words);
         fclose(fp);
         E_INFO("%d words read\n", d->n_word);
     }
@@ -356,7 +403,7 @@ dict_init(cmd_ln_t *config, bin_mdef_t * mdef)
     d->filler_start = d->n_word;
     if (fillerfile) {
         E_INFO("Reading filler dictionary: %s\n", fillerfile);
-        dict_read(fp2, d);
+        dict_read(fp2, d, NULL);
         fclose(fp2);
         E_INFO("%d words read\n", d->n_word - d->filler_start);
     }
@@ -460,20 +507,20 @@ dict_word2basestr(char *word)
 dict_t *
 dict_retain(dict_t *d)
 {
-    ++d->refcnt;
+    sbatomic_add(&d->refcnt, 1);
     return d;
 }
 
 int
 dict_free(dict_t * d)
 {
-    int i;
+    int i, refcnt;
     dictword_t *word;
 
     if (d == NULL)
         return 0;
-    if (--d->refcnt > 0)
-        return d->refcnt;
+    if ((refcnt = sbatomic_add(&d->refcnt, -1)) > 0)
+        return refcnt;
 
     /* First Step, free all memory allocated for each word */
     for (i = 0; i < d->n_word; i++) {
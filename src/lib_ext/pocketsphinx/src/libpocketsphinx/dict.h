@@ -74,7 +74,7 @@ typedef struct {
 */
 
 typedef struct {
-    int refcnt;
+    int volatile refcnt;  /**< Updated atomically, lattices of decoders on other threads retain it */
     bin_mdef_t *mdef;	/**< Model definition used for phone IDs; NULL if none used */
     dictword_t *word;	/**< Array of entries in dictionary */
     hash_table_t *ht;	/**< Hash table for mapping word strings to word ids */
@@ -104,6 +104,17 @@ dict_t *dict_init(cmd_ln_t *config, /**< Configuration (-dict, -fdict, -dictcase
                   bin_mdef_t *mdef  /**< For looking up CI phone IDs (or NULL) */
     );
 
+/**
+ * Like dict_init(), but only words of the main dictionary found in
+ * words are read, together with their alternate pronunciations.  The
+ * filler dictionary is read completely.  Memory is allocated for the
+ * words kept only.
+ */
+dict_t *dict_init_words(cmd_ln_t *config, /**< Configuration (-dict, -fdict, -dictcase) or NULL */
+                        bin_mdef_t *mdef, /**< For looking up CI phone IDs (or NULL) */
+                        hash_table_t *words /**< Words to keep, or NULL for all */
+    );
+
 /**
  * Write dictionary to a file.
  */
@@ -37,6 +37,8 @@
 
 #include <string.h>
 
+#include <sphinxbase/sbthread.h>
+
 #include "dict2pid.h"
 #include "hmm.h"
 
@@ -499,17 +501,19 @@ dict2pid_build(bin_mdef_t * mdef, dict_t * dict)
 dict2pid_t *
 dict2pid_retain(dict2pid_t *d2p)
 {
-    ++d2p->refcount;
+    sbatomic_add(&d2p->refcount, 1);
     return d2p;
 }
 
 int
 dict2pid_free(dict2pid_t * d2p)
 {
+    int refcount;
+
     if (d2p == NULL)
         return 0;
-    if (--d2p->refcount > 0)
-        return d2p->refcount;
+    if ((refcount = sbatomic_add(&d2p->refcount, -1)) > 0)
+        return refcount;
 
     if (d2p->ldiph_lc)
         ckd_free_3d((void ***) d2p->ldiph_lc);
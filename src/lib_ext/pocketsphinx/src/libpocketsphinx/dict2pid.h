@@ -82,7 +82,7 @@ typedef struct {
 */
 
 typedef struct {
-    int refcount;
+    int volatile refcount;  /**< Updated atomically, decoders on other threads retain it */
 
     bin_mdef_t *mdef;           /**< Model definition, used to generate
                                    internal ssids on the fly. */
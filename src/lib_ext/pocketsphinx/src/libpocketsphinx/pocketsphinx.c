@@ -63,6 +63,7 @@
 #include "ngram_search_fwdtree.h"
 #include "ngram_search_fwdflat.h"
 #include "allphone_search.h"
+#include "state_align_search.h"
 
 static const arg_t ps_args_def[] = {
     POCKETSPHINX_OPTIONS,
@@ -214,8 +215,33 @@ ps_default_search_args(cmd_ln_t *config)
 #endif
 }
 
-int
-ps_reinit(ps_decoder_t *ps, cmd_ln_t *config)
+static int
+ps_same_str(cmd_ln_t *config, cmd_ln_t *other, char const *name)
+{
+    char const *a = cmd_ln_str_r(config, name);
+    char const *b = cmd_ln_str_r(other, name);
+
+    if (a == NULL || b == NULL)
+        return a == b;
+    return 0 == strcmp(a, b);
+}
+
+/* Whether the dictionary of a decoder sharing the acoustic model of
+ * another one would be read from the same files. */
+static int
+ps_same_dict(ps_decoder_t *ps, ps_decoder_t *model)
+{
+    return model && model->dict && model->d2p
+        && ps->acmod->mdef == model->acmod->mdef
+        && ps_same_str(ps->config, model->config, "-dict")
+        && ps_same_str(ps->config, model->config, "_fdict")
+        && (cmd_ln_boolean_r(ps->config, "-dictcase")
+            == cmd_ln_boolean_r(model->config, "-dictcase"));
+}
+
+static int
+ps_reinit_model(ps_decoder_t *ps, cmd_ln_t *config, ps_decoder_t *model,
+                int model_only)
 {
     const char *path;
     const char *keyphrase;
@@ -259,6 +285,11 @@ ps_reinit(ps_decoder_t *ps, cmd_ln_t *config)
     ps->d2p = NULL;
 
     /* Logmath computation (used in acmod and search) */
+    if (ps->lmath == NULL && model
+        && (logmath_get_base(model->lmath) ==
+            (float64)cmd_ln_float32_r(ps->config, "-logbase"))) {
+        ps->lmath = logmath_retain(model->lmath);
+    }
     if (ps->lmath == NULL
         || (logmath_get_base(ps->lmath) !=
             (float64)cmd_ln_float32_r(ps->config, "-logbase"))) {
@@ -271,9 +302,14 @@ ps_reinit(ps_decoder_t *ps, cmd_ln_t *config)
 
     /* Acoustic model (this is basically everything that
      * uttproc.c, senscr.c, and others used to do) */
-    if ((ps->acmod = acmod_init(ps->config, ps->lmath, NULL, NULL)) == NULL)
+    if ((ps->acmod = acmod_init_shared(ps->config, ps->lmath,
+                                       model ? model->acmod : NULL)) == NULL)
         return -1;
 
+    /* A decoder only lending its acoustic model has no dictionary or
+     * search. */
+    if (model_only)
+        return 0;
 
 
     if (cmd_ln_int32_r(ps->config, "-pl_window") > 0) {
@@ -289,10 +325,16 @@ ps_reinit(ps_decoder_t *ps, cmd_ln_t *config)
 
     /* Dictionary and triphone mappings (depends on acmod). */
     /* FIXME: pass config, change arguments, implement LTS, etc. */
-    if ((ps->dict = dict_init(ps->config, ps->acmod->mdef)) == NULL)
-        return -1;
-    if ((ps->d2p = dict2pid_build(ps->acmod->mdef, ps->dict)) == NULL)
-        return -1;
+    if (ps_same_dict(ps, model)) {
+        ps->dict = dict_retain(model->dict);
+        ps->d2p = dict2pid_retain(model->d2p);
+    }
+    else {
+        if ((ps->dict = dict_init(ps->config, ps->acmod->mdef)) == NULL)
+            return -1;
+        if ((ps->d2p = dict2pid_build(ps->acmod->mdef, ps->dict)) == NULL)
+            return -1;
+    }
 
     lw = cmd_ln_float32_r(ps->config, "-lw");
 
@@ -383,8 +425,20 @@ ps_reinit(ps_decoder_t *ps, cmd_ln_t *config)
     return 0;
 }
 
+int
+ps_reinit(ps_decoder_t *ps, cmd_ln_t *config)
+{
+    return ps_reinit_model(ps, config, NULL, FALSE);
+}
+
 ps_decoder_t *
 ps_init(cmd_ln_t *config)
+{
+    return ps_init_shared(config, NULL);
+}
+
+static ps_decoder_t *
+ps_init_common(cmd_ln_t *config, ps_decoder_t *model, int model_only)
 {
     ps_decoder_t *ps;
     
@@ -395,13 +449,25 @@ ps_init(cmd_ln_t *config)
 
     ps = ckd_calloc(1, sizeof(*ps));
     ps->refcount = 1;
-    if (ps_reinit(ps, config) < 0) {
+    if (ps_reinit_model(ps, config, model, model_only) < 0) {
         ps_free(ps);
         return NULL;
     }
     return ps;
 }
 
+ps_decoder_t *
+ps_init_shared(cmd_ln_t *config, ps_decoder_t *model)
+{
+    return ps_init_common(config, model, FALSE);
+}
+
+ps_decoder_t *
+ps_init_model(cmd_ln_t *config)
+{
+    return ps_init_common(config, NULL, TRUE);
+}
+
 arg_t const *
 ps_args(void)
 {
@@ -456,6 +522,29 @@ ps_get_feat(ps_decoder_t *ps)
     return ps->acmod->fcb;
 }
 
+int
+ps_get_cmn(ps_decoder_t *ps, mfcc_t *mean)
+{
+    cmn_t *cmn = ps->acmod->fcb->cmn_struct;
+
+    if (cmn == NULL)
+        return 0;
+    if (mean)
+        cmn_live_get(cmn, mean);
+    return cmn->veclen;
+}
+
+int
+ps_set_cmn(ps_decoder_t *ps, mfcc_t const *mean)
+{
+    cmn_t *cmn = ps->acmod->fcb->cmn_struct;
+
+    if (cmn == NULL)
+        return -1;
+    cmn_live_set(cmn, mean);
+    return 0;
+}
+
 ps_mllr_t *
 ps_update_mllr(ps_decoder_t *ps, ps_mllr_t *mllr)
 {
@@ -643,6 +732,43 @@ ps_set_keyphrase(ps_decoder_t *ps, const char *name, const char *keyphrase)
     return set_search_internal(ps, search);
 }
 
+int
+ps_set_align(ps_decoder_t *ps, const char *name, const char *words)
+{
+    ps_alignment_t *al;
+    ps_search_t *search;
+    char *text, **wptr;
+    int i, n_words;
+
+    text = ckd_salloc(words);
+    n_words = str2words(text, NULL, 0);
+    wptr = ckd_calloc(n_words + 1, sizeof(*wptr));
+    str2words(text, wptr, n_words);
+
+    /* Silence at either end, the words in between. */
+    al = ps_alignment_init(ps->d2p);
+    ps_alignment_add_word(al, dict_startwid(ps->dict), 0);
+    for (i = 0; i < n_words; ++i) {
+        s3wid_t wid = dict_wordid(ps->dict, wptr[i]);
+        if (wid == BAD_S3WID) {
+            E_ERROR("Word '%s' not in dictionary, can not align\n", wptr[i]);
+            ps_alignment_free(al);
+            ckd_free(wptr);
+            ckd_free(text);
+            return -1;
+        }
+        ps_alignment_add_word(al, wid, 0);
+    }
+    ps_alignment_add_word(al, dict_finishwid(ps->dict), 0);
+    ps_alignment_populate(al);
+    ckd_free(wptr);
+    ckd_free(text);
+
+    search = state_align_search_init(name, ps->config, ps->acmod, al);
+    ps_alignment_free(al);
+    return set_search_internal(ps, search);
+}
+
 int
 ps_set_fsg(ps_decoder_t *ps, const char *name, fsg_model_t *fsg)
 {
@@ -730,9 +856,9 @@ ps_set_jsgf_string(ps_decoder_t *ps, const char *name, const char *jsgf_string)
 }
 
 
-int
-ps_load_dict(ps_decoder_t *ps, char const *dictfile,
-             char const *fdictfile, char const *format)
+static int
+ps_load_dict_filtered(ps_decoder_t *ps, char const *dictfile,
+                      char const *fdictfile, hash_table_t *words)
 {
     dict2pid_t *d2p;
     dict_t *dict;
@@ -752,7 +878,7 @@ ps_load_dict(ps_decoder_t *ps, char const *dictfile,
                                cmd_ln_str_r(ps->config, "_fdict"));
 
     /* Try to load it. */
-    if ((dict = dict_init(newconfig, ps->acmod->mdef)) == NULL) {
+    if ((dict = dict_init_words(newconfig, ps->acmod->mdef, words)) == NULL) {
         cmd_ln_free_r(newconfig);
         return -1;
     }
@@ -783,6 +909,33 @@ ps_load_dict(ps_decoder_t *ps, char const *dictfile,
     return 0;
 }
 
+int
+ps_load_dict(ps_decoder_t *ps, char const *dictfile,
+             char const *fdictfile, char const *format)
+{
+    return ps_load_dict_filtered(ps, dictfile, fdictfile, NULL);
+}
+
+int
+ps_load_dict_words(ps_decoder_t *ps, char const *dictfile,
+                   char const *fdictfile, char const *const *words)
+{
+    hash_table_t *keep;
+    int32 n, rv;
+
+    for (n = 0; words[n]; ++n)
+        ;
+    /* Same case sensitivity as the dictionary */
+    keep = hash_table_new(n + 1, cmd_ln_boolean_r(ps->config, "-dictcase"));
+    for (n = 0; words[n]; ++n)
+        hash_table_enter(keep, words[n], (void *)words[n]);
+
+    rv = ps_load_dict_filtered(ps, dictfile, fdictfile, keep);
+    hash_table_free(keep);
+
+    return rv;
+}
+
 int
 ps_save_dict(ps_decoder_t *ps, char const *dictfile,
              char const *format)
@@ -1263,6 +1416,34 @@ ps_get_lattice(ps_decoder_t *ps)
     return ps_search_lattice(ps->search);
 }
 
+ps_alignment_t *
+ps_get_alignment(ps_decoder_t *ps)
+{
+    state_align_search_t *sas;
+
+    if (ps->search == NULL
+        || strcmp(ps_search_type(ps->search), PS_SEARCH_TYPE_STATE_ALIGN))
+        return NULL;
+    sas = (state_align_search_t *)ps->search;
+    return sas->aligned ? sas->al : NULL;
+}
+
+const char *
+ps_get_aligned_phone(ps_decoder_t *ps, int n, int *out_start,
+                     int *out_duration, int *out_filler)
+{
+    ps_alignment_t *al = ps_get_alignment(ps);
+    ps_alignment_entry_t *pe;
+
+    if (al == NULL || n < 0 || n >= al->sseq.n_ent)
+        return NULL;
+    pe = al->sseq.seq + n;
+    *out_start = pe->start;
+    *out_duration = pe->duration;
+    *out_filler = bin_mdef_is_fillerphone(ps->acmod->mdef, pe->id.pid.cipid);
+    return bin_mdef_ciphone_str(ps->acmod->mdef, pe->id.pid.cipid);
+}
+
 ps_nbest_t *
 ps_nbest(ps_decoder_t *ps)
 {
@@ -64,8 +64,7 @@
 typedef struct ps_search_s ps_search_t;
 
 
-/* Search names*/
-#define PS_DEFAULT_SEARCH  "_default"
+/* Search names (PS_DEFAULT_SEARCH is in ps_search.h) */
 #define PS_DEFAULT_PL_SEARCH  "_default_pl"
 
 /* Search types */
@@ -51,6 +51,10 @@
 #include "dict2pid.h"
 #include "hmm.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define PS_ALIGNMENT_NONE ((uint16)0xffff)
 
 struct ps_alignment_entry_s {
@@ -78,6 +82,7 @@ struct ps_alignment_vector_s {
 typedef struct ps_alignment_vector_s ps_alignment_vector_t;
 
 struct ps_alignment_s {
+    int refcount;
     dict2pid_t *d2p;
     ps_alignment_vector_t word;
     ps_alignment_vector_t sseq;
@@ -97,6 +102,11 @@ typedef struct ps_alignment_iter_s ps_alignment_iter_t;
  */
 ps_alignment_t *ps_alignment_init(dict2pid_t *d2p);
 
+/**
+ * Retain an alignment
+ */
+ps_alignment_t *ps_alignment_retain(ps_alignment_t *al);
+
 /**
  * Release an alignment
  */
@@ -187,4 +197,8 @@ ps_alignment_iter_t *ps_alignment_iter_down(ps_alignment_iter_t *itor);
  */
 int ps_alignment_iter_free(ps_alignment_iter_t *itor);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* __PS_ALIGNMENT_H__ */
@@ -64,7 +64,8 @@ static ps_mgaufuncs_t ptm_mgau_funcs = {
     "ptm",
     ptm_mgau_frame_eval,      /* frame_eval */
     ptm_mgau_mllr_transform,  /* transform */
-    ptm_mgau_free             /* free */
+    ptm_mgau_free,            /* free */
+    ptm_mgau_share            /* share */
 };
 
 #define COMPUTE_GMM_MAP(_idx)                           \
@@ -765,6 +766,40 @@ read_mixw(ptm_mgau_t * s, char const *file_name, double SmoothMin)
     return n_sen;
 }
 
+static void
+ptm_mgau_alloc_hist(ptm_mgau_t *s)
+{
+    int i;
+
+    /* Allocate fast-match history buffers.  We need enough for the
+     * phoneme lookahead window, plus the current frame, plus one for
+     * good measure? (FIXME: I don't remember why) */
+    s->n_fast_hist = cmd_ln_int32_r(s->config, "-pl_window") + 2;
+    s->hist = ckd_calloc(s->n_fast_hist, sizeof(*s->hist));
+    /* s->f will be a rotating pointer into s->hist. */
+    s->f = s->hist;
+    for (i = 0; i < s->n_fast_hist; ++i) {
+        int j, k, m;
+        /* Top-N codewords for every codebook and feature. */
+        s->hist[i].topn = ckd_calloc_3d(s->g->n_mgau, s->g->n_feat,
+                                        s->max_topn, sizeof(ptm_topn_t));
+        /* Initialize them to sane (yet arbitrary) defaults. */
+        for (j = 0; j < s->g->n_mgau; ++j) {
+            for (k = 0; k < s->g->n_feat; ++k) {
+                for (m = 0; m < s->max_topn; ++m) {
+                    s->hist[i].topn[j][k][m].cw = m;
+                    s->hist[i].topn[j][k][m].score = WORST_DIST;
+                }
+            }
+        }
+        /* Active codebook mapping (just codebook, not features,
+           at least not yet) */
+        s->hist[i].mgau_active = bitvec_alloc(s->g->n_mgau);
+        /* Start with them all on, prune them later. */
+        bitvec_set_all(s->hist[i].mgau_active, s->g->n_mgau);
+    }
+}
+
 ps_mgau_t *
 ptm_mgau_init(acmod_t *acmod, bin_mdef_t *mdef)
 {
@@ -775,6 +810,7 @@ ptm_mgau_init(acmod_t *acmod, bin_mdef_t *mdef)
 
     s = ckd_calloc(1, sizeof(*s));
     s->config = acmod->config;
+    s->refcount = 1;
 
     s->lmath = logmath_retain(acmod->lmath);
     /* Log-add table. */
@@ -842,33 +878,7 @@ ptm_mgau_init(acmod_t *acmod, bin_mdef_t *mdef)
     for (i = 0; i < s->n_sen; ++i)
         s->sen2cb[i] = bin_mdef_sen2cimap(acmod->mdef, i);
 
-    /* Allocate fast-match history buffers.  We need enough for the
-     * phoneme lookahead window, plus the current frame, plus one for
-     * good measure? (FIXME: I don't remember why) */
-    s->n_fast_hist = cmd_ln_int32_r(s->config, "-pl_window") + 2;
-    s->hist = ckd_calloc(s->n_fast_hist, sizeof(*s->hist));
-    /* s->f will be a rotating pointer into s->hist. */
-    s->f = s->hist;
-    for (i = 0; i < s->n_fast_hist; ++i) {
-        int j, k, m;
-        /* Top-N codewords for every codebook and feature. */
-        s->hist[i].topn = ckd_calloc_3d(s->g->n_mgau, s->g->n_feat,
-                                        s->max_topn, sizeof(ptm_topn_t));
-        /* Initialize them to sane (yet arbitrary) defaults. */
-        for (j = 0; j < s->g->n_mgau; ++j) {
-            for (k = 0; k < s->g->n_feat; ++k) {
-                for (m = 0; m < s->max_topn; ++m) {
-                    s->hist[i].topn[j][k][m].cw = m;
-                    s->hist[i].topn[j][k][m].score = WORST_DIST;
-                }
-            }
-        }
-        /* Active codebook mapping (just codebook, not features,
-           at least not yet) */
-        s->hist[i].mgau_active = bitvec_alloc(s->g->n_mgau);
-        /* Start with them all on, prune them later. */
-        bitvec_set_all(s->hist[i].mgau_active, s->g->n_mgau);
-    }
+    ptm_mgau_alloc_hist(s);
 
     ps = (ps_mgau_t *)s;
     ps->vt = &ptm_mgau_funcs;
@@ -886,29 +896,62 @@ ptm_mgau_mllr_transform(ps_mgau_t *ps,
     return gauden_mllr_transform(s->g, mllr, s->config);
 }
 
+ps_mgau_t *
+ptm_mgau_share(ps_mgau_t *ps, acmod_t *acmod)
+{
+    ptm_mgau_t *owner = (ptm_mgau_t *)ps;
+    ptm_mgau_t *s;
+
+    if (owner->owner)
+        owner = owner->owner;
+
+    /* Parameters are shared, top-N histories are per decoder. */
+    s = ckd_calloc(1, sizeof(*s));
+    *s = *owner;
+    s->base.frame_idx = 0;
+    s->config = acmod->config;
+    s->lmath = logmath_retain(acmod->lmath);
+    s->ds_ratio = cmd_ln_int32_r(s->config, "-ds");
+    s->max_topn = cmd_ln_int32_r(s->config, "-topn");
+    s->owner = owner;
+    s->refcount = 0;
+    ++owner->refcount;
+
+    ptm_mgau_alloc_hist(s);
+    return ps_mgau_base(s);
+}
+
 void
 ptm_mgau_free(ps_mgau_t *ps)
 {
     int i;
     ptm_mgau_t *s = (ptm_mgau_t *)ps;
+    ptm_mgau_t *owner = s->owner ? s->owner : s;
 
     logmath_free(s->lmath);
-    logmath_free(s->lmath_8b);
-    if (s->sendump_mmap) {
-        ckd_free_2d(s->mixw); 
-        mmio_file_unmap(s->sendump_mmap);
-    }
-    else {
-        ckd_free_3d(s->mixw);
-    }
-    ckd_free(s->sen2cb);
-    
     for (i = 0; i < s->n_fast_hist; i++) {
 	ckd_free_3d(s->hist[i].topn);
 	bitvec_free(s->hist[i].mgau_active);
     }
     ckd_free(s->hist);
-    
-    gauden_free(s->g);
-    ckd_free(s);
+    s->hist = NULL;
+    s->n_fast_hist = 0;
+
+    /* The owner outlives its copies, whichever is freed first. */
+    if (s != owner)
+        ckd_free(s);
+    if (--owner->refcount > 0)
+        return;
+
+    logmath_free(owner->lmath_8b);
+    if (owner->sendump_mmap) {
+        ckd_free_2d(owner->mixw); 
+        mmio_file_unmap(owner->sendump_mmap);
+    }
+    else {
+        ckd_free_3d(owner->mixw);
+    }
+    ckd_free(owner->sen2cb);
+    gauden_free(owner->g);
+    ckd_free(owner);
 }
@@ -85,9 +85,13 @@ struct ptm_mgau_s {
     logmath_t *lmath_8b;
     /* Log-add object for reloading means/variances. */
     logmath_t *lmath;
+
+    ptm_mgau_t *owner;  /**< Model owning the parameters above, NULL if this one does. */
+    int refcount;       /**< Number of models using the parameters of an owner. */
 };
 
 ps_mgau_t *ptm_mgau_init(acmod_t *acmod, bin_mdef_t *mdef);
+ps_mgau_t *ptm_mgau_share(ps_mgau_t *s, acmod_t *acmod);
 void ptm_mgau_free(ps_mgau_t *s);
 int ptm_mgau_frame_eval(ps_mgau_t *s,
                         int16 *senone_scores,
@@ -64,7 +64,8 @@ static ps_mgaufuncs_t s2_semi_mgau_funcs = {
     "s2_semi",
     s2_semi_mgau_frame_eval,      /* frame_eval */
     s2_semi_mgau_mllr_transform,  /* transform */
-    s2_semi_mgau_free             /* free */
+    s2_semi_mgau_free,            /* free */
+    s2_semi_mgau_share            /* share */
 };
 
 struct vqFeature_s {
@@ -1224,6 +1225,42 @@ split_topn(char const *str, uint8 *out, int nfeat)
 }
 
 
+static void
+s2_semi_mgau_alloc_topn(s2_semi_mgau_t *s)
+{
+    int i;
+    int n_feat = s->g->n_feat;
+
+    /* Determine top-N for each feature */
+    s->topn_beam = ckd_calloc(n_feat, sizeof(*s->topn_beam));
+    s->max_topn = cmd_ln_int32_r(s->config, "-topn");
+    split_topn(cmd_ln_str_r(s->config, "-topn_beam"), s->topn_beam, n_feat);
+    E_INFO("Maximum top-N: %d ", s->max_topn);
+    E_INFOCONT("Top-N beams:");
+    for (i = 0; i < n_feat; ++i) {
+        E_INFOCONT(" %d", s->topn_beam[i]);
+    }
+    E_INFOCONT("\n");
+
+    /* Top-N scores from recent frames */
+    s->n_topn_hist = cmd_ln_int32_r(s->config, "-pl_window") + 2;
+    s->topn_hist = (vqFeature_t ***)
+        ckd_calloc_3d(s->n_topn_hist, n_feat, s->max_topn,
+                      sizeof(***s->topn_hist));
+    s->topn_hist_n = ckd_calloc_2d(s->n_topn_hist, n_feat,
+                                   sizeof(**s->topn_hist_n));
+    for (i = 0; i < s->n_topn_hist; ++i) {
+        int j;
+        for (j = 0; j < n_feat; ++j) {
+            int k;
+            for (k = 0; k < s->max_topn; ++k) {
+                s->topn_hist[i][j][k].score = WORST_DIST;
+                s->topn_hist[i][j][k].codeword = k;
+            }
+        }
+    }
+}
+
 ps_mgau_t *
 s2_semi_mgau_init(acmod_t *acmod)
 {
@@ -1235,6 +1272,7 @@ s2_semi_mgau_init(acmod_t *acmod)
 
     s = ckd_calloc(1, sizeof(*s));
     s->config = acmod->config;
+    s->refcount = 1;
 
     s->lmath = logmath_retain(acmod->lmath);
     /* Log-add table. */
@@ -1290,34 +1328,7 @@ s2_semi_mgau_init(acmod_t *acmod)
     }
     s->ds_ratio = cmd_ln_int32_r(s->config, "-ds");
 
-    /* Determine top-N for each feature */
-    s->topn_beam = ckd_calloc(n_feat, sizeof(*s->topn_beam));
-    s->max_topn = cmd_ln_int32_r(s->config, "-topn");
-    split_topn(cmd_ln_str_r(s->config, "-topn_beam"), s->topn_beam, n_feat);
-    E_INFO("Maximum top-N: %d ", s->max_topn);
-    E_INFOCONT("Top-N beams:");
-    for (i = 0; i < n_feat; ++i) {
-        E_INFOCONT(" %d", s->topn_beam[i]);
-    }
-    E_INFOCONT("\n");
-
-    /* Top-N scores from recent frames */
-    s->n_topn_hist = cmd_ln_int32_r(s->config, "-pl_window") + 2;
-    s->topn_hist = (vqFeature_t ***)
-        ckd_calloc_3d(s->n_topn_hist, n_feat, s->max_topn,
-                      sizeof(***s->topn_hist));
-    s->topn_hist_n = ckd_calloc_2d(s->n_topn_hist, n_feat,
-                                   sizeof(**s->topn_hist_n));
-    for (i = 0; i < s->n_topn_hist; ++i) {
-        int j;
-        for (j = 0; j < n_feat; ++j) {
-            int k;
-            for (k = 0; k < s->max_topn; ++k) {
-                s->topn_hist[i][j][k].score = WORST_DIST;
-                s->topn_hist[i][j][k].codeword = k;
-            }
-        }
-    }
+    s2_semi_mgau_alloc_topn(s);
 
     ps = (ps_mgau_t *)s;
     ps->vt = &s2_semi_mgau_funcs;
@@ -1335,25 +1346,60 @@ s2_semi_mgau_mllr_transform(ps_mgau_t *ps,
     return gauden_mllr_transform(s->g, mllr, s->config);
 }
 
+ps_mgau_t *
+s2_semi_mgau_share(ps_mgau_t *ps, acmod_t *acmod)
+{
+    s2_semi_mgau_t *owner = (s2_semi_mgau_t *)ps;
+    s2_semi_mgau_t *s;
+
+    if (owner->owner)
+        owner = owner->owner;
+
+    /* Parameters are shared, top-N beams and histories are per decoder. */
+    s = ckd_calloc(1, sizeof(*s));
+    *s = *owner;
+    s->base.frame_idx = 0;
+    s->config = acmod->config;
+    s->lmath = logmath_retain(acmod->lmath);
+    s->ds_ratio = cmd_ln_int32_r(s->config, "-ds");
+    s->owner = owner;
+    s->refcount = 0;
+    ++owner->refcount;
+
+    s2_semi_mgau_alloc_topn(s);
+    return ps_mgau_base(s);
+}
+
 void
 s2_semi_mgau_free(ps_mgau_t *ps)
 {
     s2_semi_mgau_t *s = (s2_semi_mgau_t *)ps;
+    s2_semi_mgau_t *owner = s->owner ? s->owner : s;
 
     logmath_free(s->lmath);
-    logmath_free(s->lmath_8b);
-    if (s->sendump_mmap) {
-        ckd_free_2d(s->mixw); 
-        mmio_file_unmap(s->sendump_mmap);
-    }
-    else {
-        ckd_free_3d(s->mixw);
-        if (s->mixw_cb)
-            ckd_free(s->mixw_cb);
-    }
-    gauden_free(s->g);
     ckd_free(s->topn_beam);
     ckd_free_2d(s->topn_hist_n);
     ckd_free_3d((void **)s->topn_hist);
-    ckd_free(s);
+    s->topn_beam = NULL;
+    s->topn_hist_n = NULL;
+    s->topn_hist = NULL;
+
+    /* The owner outlives its copies, whichever is freed first. */
+    if (s != owner)
+        ckd_free(s);
+    if (--owner->refcount > 0)
+        return;
+
+    logmath_free(owner->lmath_8b);
+    if (owner->sendump_mmap) {
+        ckd_free_2d(owner->mixw); 
+        mmio_file_unmap(owner->sendump_mmap);
+    }
+    else {
+        ckd_free_3d(owner->mixw);
+        if (owner->mixw_cb)
+            ckd_free(owner->mixw_cb);
+    }
+    gauden_free(owner->g);
+    ckd_free(owner);
 }
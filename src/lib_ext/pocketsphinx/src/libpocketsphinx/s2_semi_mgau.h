@@ -80,9 +80,13 @@ struct s2_semi_mgau_s {
     logmath_t *lmath_8b;
     /* Log-add object for reloading means/variances. */
     logmath_t *lmath;
+
+    s2_semi_mgau_t *owner; /**< Model owning the parameters above, NULL if this one does. */
+    int refcount;          /**< Number of models using the parameters of an owner. */
 };
 
 ps_mgau_t *s2_semi_mgau_init(acmod_t *acmod);
+ps_mgau_t *s2_semi_mgau_share(ps_mgau_t *s, acmod_t *acmod);
 void s2_semi_mgau_free(ps_mgau_t *s);
 int s2_semi_mgau_frame_eval(ps_mgau_t *s,
                             int16 *senone_scores,
@@ -39,12 +39,30 @@
  * @file state_align_search.c State (and phone and word) alignment search.
  */
 
+/* System headers. */
+#include <string.h>
+
 #include "state_align_search.h"
 
+/**
+ * Segmentation iterator over the words of an alignment.
+ */
+typedef struct state_align_seg_s {
+    ps_seg_t base;
+    ps_alignment_iter_t *itor;
+} state_align_seg_t;
+
 static int
 state_align_search_start(ps_search_t *search)
 {
     state_align_search_t *sas = (state_align_search_t *)search;
+    int i;
+
+    /* Forget the previous utterance. */
+    for (i = 0; i < sas->n_phones; ++i)
+        hmm_clear(sas->hmms + i);
+    sas->best_score = 0;
+    sas->aligned = FALSE;
 
     /* Activate the initial state. */
     hmm_enter(sas->hmms, 0, 0, 0);
@@ -246,6 +264,7 @@ state_align_search_finish(ps_search_t *search)
             ent->start, last_frame);
     ps_alignment_iter_free(itor);
     ps_alignment_propagate(sas->al);
+    sas->aligned = TRUE;
 
     return 0;
 }
@@ -265,9 +284,112 @@ state_align_search_free(ps_search_t *search)
     ckd_free(sas->hmms);
     ckd_free(sas->tokens);
     hmm_context_free(sas->hmmctx);
+    ps_alignment_free(sas->al);
     ckd_free(sas);
 }
 
+static char const *
+state_align_search_hyp(ps_search_t *search, int32 *out_score)
+{
+    state_align_search_t *sas = (state_align_search_t *)search;
+    ps_alignment_iter_t *itor;
+    size_t len;
+
+    if (!sas->aligned)
+        return NULL;
+    if (out_score)
+        *out_score = hmm_out_score(sas->hmms + sas->n_phones - 1);
+
+    /* Words of the transcript, without silences and fillers. */
+    len = 1;
+    for (itor = ps_alignment_words(sas->al); itor;
+         itor = ps_alignment_iter_next(itor)) {
+        ps_alignment_entry_t *ent = ps_alignment_iter_get(itor);
+        if (dict_real_word(ps_search_dict(search), ent->id.wid))
+            len += strlen(dict_wordstr(ps_search_dict(search), ent->id.wid)) + 1;
+    }
+    ckd_free(search->hyp_str);
+    search->hyp_str = ckd_calloc(1, len);
+    for (itor = ps_alignment_words(sas->al); itor;
+         itor = ps_alignment_iter_next(itor)) {
+        ps_alignment_entry_t *ent = ps_alignment_iter_get(itor);
+        if (!dict_real_word(ps_search_dict(search), ent->id.wid))
+            continue;
+        if (search->hyp_str[0] != '\0')
+            strcat(search->hyp_str, " ");
+        strcat(search->hyp_str,
+               dict_wordstr(ps_search_dict(search), ent->id.wid));
+    }
+    return search->hyp_str;
+}
+
+static int32
+state_align_search_prob(ps_search_t *search)
+{
+    /* There is only one path, its posterior probability is one. */
+    return 0;
+}
+
+static void
+state_align_search_fill_iter(ps_seg_t *seg, ps_alignment_entry_t *ent)
+{
+    seg->word = dict_wordstr(ps_search_dict(seg->search), ent->id.wid);
+    seg->sf = ent->start;
+    seg->ef = ent->start + ent->duration - 1;
+    seg->ascr = ent->score;
+    seg->lscr = 0;
+    seg->prob = 0;
+}
+
+static void
+state_align_search_seg_free(ps_seg_t *seg)
+{
+    state_align_seg_t *itor = (state_align_seg_t *)seg;
+
+    ps_alignment_iter_free(itor->itor);
+    ckd_free(itor);
+}
+
+static ps_seg_t *
+state_align_search_seg_next(ps_seg_t *seg)
+{
+    state_align_seg_t *itor = (state_align_seg_t *)seg;
+
+    itor->itor = ps_alignment_iter_next(itor->itor);
+    if (itor->itor == NULL) {
+        state_align_search_seg_free(seg);
+        return NULL;
+    }
+    state_align_search_fill_iter(seg, ps_alignment_iter_get(itor->itor));
+    return seg;
+}
+
+static ps_segfuncs_t state_align_segfuncs = {
+    /* seg_next */ state_align_search_seg_next,
+    /* seg_free */ state_align_search_seg_free
+};
+
+static ps_seg_t *
+state_align_search_seg_iter(ps_search_t *search)
+{
+    state_align_search_t *sas = (state_align_search_t *)search;
+    state_align_seg_t *itor;
+
+    if (!sas->aligned)
+        return NULL;
+
+    itor = ckd_calloc(1, sizeof(*itor));
+    itor->base.vt = &state_align_segfuncs;
+    itor->base.search = search;
+    itor->itor = ps_alignment_words(sas->al);
+    if (itor->itor == NULL) {
+        ckd_free(itor);
+        return NULL;
+    }
+    state_align_search_fill_iter(&itor->base, ps_alignment_iter_get(itor->itor));
+    return &itor->base;
+}
+
 static ps_searchfuncs_t state_align_search_funcs = {
     /* start: */  state_align_search_start,
     /* step: */   state_align_search_step,
@@ -275,9 +397,9 @@ static ps_searchfuncs_t state_align_search_funcs = {
     /* reinit: */ state_align_search_reinit,
     /* free: */   state_align_search_free,
     /* lattice: */  NULL,
-    /* hyp: */      NULL,
-    /* prob: */     NULL,
-    /* seg_iter: */ NULL,
+    /* hyp: */      state_align_search_hyp,
+    /* prob: */     state_align_search_prob,
+    /* seg_iter: */ state_align_search_seg_iter,
 };
 
 ps_search_t *
@@ -300,7 +422,7 @@ state_align_search_init(const char *name,
         ckd_free(sas);
         return NULL;
     }
-    sas->al = al;
+    sas->al = ps_alignment_retain(al);
 
     /* Generate HMM vector from phone level of alignment. */
     sas->n_phones = ps_alignment_n_phones(al);
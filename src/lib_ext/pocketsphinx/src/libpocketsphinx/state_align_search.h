@@ -76,6 +76,7 @@ struct state_align_search_s {
     int n_emit_state;       /**< Number of emitting states (tokens per frame) */
     state_align_hist_t *tokens;         /**< Tokens (backpointers) for state alignment. */
     int n_fr_alloc;         /**< Number of frames of tokens allocated. */
+    int aligned;            /**< Whether the last utterance reached the final state. */
 };
 typedef struct state_align_search_s state_align_search_t;
 
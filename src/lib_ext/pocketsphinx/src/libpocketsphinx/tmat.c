@@ -150,6 +150,7 @@ tmat_init(char const *file_name, logmath_t *lmath, float64 tpfloor, int32 brepor
     }
 
     t = (tmat_t *) ckd_calloc(1, sizeof(tmat_t));
+    t->refcount = 1;
 
     if ((fp = fopen(file_name, "rb")) == NULL)
         E_FATAL_SYSTEM("Failed to open transition file '%s' for reading", file_name);
@@ -268,13 +269,20 @@ tmat_report(tmat_t * t)
 
 }
 
+tmat_t *
+tmat_retain(tmat_t * t)
+{
+    ++t->refcount;
+    return t;
+}
+
 /* 
  *  RAH, Free memory allocated in tmat_init ()
  */
 void
 tmat_free(tmat_t * t)
 {
-    if (t) {
+    if (t && --t->refcount == 0) {
         if (t->tp)
             ckd_free_3d(t->tp);
         ckd_free(t);
@@ -58,6 +58,7 @@ typedef struct {
     int16 n_tmat;	/**< Number matrices */
     int16 n_state;	/**< Number source states in matrix (only the emitting states);
 			   Number destination states = n_state+1, it includes the exit state */
+    int refcount;       /**< Reference count, matrices are shared by decoders using one model */
 } tmat_t;
 
 
@@ -78,8 +79,18 @@ void tmat_dump (tmat_t *tmat,  /**< In: transition matrix */
     );	
 
 
+/**
+ * Retain a transition matrix.
+ *
+ * @return pointer to retained matrix.
+ */
+tmat_t *tmat_retain(tmat_t *t /**< In: transition matrix */
+    );
+
 /**
  * RAH, add code to remove memory allocated by tmat_init
+ *
+ * Only frees the matrices once the last reference is released.
  */
 
 void tmat_free (tmat_t *t /**< In: transition matrix */
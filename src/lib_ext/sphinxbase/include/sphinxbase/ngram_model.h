@@ -107,6 +107,35 @@ ngram_model_t *ngram_model_read(cmd_ln_t *config,
                                 ngram_file_type_t file_type,
 				logmath_t *lmath);
 
+/**
+ * Build an N-Gram model from N-Grams estimated in memory.
+ *
+ * Takes the contents of an ARPA file without reading one: word i is
+ * unigram i, and the N-Grams of each order are given as word ids,
+ * history first, with log10 probabilities and back-off weights.
+ *
+ * @param config Optional pointer to a set of command-line arguments,
+ *               as for ngram_model_read().
+ * @param lmath Log-math parameters to use for probability calculations.
+ * @param order Order of the model, at most NGRAM_MAX_ORDER.
+ * @param counts Number of N-Grams of each order, counts[0] words.
+ * @param words The words, counts[0] of them.
+ * @param ngrams For each order N > 1 (ngrams[N - 1]), counts[N - 1] * N
+ *               word ids.  ngrams[0] is not used.
+ * @param probs For each order (probs[N - 1]), counts[N - 1] log10
+ *              probabilities.
+ * @param backoffs For each order below @a order, counts[N - 1] log10
+ *                 back-off weights.
+ * @return newly created ngram_model_t, or NULL on error.
+ */
+SPHINXBASE_EXPORT
+ngram_model_t *ngram_model_build(cmd_ln_t *config, logmath_t *lmath,
+                                 int order, const uint32 *counts,
+                                 const char *const *words,
+                                 const uint32 *const *ngrams,
+                                 const float32 *const *probs,
+                                 const float32 *const *backoffs);
+
 /**
  * Write an N-Gram model to disk.
  *
@@ -188,6 +188,14 @@ int sbmtx_unlock(sbmtx_t *mtx);
 SPHINXBASE_EXPORT
 void sbmtx_free(sbmtx_t *mtx);
 
+/**
+ * Atomically add to a reference count shared between threads.
+ *
+ * @return the count after adding <code>n</code>.
+ */
+SPHINXBASE_EXPORT
+int sbatomic_add(int volatile *count, int n);
+
 /**
  * Initialize an event.
  */
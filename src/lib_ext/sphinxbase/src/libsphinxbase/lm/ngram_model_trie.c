@@ -228,6 +228,98 @@ ngram_model_trie_read_arpa(cmd_ln_t * config,
     return base;
 }
 
+ngram_model_t *
+ngram_model_build(cmd_ln_t * config, logmath_t * lmath, int order,
+                  const uint32 * counts, const char *const *words,
+                  const uint32 * const *ngrams,
+                  const float32 * const *probs,
+                  const float32 * const *backoffs)
+{
+    ngram_model_trie_t *model;
+    ngram_model_t *base;
+    uint32 trie_counts[NGRAM_MAX_ORDER];
+    uint32 i;
+    int n, k;
+
+    if (order < 1 || order > NGRAM_MAX_ORDER || counts[0] == 0) {
+        E_ERROR("Can not build LM of order %d with %d words\n", order,
+                order > 0 ? counts[0] : 0);
+        return NULL;
+    }
+    memcpy(trie_counts, counts, order * sizeof(*trie_counts));
+
+    model = (ngram_model_trie_t *) ckd_calloc(1, sizeof(*model));
+    base = &model->base;
+    ngram_model_init(base, &ngram_model_trie_funcs, lmath, order,
+                     (int32) counts[0]);
+    base->writable = TRUE;
+
+    /* Same as reading the unigrams of an ARPA file. */
+    model->trie = lm_trie_create(counts[0], order);
+    for (i = 0; i < counts[0]; i++) {
+        unigram_t *unigram = &model->trie->unigrams[i];
+
+        unigram->prob = logmath_log10_to_log_float(lmath, probs[0][i]);
+        if (unigram->prob > 0)
+            unigram->prob = 0;
+        unigram->bo = order > 1
+            ? logmath_log10_to_log_float(lmath, backoffs[0][i]) : 0.0f;
+        base->word_str[i] = ckd_salloc(words[i]);
+        if ((hash_table_enter(base->wid, base->word_str[i],
+                              (void *) (long) i)) != (void *) (long) i) {
+            E_WARN("Duplicate word in dictionary: %s\n", base->word_str[i]);
+        }
+    }
+
+    /* And the higher orders, with words stored last word first. */
+    if (order > 1) {
+        ngram_raw_t **raw_ngrams =
+            (ngram_raw_t **) ckd_calloc(order - 1, sizeof(*raw_ngrams));
+
+        for (n = 2; n <= order; n++) {
+            raw_ngrams[n - 2] =
+                (ngram_raw_t *) ckd_calloc(counts[n - 1] + 1,
+                                           sizeof(*raw_ngrams[n - 2]));
+            for (i = 0; i < counts[n - 1]; i++) {
+                ngram_raw_t *raw = &raw_ngrams[n - 2][i];
+
+                raw->order = n;
+                raw->prob = probs[n - 1][i] > 0 ? 0.0f
+                    : logmath_log10_to_log_float(lmath, probs[n - 1][i]);
+                raw->backoff = n < order
+                    ? logmath_log10_to_log_float(lmath, backoffs[n - 1][i])
+                    : 0.0f;
+                raw->words = (uint32 *) ckd_calloc(n, sizeof(*raw->words));
+                for (k = 0; k < n; k++)
+                    raw->words[k] = ngrams[n - 1][i * n + n - 1 - k];
+            }
+            qsort(raw_ngrams[n - 2], counts[n - 1], sizeof(ngram_raw_t),
+                  &ngram_ord_comparator);
+        }
+        lm_trie_build(model->trie, raw_ngrams, trie_counts, base->n_counts,
+                      order);
+        ngrams_raw_free(raw_ngrams, trie_counts, order);
+    }
+    else {
+        base->n_counts[0] = counts[0];
+    }
+
+    /* Now set weights based on config if present. */
+    if (config) {
+        float32 lw = 1.0;
+        float32 wip = 1.0;
+
+        if (cmd_ln_exists_r(config, "-lw"))
+            lw = cmd_ln_float32_r(config, "-lw");
+        if (cmd_ln_exists_r(config, "-wip"))
+            wip = cmd_ln_float32_r(config, "-wip");
+
+        ngram_model_apply_weights(base, lw, wip);
+    }
+
+    return base;
+}
+
 int
 ngram_model_trie_write_arpa(ngram_model_t * base, const char *path)
 {
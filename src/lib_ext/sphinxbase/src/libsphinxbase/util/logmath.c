@@ -45,10 +45,11 @@
 #include "sphinxbase/mmio.h"
 #include "sphinxbase/bio.h"
 #include "sphinxbase/strfuncs.h"
+#include "sphinxbase/sbthread.h"
 
 struct logmath_s {
     logadd_t t;
-    int refcount;
+    int volatile refcount;  /* decoders sharing a model retain it from their own threads */
     mmio_file_t *filemap;
     float64 base;
     float64 log_of_base;
@@ -334,17 +335,19 @@ error_out:
 logmath_t *
 logmath_retain(logmath_t *lmath)
 {
-    ++lmath->refcount;
+    sbatomic_add(&lmath->refcount, 1);
     return lmath;
 }
 
 int
 logmath_free(logmath_t *lmath)
 {
+    int refcount;
+
     if (lmath == NULL)
         return 0;
-    if (--lmath->refcount > 0)
-        return lmath->refcount;
+    if ((refcount = sbatomic_add(&lmath->refcount, -1)) > 0)
+        return refcount;
     if (lmath->filemap)
         mmio_file_unmap(lmath->filemap);
     else
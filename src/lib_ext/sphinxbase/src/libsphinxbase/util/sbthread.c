@@ -223,6 +223,12 @@ sbmtx_free(sbmtx_t *mtx)
     ckd_free(mtx);
 }
 
+int
+sbatomic_add(int volatile *count, int n)
+{
+    return InterlockedExchangeAdd((LONG volatile *)count, n) + n;
+}
+
 sbmsgq_t *
 sbmsgq_init(size_t depth)
 {
@@ -704,6 +710,12 @@ sbmtx_free(sbmtx_t *mtx)
     pthread_mutex_destroy(&mtx->mtx);
     ckd_free(mtx);
 }
+
+int
+sbatomic_add(int volatile *count, int n)
+{
+    return __sync_add_and_fetch(count, n);
+}
 #endif /* not WIN32 */
 
 cmd_ln_t *
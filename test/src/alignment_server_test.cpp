@@ -0,0 +1,149 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef WIN32
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../../src/lib_ccaligner/alignment_server.h"
+#include "test_data.h"
+
+namespace {
+    const std::string socketPath = "server_test/ccaligner.sock";
+    const std::string subtitles = "1\n00:00:00,000 --> 00:00:03,000\ngo forward ten meters\n\n";
+
+    Params serving(const std::string& queue) {
+        return parse({"--serve", socketPath, "-workdir", "server_test/work", "-queue", queue, "-model", dataPath + "model/en-us/en-us",
+                      "-lm", dataPath + "test/data/turtle.lm.bin", "-dict", dataPath + "test/data/turtle.dic",
+                      "--generate-grammar", "no"});
+    }
+
+    int connectTo(const std::string& path) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+
+        int client = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(client, (sockaddr *) &address, sizeof(address)) != 0) {
+            close(client);
+            return -1;
+        }
+        return client;
+    }
+
+    std::string receiveAll(int client) {
+        std::string reply;
+        char data[4096];
+        for (ssize_t received; (received = recv(client, data, sizeof(data), 0)) > 0; )
+            reply.append(data, received);
+        close(client);
+        return reply;
+    }
+
+    std::string request(const std::string& fields) {
+        int client = connectTo(socketPath);
+        send(client, fields.data(), fields.size(), 0);
+        return receiveAll(client);
+    }
+
+    // the lines of a reply, with the output sent in between gathered into output
+    std::vector<std::string> events(const std::string& reply, std::string& output) {
+        std::vector<std::string> lines;
+        std::istringstream in(reply);
+        for (std::string line; std::getline(in, line); ) {
+            if (line.compare(0, 7, "output ") == 0) {
+                std::string chunk(std::stoul(line.substr(7)), '\0');
+                in.read(&chunk[0], chunk.size());
+                output += chunk;
+            }
+            else
+                lines.push_back(line);
+        }
+        return lines;
+    }
+}
+
+TEST(AlignmentServer, StreamsOutputOfRequests) {
+    Workspace("server_test").create();
+    Params params = serving("2");
+    AlignmentServer server(&params);
+    std::thread serving([&server] { server.serve(); });
+
+    std::string samples = fileContents(dataPath + "test/data/goforward.raw");
+    std::string output;
+    std::vector<std::string> reply = events(request("pcm " + std::to_string(samples.size()) + "\n" + samples +
+                                                    "srt " + std::to_string(subtitles.size()) + "\n" + subtitles + "\n"), output);
+
+    ASSERT_EQ(reply, std::vector<std::string>({"queued 0", "started", "done"}));
+    ASSERT_NE(output.find("\"meters\""), std::string::npos);
+
+    output.clear();
+    reply = events(request("audio server_test/missing.wav\nsubtitles server_test/missing.srt\n\n"), output);
+    ASSERT_EQ(reply.back(), "failed Unable to open subtitles server_test/missing.srt");
+    ASSERT_TRUE(output.empty());
+
+    ASSERT_EQ(request("audio a.wav\n\n"), "failed A request needs audio and subtitles\n");
+    ASSERT_EQ(request("video a.mp4\n\n"), "failed Unknown field 'video' in the request\n");
+
+    server.stop();
+    serving.join();
+    ASSERT_TRUE(Workspace("server_test").remove());
+}
+
+TEST(AlignmentServer, AnswersBusyWhenFull) {
+    Workspace("server_test").create();
+    Params params = serving("0");
+    AlignmentServer server(&params);
+    std::thread serving([&server] { server.serve(); });
+
+    // one job and no queue, a request still being sent takes the only place
+    int sending = connectTo(socketPath);
+    send(sending, "audio a.wav\n", 12, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    ASSERT_EQ(request("audio a.wav\nsubtitles a.srt\n\n"), "busy\n");
+    ASSERT_THROW(AlignmentServer another(&params), IncompatibleParameters);    // the socket is taken
+
+    close(sending);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(request("audio a.wav\n\n"), "failed A request needs audio and subtitles\n");
+
+    server.stop();
+    serving.join();
+    ASSERT_TRUE(Workspace("server_test").remove());
+}
+
+TEST(AlignmentServer, CancelledAlignment) {
+    Workspace("server_test/work").create();
+    std::ofstream("server_test/goforward.srt") << subtitles;
+    Params params = parse({"-raw", dataPath + "test/data/goforward.raw", "-srt", "server_test/goforward.srt", "-out", "server_test/goforward.json",
+                           "-workdir", "server_test/work", "-model", dataPath + "model/en-us/en-us", "-lm", dataPath + "test/data/turtle.lm.bin",
+                           "-dict", dataPath + "test/data/turtle.dic", "--generate-grammar", "no", "-oFormat", "json"});
+
+    std::atomic<bool> cancelled(true);
+    ASSERT_THROW(PocketsphinxAligner(&params, nullptr, &cancelled).align(), AlignmentCancelled);
+    ASSERT_EQ(fileContents("server_test/goforward.json").find("\"meters\""), std::string::npos);
+
+    ASSERT_THROW(parse({"--serve", socketPath, "-wav", "a.wav"}), IncompatibleParameters);
+    ASSERT_THROW(parse({"--serve", socketPath, "-batch", "manifest.tsv"}), IncompatibleParameters);
+    ASSERT_THROW(parse({"-oFormat", "xml", "--serve", socketPath}), IncompatibleParameters);
+    ASSERT_THROW(parse({"--serve", socketPath, "-queue", "-1"}), InvalidParameters);
+    ASSERT_THROW(parse({"--serve", socketPath, "-queue", "100000"}), InvalidParameters);
+    ASSERT_THROW(parse({"--serve", socketPath, "-jobs", "-1"}), InvalidParameters);
+    ASSERT_EQ(parse({"--serve", socketPath}).outputFormat, json);
+    ASSERT_TRUE(Workspace("server_test").remove());
+}
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../../src/lib_ccaligner/audio_converter.h"
+
+namespace {
+    WaveFormat makeFormat(int audioFormat, int numChannels, unsigned long sampleRate, int bitsPerSample) {
+        WaveFormat format;
+        format.audioFormat = audioFormat;
+        format.numChannels = numChannels;
+        format.sampleRate = sampleRate;
+        format.bitsPerSample = bitsPerSample;
+        format.blockAlign = numChannels * bitsPerSample / 8;
+        format.byteRate = sampleRate * format.blockAlign;
+        return format;
+    }
+
+    void putLittleEndian(std::vector<unsigned char>& bytes, unsigned long value, int numberOfBytes) {
+        for (int i = 0; i < numberOfBytes; i++)
+            bytes.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+    }
+
+    void putFloat(std::vector<unsigned char>& bytes, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putLittleEndian(bytes, bits, 4);
+    }
+
+    // Stereo 16 bit tone of given frequency, silent before startFrame.
+    std::vector<unsigned char> stereoTone(unsigned long sampleRate, std::size_t numberOfFrames, double frequency, std::size_t startFrame) {
+        std::vector<unsigned char> bytes;
+        for (std::size_t i = 0; i < numberOfFrames; i++) {
+            double value = i < startFrame ? 0 : 16000 * std::sin(2 * M_PI * frequency * i / sampleRate);
+            putLittleEndian(bytes, static_cast<uint16_t>(static_cast<int16_t>(value)), 2);
+            putLittleEndian(bytes, static_cast<uint16_t>(static_cast<int16_t>(value)), 2);
+        }
+        return bytes;
+    }
+
+    std::vector<int16_t> convertInChunks(const WaveFormat& format, const std::vector<unsigned char>& bytes, std::size_t framesPerCall) {
+        AudioConverter converter(format);
+        std::vector<int16_t> output;
+        std::size_t numberOfFrames = bytes.size() / format.blockAlign;
+
+        for (std::size_t frame = 0; frame < numberOfFrames; frame += framesPerCall)
+            converter.convert(bytes.data() + frame * format.blockAlign, std::min(framesPerCall, numberOfFrames - frame), output);
+
+        converter.flush(output);
+        return output;
+    }
+}
+
+TEST(AudioConverter, DownmixesStereoPCM) {
+    WaveFormat format = makeFormat(pcmFormat, 2, 16000, 16);
+    std::vector<unsigned char> bytes;
+    for (int i = 0; i < 13; i++) {     // odd count, covers the vectorised loop and its tail
+        putLittleEndian(bytes, static_cast<uint16_t>(static_cast<int16_t>(i * 1000 - 6000)), 2);
+        putLittleEndian(bytes, static_cast<uint16_t>(static_cast<int16_t>(-i * 333)), 2);
+    }
+
+    std::vector<float> mono(13);
+    downmixToFloat(bytes.data(), 13, format, mono.data());
+
+    for (int i = 0; i < 13; i++)
+        ASSERT_FLOAT_EQ(mono[i], ((i * 1000 - 6000) + (-i * 333)) / 2.0f);
+}
+
+TEST(AudioConverter, DownmixesFloatAndWideFormats) {
+    std::vector<unsigned char> floats;
+    for (int i = 0; i < 7; i++) {
+        putFloat(floats, i * 0.1f);
+        putFloat(floats, -0.5f);
+    }
+
+    std::vector<float> mono(7);
+    downmixToFloat(floats.data(), 7, makeFormat(floatFormat, 2, 48000, 32), mono.data());
+
+    for (int i = 0; i < 7; i++)
+        ASSERT_NEAR(mono[i], (i * 0.1f - 0.5f) * 16384.0f, 0.01f);
+
+    std::vector<unsigned char> wide;    // 5.1, 24 bit : only the first channel is non zero
+    for (int i = 0; i < 3; i++) {
+        putLittleEndian(wide, static_cast<uint32_t>(-6 * 65536 * (i + 1)) & 0xFFFFFF, 3);
+        for (int channel = 1; channel < 6; channel++)
+            putLittleEndian(wide, 0, 3);
+    }
+
+    downmixToFloat(wide.data(), 3, makeFormat(pcmFormat, 6, 48000, 24), mono.data());
+
+    for (int i = 0; i < 3; i++)
+        ASSERT_FLOAT_EQ(mono[i], -256.0f * (i + 1));
+
+    std::vector<unsigned char> unsignedBytes = {0, 128, 255};
+    downmixToFloat(unsignedBytes.data(), 3, makeFormat(pcmFormat, 1, 8000, 8), mono.data());
+
+    ASSERT_FLOAT_EQ(mono[0], -32768.0f);
+    ASSERT_FLOAT_EQ(mono[1], 0.0f);
+    ASSERT_FLOAT_EQ(mono[2], 32512.0f);
+}
+
+TEST(AudioConverter, ResamplesToSixteenKHz) {
+    const unsigned long rates[] = {8000, 22050, 44100, 48000};
+
+    for (unsigned long rate : rates) {
+        WaveFormat format = makeFormat(pcmFormat, 2, rate, 16);
+        std::vector<int16_t> output = convertInChunks(format, stereoTone(rate, rate, 1000, rate / 2), 1234);
+
+        ASSERT_EQ(output.size(), 16000u) << rate;
+
+        // tone starts half way, resampler delay must not move it
+        std::size_t onset = 0;
+        while (onset < output.size() && std::abs(output[onset]) < 4000)
+            onset++;
+        ASSERT_NEAR(static_cast<double>(onset), 8000.0, 8.0) << rate;
+
+        int zeroCrossings = 0;
+        for (std::size_t i = 8100; i < 15900; i++)
+            zeroCrossings += (output[i - 1] < 0) != (output[i] < 0);
+        ASSERT_NEAR(zeroCrossings, 2 * 1000 * 7800 / 16000, 4) << rate;
+    }
+}
+
+TEST(AudioConverter, OnlyDownmixesAtSixteenKHz) {
+    WaveFormat format = makeFormat(pcmFormat, 2, 16000, 16);
+    std::vector<unsigned char> bytes = stereoTone(16000, 1000, 440, 0);
+    std::vector<int16_t> output = convertInChunks(format, bytes, 333);
+
+    ASSERT_EQ(output.size(), 1000u);
+    for (std::size_t i = 0; i < output.size(); i++)
+        ASSERT_EQ(output[i], static_cast<int16_t>(bytes[4 * i] | (bytes[4 * i + 1] << 8)));
+}
@@ -0,0 +1,82 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../src/lib_ccaligner/batch_aligner.h"
+#include "test_data.h"
+
+TEST(BatchAligner, JobParameters) {
+    Params batch = parse({"-batch", "batch_test/manifest.tsv", "-workdir", "batch_test/work", "-oFormat", "json", "-jobs", "4"});
+    ASSERT_EQ(batch.summaryFileName, "batch_test/manifest.tsv.summary.tsv");
+    ASSERT_EQ(batch.jobs, 4u);
+
+    Params job = batch.forJob("audio/episode.wav", "audio/episode.srt", "");
+    ASSERT_EQ(job.audioFileName, "audio/episode.wav");
+    ASSERT_EQ(job.outputFileName, "audio/episode.json");
+    ASSERT_EQ(job.workspacePath.compare(0, 19, "batch_test/work/job"), 0);
+    ASSERT_EQ(job.lmPath, job.workspacePath + "/lm/complete.lm");
+    ASSERT_TRUE(job.manifestFileName.empty());
+    ASSERT_TRUE(job.removeWorkspace);
+    ASSERT_FALSE(job.displayRecognised);
+
+    ASSERT_NE(batch.forJob("a.wav", "a.srt", "").workspacePath, job.workspacePath);
+    ASSERT_EQ(batch.forJob("a.wav", "a.srt", "out/a.json").outputFileName, "out/a.json");
+
+    ASSERT_THROW(parse({"-batch", "manifest.tsv", "-wav", "a.wav"}), IncompatibleParameters);
+    ASSERT_THROW(parse({"-batch", "manifest.tsv", "-jobs", "-1"}), InvalidParameters);
+    ASSERT_EQ(parse({"-batch", "manifest.tsv", "-jobs", "100000"}).jobs, 64u);
+    ASSERT_THROW(parse({"-batch", "manifest.tsv", "--live", "yes"}), IncompatibleParameters);
+    ASSERT_THROW(parse({"-batch", "manifest.tsv", "-jobs", "0"}), InvalidParameters);
+}
+
+TEST(BatchAligner, IsolatesFailedJobs) {
+    Workspace("batch_test").create();
+    writeGoForward("batch_test/goforward.wav");
+    std::ofstream("batch_test/goforward.srt") << "1\n00:00:00,000 --> 00:00:03,000\ngo forward ten meters\n\n";
+    std::ofstream("batch_test/empty.wav") << "not a wave";
+    std::ofstream("batch_test/manifest.tsv")
+        << "# audio\tsubtitles\toutput\n"
+        << "batch_test/goforward.wav\tbatch_test/goforward.srt\tbatch_test/first.json\n\n"
+        << "batch_test/goforward.wav\tbatch_test/missing.srt\n"
+        << "batch_test/empty.wav\tbatch_test/goforward.srt\tbatch_test/empty.json\n"
+        << "batch_test/goforward.wav batch_test/goforward.srt\n"
+        << "batch_test/goforward.wav\tbatch_test/goforward.srt\tbatch_test/second.json\n";
+
+    Params params = parse({"-batch", "batch_test/manifest.tsv", "-workdir", "batch_test/work", "-model", dataPath + "model/en-us/en-us",
+                           "-lm", dataPath + "test/data/turtle.lm.bin", "-dict", dataPath + "test/data/turtle.dic",
+                           "--generate-grammar", "no", "-oFormat", "json", "-jobs", "2"});
+
+    BatchAligner batch(&params);
+    ASSERT_FALSE(batch.align());    // one bad file does not stop the others
+
+    const std::vector<BatchJob>& jobs = batch.jobs();
+    ASSERT_EQ(jobs.size(), 5u);
+    std::size_t lines[] = {2, 4, 5, 6, 7};
+    bool aligned[] = {true, false, false, false, true};
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        ASSERT_EQ(jobs[i].line, lines[i]);
+        ASSERT_EQ(jobs[i].aligned, aligned[i]) << jobs[i].error;
+        ASSERT_EQ(jobs[i].error.empty(), aligned[i]);
+    }
+    ASSERT_NE(jobs[1].error.find("batch_test/missing.srt"), std::string::npos);
+
+    std::string first = fileContents("batch_test/first.json");
+    ASSERT_NE(first.find("\"meters\""), std::string::npos);
+    ASSERT_EQ(fileContents("batch_test/second.json"), first);
+
+    std::istringstream summary(fileContents("batch_test/manifest.tsv.summary.tsv"));
+    std::string line;
+    std::size_t numberOfLines = 0;
+    while (std::getline(summary, line))
+        numberOfLines++;
+    ASSERT_EQ(numberOfLines, 6u);
+
+    ASSERT_TRUE(Workspace("batch_test").remove());
+}
@@ -0,0 +1,35 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../../src/lib_ccaligner/caption_stream.h"
+#include "../../src/lib_ccaligner/commons.h"
+
+TEST(CaptionStream, ReadsCuesInOrder) {
+    std::istringstream in("\n1\r\n00:00:01,000 --> 00:00:03,500\r\nGo forward\r\nten meters\r\n\r\n\n"
+                          "2\n00:00:04,000 -> 00:00:05,000\nmalformed\n\n"
+                          "3\n00:00:06,000 --> 00:00:07,250\nGo backward");
+    CaptionStream captions(in);
+
+    std::unique_ptr<SubtitleItem> first = captions.next();
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(first->getSubNo(), 1);
+    ASSERT_EQ(first->getStartTime(), 1000);
+    ASSERT_EQ(first->getEndTime(), 3500);
+    ASSERT_EQ(first->getDialogue(), "Go forward ten meters");
+
+    std::unique_ptr<SubtitleItem> last = captions.next();   // the malformed cue is skipped, the last needs no blank line
+    ASSERT_NE(last, nullptr);
+    ASSERT_EQ(last->getSubNo(), 3);
+    ASSERT_EQ(last->getEndTime(), 7250);
+    ASSERT_EQ(last->getDialogue(), "Go backward");
+
+    ASSERT_EQ(captions.next(), nullptr);
+    ASSERT_EQ(captions.next(), nullptr);
+
+    ASSERT_THROW(CaptionStream("path/to/missing/captions.srt"), FileNotFound);
+}
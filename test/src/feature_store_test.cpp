@@ -0,0 +1,129 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include "../../src/lib_ccaligner/feature_store.h"
+
+namespace {
+    class VectorSource : public SampleSource {
+        std::vector<int16_t> _samples;
+    public:
+        explicit VectorSource(std::vector<int16_t> samples) : _samples(std::move(samples)) {}
+
+        SampleView getSamples(long int firstSample, long int numberOfSamples) override {
+            long int size = static_cast<long int>(_samples.size());
+            long int begin = std::min(std::max(firstSample, 0L), size);
+            long int end = std::min(std::max(firstSample + numberOfSamples, begin), size);
+            return SampleView(_samples.data() + begin, end - begin, begin);
+        }
+
+        SampleView all() const { return SampleView(_samples.data(), _samples.size()); }
+    };
+
+    std::vector<int16_t> chirp(std::size_t numberOfSamples) {
+        std::vector<int16_t> samples(numberOfSamples);
+        for (std::size_t i = 0; i < numberOfSamples; i++)
+            samples[i] = static_cast<int16_t>(8000 * std::sin(0.00001 * i * i) + (i * 7919 % 255) - 127);
+        return samples;
+    }
+
+    cmd_ln_t *frontEndConfig(const char *lowerFrequency = "133.33334") {
+        // noise removal adapts over time; without it frames depend only on their own samples
+        return cmd_ln_init(nullptr, ps_args(), TRUE, "-remove_noise", "no", "-lowerf", lowerFrequency, nullptr);
+    }
+}
+
+TEST(FeatureStore, FramesLineUpWithSamples) {
+    cmd_ln_t *config = frontEndConfig();
+    std::vector<int16_t> samples = chirp(150000);   // more than one block
+    std::vector<int16_t> delayed(160 * 25, 0);      // silence, which must not be dropped
+    delayed.insert(delayed.end(), samples.begin(), samples.end());
+
+    VectorSource audio(samples), delayedAudio(delayed);
+    FeatureStore features, delayedFeatures;
+    features.compute(audio, config);
+    delayedFeatures.compute(delayedAudio, config);
+
+    ASSERT_EQ(features.frameShift(), 160);
+    ASSERT_EQ(features.frameRate(), 100);
+    ASSERT_NEAR(static_cast<double>(features.size()), 150000.0 / 160, 3.0);
+    ASSERT_EQ(delayedFeatures.size(), features.size() + 25);
+
+    for (std::size_t i = 0; i + 1 < features.size(); i++)
+        for (int j = 0; j < features.numberOfCoefficients(); j++)
+            ASSERT_FLOAT_EQ(features.frame(i)[j], delayedFeatures.frame(i + 25)[j]) << i;
+
+    for (int j = 0; j < features.numberOfCoefficients(); j++) {
+        double sum = 0;
+        for (std::size_t i = 0; i < features.size(); i++)
+            sum += features.frame(i)[j];
+        ASSERT_NEAR(features.mean()[j], sum / features.size(), 1e-3);
+    }
+
+    cmd_ln_free_r(config);
+}
+
+TEST(FeatureStore, CacheRoundTrip) {
+    cmd_ln_t *config = frontEndConfig();
+    VectorSource audio(chirp(20000));
+    uint64_t key = FeatureStore::cacheKey(audio.all(), config);
+    std::string fileName = FeatureStore::cacheFileName(".", key);
+
+    FeatureStore computed;
+    computed.compute(audio, config);
+    ASSERT_EQ(computed.key(), key);     // hashed while computing
+    ASSERT_TRUE(computed.save(fileName));
+
+    FeatureStore loaded;
+    ASSERT_FALSE(loaded.load(fileName, key + 1, config));   // other audio or parameters
+    ASSERT_TRUE(loaded.load(fileName, key, config));
+    ASSERT_EQ(loaded.size(), computed.size());
+    ASSERT_EQ(loaded.frameShift(), computed.frameShift());
+    ASSERT_EQ(loaded.mean(), computed.mean());
+
+    std::vector<mfcc_t> buffer;
+    std::vector<mfcc_t *> rows;
+    mfcc_t **frames = loaded.copyFrames(10, 20, buffer, rows);
+    ASSERT_EQ(rows.size(), 20u);
+    for (int j = 0; j < computed.numberOfCoefficients(); j++)
+        ASSERT_EQ(frames[5][j], computed.frame(15)[j]);
+
+    loaded.copyFrames(computed.size() - 3, 20, buffer, rows);  // clamped to the audio
+    ASSERT_EQ(rows.size(), 3u);
+
+    {
+        std::ofstream truncate(fileName, std::ios::binary | std::ios::app);
+        truncate << "x";
+    }
+
+    FeatureStore corrupted;
+    ASSERT_FALSE(corrupted.load(fileName, key, config));
+
+    std::remove(fileName.c_str());
+    ASSERT_FALSE(corrupted.load(fileName, key, config));
+    cmd_ln_free_r(config);
+}
+
+TEST(FeatureStore, KeyCoversSamplesAndParameters) {
+    cmd_ln_t *config = frontEndConfig(), *otherConfig = frontEndConfig("200");
+    std::vector<int16_t> samples = chirp(1000);
+    uint64_t key = FeatureStore::cacheKey(SampleView(samples.data(), samples.size()), config);
+
+    ASSERT_NE(key, FeatureStore::cacheKey(SampleView(samples.data(), samples.size()), otherConfig));
+    ASSERT_NE(key, FeatureStore::cacheKey(SampleView(samples.data(), samples.size() - 1), config));
+
+    samples[500]++;
+    ASSERT_NE(key, FeatureStore::cacheKey(SampleView(samples.data(), samples.size()), config));
+
+    cmd_ln_set_int_r(config, "-remove_silence", 0);     // never applied to cached frames
+    samples[500]--;
+    ASSERT_EQ(key, FeatureStore::cacheKey(SampleView(samples.data(), samples.size()), config));
+
+    cmd_ln_free_r(config);
+    cmd_ln_free_r(otherConfig);
+}
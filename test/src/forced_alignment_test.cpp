@@ -0,0 +1,92 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "pocketsphinx.h"
+#include "test_data.h"
+
+namespace {
+    struct Segment {
+        std::string word;
+        int start, end;
+    };
+
+    std::vector<Segment> align(ps_decoder_t *decoder, const int16 *samples, std::size_t numberOfSamples, std::string& hypothesis) {
+        ps_start_utt(decoder);
+        ps_process_raw(decoder, samples, numberOfSamples, FALSE, TRUE);
+        ps_end_utt(decoder);
+
+        int32 score;
+        const char *hyp = ps_get_hyp(decoder, &score);
+        hypothesis = hyp == nullptr ? "" : hyp;
+
+        std::vector<Segment> segments;
+        for (ps_seg_t *iter = ps_seg_iter(decoder); iter != nullptr; iter = ps_seg_next(iter)) {
+            Segment segment{ps_seg_word(iter), 0, 0};
+            ps_seg_frames(iter, &segment.start, &segment.end);
+            segments.push_back(segment);
+        }
+        return segments;
+    }
+}
+
+TEST(ForcedAlignment, AlignsKnownWords) {
+    std::string model = dataPath + "model/en-us/en-us";
+    std::string lm = dataPath + "test/data/turtle.lm.bin", dict = dataPath + "test/data/turtle.dic";
+    cmd_ln_t *config = cmd_ln_init(nullptr, ps_args(), TRUE, "-hmm", model.c_str(), "-lm", lm.c_str(), "-dict", dict.c_str(),
+                                   "-logfn", discardedLog, nullptr);
+    ps_decoder_t *decoder = ps_init(config);
+    ASSERT_NE(decoder, nullptr);
+
+    std::vector<int16> samples = goForward();
+    ASSERT_FALSE(samples.empty());
+
+    ASSERT_LT(ps_set_align(decoder, "forced", "go forward zzyzx meters"), 0);  // not in dictionary
+    ASSERT_EQ(ps_set_align(decoder, "forced", "go forward ten meters"), 0);
+    ASSERT_EQ(ps_set_search(decoder, "forced"), 0);
+
+    std::string hypothesis;
+    std::vector<Segment> segments = align(decoder, samples.data(), samples.size(), hypothesis);
+    ASSERT_EQ(hypothesis, "go forward ten meters");
+
+    const char *expected[] = {"<s>", "go", "forward", "ten", "meters", "</s>"};
+    ASSERT_EQ(segments.size(), 6u);
+    ASSERT_EQ(segments.front().start, 0);
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        ASSERT_EQ(segments[i].word, expected[i]);
+        ASSERT_LE(segments[i].start, segments[i].end);
+        if (i > 0)
+            ASSERT_EQ(segments[i].start, segments[i - 1].end + 1) << i;    // every frame belongs to one word
+    }
+
+    // "go" is G OW, the phones fill the frames of the words
+    std::vector<std::string> phones;
+    int start, duration, filler, nextFrame = 0;
+    for (int i = 0; const char *phone = ps_get_aligned_phone(decoder, i, &start, &duration, &filler); i++) {
+        ASSERT_EQ(start, nextFrame) << i;
+        nextFrame = start + duration;
+        if (!filler)
+            phones.push_back(phone);
+    }
+    ASSERT_EQ(nextFrame, segments.back().end + 1);
+    ASSERT_GE(phones.size(), 2u);
+    ASSERT_EQ(phones[0], "G");
+    ASSERT_EQ(phones[1], "OW");
+
+    std::vector<Segment> again = align(decoder, samples.data(), samples.size(), hypothesis);   // search starts afresh
+    ASSERT_EQ(hypothesis, "go forward ten meters");
+    ASSERT_EQ(again.size(), segments.size());
+
+    align(decoder, samples.data(), 800, hypothesis);    // 50 ms can not hold every phone
+    ASSERT_EQ(hypothesis, "");
+    ASSERT_EQ(ps_seg_iter(decoder), nullptr);
+    ASSERT_EQ(ps_get_aligned_phone(decoder, 0, &start, &duration, &filler), nullptr);
+
+    ps_free(decoder);
+    cmd_ln_free_r(config);
+}
@@ -0,0 +1,92 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include "../../src/lib_ccaligner/grammar_tools.h"
+
+namespace {
+    typedef std::tuple<int, int, std::string, int> Arc;
+
+    // The grammar generate() writes to tempFiles/fsg/, for the words of a dialogue.
+    std::string fsgFile(const std::vector<std::string>& words) {
+        int numberOfWords = static_cast<int>(words.size());
+        std::ostringstream fsg;
+        fsg << "FSG_BEGIN CUSTOM_FSG\nNUM_STATES " << numberOfWords * 2 + 2 << "\nSTART_STATE 0\nFINAL_STATE " << numberOfWords * 2 + 1 << "\n\n";
+        for (int i = 0; i < numberOfWords; i++)
+            fsg << "TRANSITION 0 " << i + 1 << " 0.0909\n";
+        for (int i = numberOfWords, counter = 1; counter <= numberOfWords; i++, counter++)
+            fsg << "TRANSITION " << counter << " " << i + 1 << " 1.0 " << stringToLower(words[counter - 1]) << "\n";
+        for (int i = numberOfWords + 1; i < numberOfWords * 2 + 1; i++)
+            fsg << "TRANSITION " << i << " " << numberOfWords * 2 + 1 << " 0.0909\n";
+        fsg << "TRANSITION " << numberOfWords * 2 + 1 << " 0 0.0909\nFSG_END\n";
+        return fsg.str();
+    }
+
+    std::vector<Arc> arcs(fsg_model_t *fsg) {
+        std::vector<Arc> result;
+        for (int state = 0; state < fsg_model_n_state(fsg); state++) {
+            for (fsg_arciter_t *itor = fsg_model_arcs(fsg, state); itor; itor = fsg_arciter_next(itor)) {
+                fsg_link_t *link = fsg_arciter_get(itor);
+                result.emplace_back(fsg_link_from_state(link), fsg_link_to_state(link),
+                                    fsg_model_word_str(fsg, fsg_link_wid(link)), fsg_link_logs2prob(link));
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST(GrammarTools, SubtitleFSGMatchesFile) {
+    SubtitleItem sub(1, "00:00:01,000", "00:00:03,000", "Go forward ten meters, go", false, "", 0, 0, 0, 0, {}, {}, {}, {});
+    std::vector<std::string> words = sub.getIndividualWords();
+    ASSERT_EQ(words.size(), 5u);
+
+    std::string fileName = "grammar_tools_test.fsg";
+    {
+        std::ofstream out(fileName, std::ios::binary);
+        out << fsgFile(words);
+    }
+
+    logmath_t *lmath = logmath_init(1.0001, 0, FALSE);
+    fsg_model_t *fromFile = fsg_model_readfile(fileName.c_str(), lmath, 6.5);
+    fsg_model_t *inMemory = CreateSubtitleFSG(&sub, lmath, 6.5);
+    std::remove(fileName.c_str());
+
+    ASSERT_NE(fromFile, nullptr);
+    ASSERT_EQ(fsg_model_n_state(inMemory), fsg_model_n_state(fromFile));
+    ASSERT_EQ(fsg_model_start_state(inMemory), fsg_model_start_state(fromFile));
+    ASSERT_EQ(fsg_model_final_state(inMemory), fsg_model_final_state(fromFile));
+    ASSERT_EQ(fsg_model_n_word(inMemory), 4);  // "go" twice
+    ASSERT_EQ(arcs(inMemory), arcs(fromFile));  // including the closure of null transitions
+
+    fsg_model_free(inMemory);
+    fsg_model_free(fromFile);
+    logmath_free(lmath);
+}
+
+TEST(GrammarTools, GeneratesInMemory) {
+    SubtitleItem first(1, "00:00:01,000", "00:00:03,000", "Go forward ten meters", false, "", 0, 0, 0, 0, {}, {}, {}, {});
+    SubtitleItem second(2, "00:00:04,000", "00:00:05,000", "Go back", false, "", 0, 0, 0, 0, {}, {}, {}, {});
+
+    Grammar grammar;
+    ASSERT_TRUE(generate(std::vector<SubtitleItem*>({&first, &second}), grammar, quick_dict));
+    ASSERT_FALSE(std::ifstream("tempFiles/lm/complete.lm").good());     // nothing is written unless asked for
+
+    ASSERT_EQ(grammar.corpus, std::vector<std::string>({"<s> go forward ten meters </s>", "<s> go back </s>"}));
+    ASSERT_EQ(grammar.phoneticCorpus.size(), 2u);
+    ASSERT_EQ(grammar.phoneticCorpus[1], "SIL G OW B AE K SIL ");
+
+    ASSERT_EQ(grammar.words.vocabulary().size(), 7u);
+    ASSERT_EQ(grammar.dictionary.size(), 5u);      // without <s> and </s>
+    ASSERT_EQ(grammar.dictionary.front(), std::make_pair(std::string("back"), std::string("B AE K")));
+    ASSERT_TRUE(grammar.has(lm));
+    ASSERT_TRUE(grammar.has(phone_lm));
+}
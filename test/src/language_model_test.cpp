@@ -0,0 +1,102 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include "../../src/lib_ccaligner/language_model.h"
+
+namespace {
+    LanguageModel trainedModel() {
+        LanguageModel model;
+        model.addSentence({"go", "forward", "ten", "meters"});
+        model.addSentence({"go", "back", "ten", "meters"});
+        model.addSentence({"turn", "left"});
+        model.addSentence({"go", "forward"});
+        model.addSentence({"go", "forward", "ten", "meters", "and", "turn", "left"});
+        model.estimate();
+        return model;
+    }
+
+    // Probability of word after the history, most recent word first.
+    double probability(ngram_model_t *model, logmath_t *lmath, const std::string& word, std::vector<std::string> history) {
+        std::vector<int32> ids;
+        for (const std::string& previous : history)
+            ids.push_back(ngram_wid(model, previous.c_str()));
+        int32 used;
+        return logmath_exp(lmath, ngram_ng_prob(model, ngram_wid(model, word.c_str()), ids.data(), ids.size(), &used));
+    }
+}
+
+TEST(LanguageModel, VocabularyIsSorted) {
+    LanguageModel model = trainedModel();
+    std::vector<std::string> vocabulary = model.vocabulary();
+
+    ASSERT_EQ(vocabulary.size(), 10u);  // 8 words, <s> and </s>
+    ASSERT_TRUE(std::is_sorted(vocabulary.begin(), vocabulary.end()));
+    ASSERT_EQ(model.ngrams(1).probabilities.size(), vocabulary.size());
+    ASSERT_EQ(model.ngrams(2).backoffs.size(), model.ngrams(2).probabilities.size());
+    ASSERT_TRUE(model.ngrams(3).backoffs.empty());
+}
+
+TEST(LanguageModel, ProbabilitiesSumToOne) {
+    LanguageModel model = trainedModel();
+    logmath_t *lmath = logmath_init(1.0001, 0, FALSE);
+    ngram_model_t *lm = model.model(nullptr, lmath);
+    ASSERT_NE(lm, nullptr);
+    ASSERT_EQ(ngram_model_get_size(lm), 3);
+
+    std::vector<std::vector<std::string>> histories = {{}, {"go"}, {"forward", "go"}, {"ten"}, {"turn", "and"}, {"meters", "<s>"}};
+
+    for (const auto& history : histories) {
+        double total = 0;
+        for (const std::string& word : model.vocabulary())
+            if (word != "<s>")
+                total += probability(lm, lmath, word, history);
+        ASSERT_NEAR(total, 1.0, 0.01) << "after " << history.size() << " words";
+    }
+
+    ngram_model_free(lm);
+    logmath_free(lmath);
+}
+
+TEST(LanguageModel, ModelMatchesARPAFile) {
+    LanguageModel model = trainedModel();
+    std::string fileName = "language_model_test.lm";
+    ASSERT_TRUE(model.writeARPA(fileName));
+
+    logmath_t *lmath = logmath_init(1.0001, 0, FALSE);
+    ngram_model_t *fromFile = ngram_model_read(nullptr, fileName.c_str(), NGRAM_ARPA, lmath);
+    ngram_model_t *inMemory = model.model(nullptr, lmath);
+    std::remove(fileName.c_str());
+
+    ASSERT_NE(fromFile, nullptr);
+    ASSERT_NE(inMemory, nullptr);
+
+    for (int n = 1; n <= model.order(); n++)
+        ASSERT_EQ(ngram_model_get_counts(inMemory)[n - 1], ngram_model_get_counts(fromFile)[n - 1]);
+
+    // every word after every counted history, including the ones backing off
+    for (int n = 1; n < model.order(); n++) {
+        const LanguageModel::Ngrams& histories = model.ngrams(n);
+        for (std::size_t i = 0; i < histories.probabilities.size(); i++) {
+            std::vector<int32> history;
+            for (int k = n - 1; k >= 0; k--)
+                history.push_back(ngram_wid(fromFile, model.vocabulary()[histories.words[i * n + k]].c_str()));
+
+            for (const std::string& word : model.vocabulary()) {
+                int32 usedFile, usedMemory;
+                ASSERT_NEAR(ngram_ng_prob(inMemory, ngram_wid(inMemory, word.c_str()), history.data(), n, &usedMemory),
+                            ngram_ng_prob(fromFile, ngram_wid(fromFile, word.c_str()), history.data(), n, &usedFile), 2);
+                ASSERT_EQ(usedMemory, usedFile);
+            }
+        }
+    }
+
+    ngram_model_free(inMemory);
+    ngram_model_free(fromFile);
+    logmath_free(lmath);
+}
@@ -0,0 +1,56 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../../src/lib_ccaligner/recognize_using_pocketsphinx.h"
+#include "test_data.h"
+
+TEST(Lattice, ReadsWordsAndPosteriors) {
+    std::string model = dataPath + "model/en-us/en-us";
+    std::string lm = dataPath + "test/data/turtle.lm.bin", dict = dataPath + "test/data/turtle.dic";
+    cmd_ln_t *config = cmd_ln_init(nullptr, ps_args(), TRUE, "-hmm", model.c_str(), "-lm", lm.c_str(), "-dict", dict.c_str(),
+                                   "-logfn", discardedLog, nullptr);
+    ps_decoder_t *decoder = ps_init(config);
+    ASSERT_NE(decoder, nullptr);
+
+    std::vector<int16> samples = goForward();
+    ps_start_utt(decoder);
+    ps_process_raw(decoder, samples.data(), samples.size(), FALSE, TRUE);
+    ps_end_utt(decoder);
+
+    int32 score;
+    const char *hyp = ps_get_hyp(decoder, &score);
+    ASSERT_STREQ(hyp, "go forward ten meters");
+
+    std::vector<LatticeWord> words = readLattice(decoder, config, 1000);
+    ASSERT_GT(words.size(), 4u);
+
+    for (const LatticeWord& word : words) {
+        ASSERT_LE(word.startTime, word.endTime);
+        ASSERT_GE(word.startTime, 1000);
+        ASSERT_LE(word.posterior, 1.0 + 1e-3);
+    }
+
+    // every word of the best hypothesis is in the lattice over the same frames, and likely
+    for (ps_seg_t *iter = ps_seg_iter(decoder); iter != nullptr; iter = ps_seg_next(iter)) {
+        std::string segmentWord = ps_seg_word(iter);
+        if (segmentWord[0] == '<')
+            continue;
+
+        int start, end;
+        ps_seg_frames(iter, &start, &end);
+
+        auto found = std::find_if(words.begin(), words.end(), [&](const LatticeWord& word) {
+            return word.word == segmentWord && word.startTime == 1000 + start * 10 && word.endTime == 1000 + end * 10;
+        });
+        ASSERT_NE(found, words.end()) << segmentWord;
+        ASSERT_GT(found->posterior, 0.5) << segmentWord;
+    }
+
+    ps_free(decoder);
+    cmd_ln_free_r(config);
+}
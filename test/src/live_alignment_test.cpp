@@ -0,0 +1,112 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef WIN32
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include "../../src/lib_ccaligner/recognize_using_pocketsphinx.h"
+#include "test_data.h"
+
+namespace {
+    Params live(const std::string& output) {
+        return parse({"-raw", "live_test/audio.raw", "-srt", "live_test/captions.srt", "-out", output, "--live", "yes",
+                      "-latency", "500", "-history", "2000", "-workdir", "live_test/work", "-model", dataPath + "model/en-us/en-us",
+                      "-lm", dataPath + "test/data/turtle.lm.bin", "-dict", dataPath + "test/data/turtle.dic",
+                      "--generate-grammar", "no", "-oFormat", "json", "--display-recognised", "no"});
+    }
+
+    // goforward.raw three times over, half a second at a time, as a live source would send it
+    void sendAudio() {
+        std::string samples;
+        for (int i = 0; i < 3; i++)
+            samples += fileContents(dataPath + "test/data/goforward.raw");
+
+        std::ofstream audio("live_test/audio.raw", std::ios::binary);
+        for (std::size_t sent = 0; sent < samples.size(); sent += 16000) {
+            audio.write(samples.data() + sent, std::min<std::size_t>(16000, samples.size() - sent));
+            audio.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    // three seconds of "go forward ten meters" from the given second
+    std::string cueAt(int number, int second) {
+        return std::to_string(number) + "\n00:00:0" + std::to_string(second) + ",000 --> 00:00:0" + std::to_string(second + 3) +
+               ",000\ngo forward ten meters\n\n";
+    }
+}
+
+TEST(LiveAlignment, AlignsCaptionsAsAudioArrives) {
+    Workspace("live_test/work").create();
+    ASSERT_EQ(mkfifo("live_test/audio.raw", 0600), 0);
+    ASSERT_EQ(mkfifo("live_test/captions.srt", 0600), 0);
+
+    std::thread audio(sendAudio);
+    std::thread captions([&audio] {
+        std::ofstream out("live_test/captions.srt");
+        out << cueAt(1, 0) << cueAt(2, 3) << std::flush;   // before their audio, they wait for it and the latency after it
+        audio.join();
+        out << cueAt(3, 6) << std::flush;                   // after the end of the audio
+        out << cueAt(4, 0) << std::flush;                   // late, its audio is out of the history
+    });
+
+    Params params = live("live_test/live.json");
+    PocketsphinxAligner(&params).align();
+    captions.join();
+
+    std::string output = fileContents("live_test/live.json");
+    std::string tail;
+    for (char c : output.substr(output.size() - 20))
+        if (!isspace(c))
+            tail += c;
+    ASSERT_EQ(output.front(), '{');
+    ASSERT_EQ(tail.substr(tail.size() - 3), "}]}");     // the file is closed once the captions end
+    std::size_t subtitles = 0;
+    for (std::size_t at = output.find("\"subtitle\" :"); at != std::string::npos; at = output.find("\"subtitle\" :", at + 1))
+        subtitles++;
+    ASSERT_EQ(subtitles, 4u);   // every caption is written, in the order it arrived
+
+    // the first three have their audio and are recognised where it is spoken
+    for (const char *start : {"\"start\" : \"0\"", "\"start\" : \"3000\"", "\"start\" : \"6000\""})
+        ASSERT_NE(output.find(start), std::string::npos) << start;
+    ASSERT_NE(output.find("\"meters\""), std::string::npos);
+    ASSERT_TRUE(Workspace("live_test").remove());
+}
+
+TEST(LiveAlignment, LeavesCaptionReaderOnFailure) {
+    Workspace("live_test/work").create();
+    ASSERT_EQ(mkfifo("live_test/audio.raw", 0600), 0);
+    ASSERT_EQ(mkfifo("live_test/captions.srt", 0600), 0);
+
+    std::thread audio(sendAudio);
+    std::unique_ptr<std::ofstream> captions;
+    std::thread opening([&audio, &captions] {
+        captions.reset(new std::ofstream("live_test/captions.srt"));
+        audio.join();   // all of it, the audio is not read after the failure
+        *captions << cueAt(1, 0) << std::flush;     // and more may follow, the stream stays open
+    });
+
+    Params params = live("live_test/cancelled.json");
+    std::atomic<bool> cancelled(true);
+    ASSERT_THROW(PocketsphinxAligner(&params, nullptr, &cancelled).align(), AlignmentCancelled);   // the reader still waits for captions
+
+    opening.join();
+    captions.reset();   // ends the caption stream of the reader left behind
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(Workspace("live_test").remove());
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+#include "../../src/lib_ccaligner/recognize_using_pocketsphinx.h"
+#include "test_data.h"
+
+namespace {
+    // goforward.raw three times over, cues of different lengths so that workers finish out of order
+    const std::string subtitles =
+        "1\n00:00:00,000 --> 00:00:03,000\ngo forward ten meters\n\n"
+        "2\n00:00:03,000 --> 00:00:04,500\ngo forward\n\n"
+        "3\n00:00:04,500 --> 00:00:06,000\nten meters\n\n"
+        "4\n00:00:06,000 --> 00:00:09,000\ngo forward ten meters\n\n";
+
+    Params aligning(const std::string& output, std::vector<std::string> args) {
+        args.insert(args.begin(), {"-wav", "parallel_test/goforward.wav", "-srt", "parallel_test/goforward.srt", "-out", output,
+                                   "-workdir", "parallel_test/work", "-model", dataPath + "model/en-us/en-us",
+                                   "-lm", dataPath + "test/data/turtle.lm.bin", "-dict", dataPath + "test/data/turtle.dic",
+                                   "--generate-grammar", "no", "-oFormat", "json", "--display-recognised", "no"});
+        return parse(args);
+    }
+}
+
+TEST(ParallelAlignment, MatchesSerialRun) {
+    Workspace("parallel_test/work").create();
+    writeGoForward("parallel_test/goforward.wav", 3);
+    std::ofstream("parallel_test/goforward.srt") << subtitles;
+
+    Params serial = aligning("parallel_test/serial.json", {"-threads", "1", "--precompute-features", "yes"});
+    PocketsphinxAligner(&serial).align();
+
+    Params parallel = aligning("parallel_test/parallel.json", {"-threads", "3"});
+    ASSERT_TRUE(parallel.precomputeFeatures);
+    PocketsphinxAligner(&parallel).align();
+
+    std::string output = fileContents("parallel_test/serial.json");
+    ASSERT_NE(output.find("\"meters\""), std::string::npos);
+    ASSERT_EQ(fileContents("parallel_test/parallel.json"), output);     // same words, times and order
+    ASSERT_TRUE(Workspace("parallel_test").remove());
+}
+
+TEST(ParallelAlignment, TranscriptionMatchesSerialRun) {
+    Workspace("parallel_test/work").create();
+    writeGoForward("parallel_test/goforward.wav", 3);
+    std::ofstream("parallel_test/goforward.srt") << subtitles;
+
+    // each copy of goforward.raw is an utterance of its own, handed to the decoders of the pool
+    Params serial = aligning("parallel_test/serial.json", {"-transcribe", "yes", "-maxUtterance", "3000", "-threads", "1"});
+    PocketsphinxAligner(&serial).align();
+
+    Params parallel = aligning("parallel_test/parallel.json", {"-transcribe", "yes", "-maxUtterance", "3000", "-threads", "3"});
+    PocketsphinxAligner(&parallel).align();
+
+    std::string output = fileContents("parallel_test/serial.json");
+    ASSERT_EQ(fileContents("parallel_test/parallel.json"), output);
+
+    std::vector<long> starts;
+    std::regex start("\"start\" : \"([0-9]+)\"");
+    for (std::sregex_iterator match(output.begin(), output.end(), start), end; match != end; ++match)
+        starts.push_back(std::stol((*match)[1]));
+
+    ASSERT_GE(starts.size(), 12u);     // go forward ten meters, three times
+    for (std::size_t i = 1; i < starts.size(); i++)
+        ASSERT_LT(starts[i - 1], starts[i]) << i;     // written in time order
+    ASSERT_TRUE(Workspace("parallel_test").remove());
+}
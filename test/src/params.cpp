@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 #include <string>
 #include "../../src/lib_ccaligner/params.h"
+#include "test_data.h"
 
 TEST(Params, Arguments) {
     Params params;
@@ -55,3 +56,29 @@ TEST(Params, Arguments) {
     ASSERT_STREQ(params.phonemeLogPath.c_str(), phoneLogPath);
     ASSERT_STREQ(params.alignerLogPath.c_str(), alignerLogPath);
 }
+
+TEST(Params, StreamedAudioIsNotPrecomputedSilently) {
+    ASSERT_THROW(parse({"-wav", "a.wav", "-srt", "a.srt", "--stream-audio", "yes", "-threads", "2"}), IncompatibleParameters);
+    ASSERT_THROW(parse({"-wav", "a.wav", "-srt", "a.srt", "--stream-audio", "yes", "-featCache", "."}), IncompatibleParameters);
+    ASSERT_TRUE(parse({"-wav", "a.wav", "-srt", "a.srt", "--stream-audio", "yes", "-threads", "2", "--precompute-features", "yes"}).precomputeFeatures);
+
+    // transcribing decodes segments from their samples, it streams on any number of threads
+    Params transcribing = parse({"-wav", "a.wav", "-srt", "a.srt", "-transcribe", "yes", "--stream-audio", "yes", "-threads", "4"});
+    ASSERT_FALSE(transcribing.precomputeFeatures);
+    ASSERT_EQ(transcribing.threads, 4u);
+}
+
+TEST(Params, Counts) {
+    const std::vector<std::string> files = {"-wav", "a.wav", "-srt", "a.srt"};
+    auto withThreads = [&files](const std::string& threads) {
+        std::vector<std::string> args(files);
+        args.insert(args.end(), {"-threads", threads});
+        return parse(args);
+    };
+
+    ASSERT_EQ(withThreads("3").threads, 3u);
+    ASSERT_EQ(withThreads("100000").threads, 64u);     // capped, each thread has decoders of its own
+    ASSERT_THROW(withThreads("-1"), InvalidParameters);
+    ASSERT_THROW(withThreads("2x"), InvalidParameters);
+    ASSERT_THROW(withThreads("0"), InvalidParameters);
+}
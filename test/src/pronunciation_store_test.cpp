@@ -0,0 +1,77 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "../../src/lib_ccaligner/grammar_tools.h"
+
+namespace {
+    const char *lexicon = "../src/lib_ext/pocketsphinx/model/en-us/cmudict-en-us.dict";
+
+    std::string lookup(const PronunciationStore& store, const std::string& word) {
+        std::string phonemes;
+        return store.find(word, phonemes) ? phonemes : "<missing>";
+    }
+}
+
+TEST(PronunciationStore, ReadsDictionary) {
+    PronunciationStore store;
+    ASSERT_TRUE(store.readDictionary(lexicon));
+    ASSERT_GT(store.size(), 100000u);
+
+    ASSERT_EQ(lookup(store, "forward"), "F AO R W ER D");   // the first of its pronunciations
+    ASSERT_EQ(lookup(store, "Meters"), "M IY T ER Z");
+    ASSERT_EQ(lookup(store, "'bout"), "B AW T");
+    ASSERT_EQ(lookup(store, "forward(2)"), "<missing>");
+    ASSERT_EQ(lookup(store, "zzzzz"), "<missing>");
+    ASSERT_EQ(lookup(store, ""), "<missing>");
+}
+
+TEST(PronunciationStore, SavesAndAppends) {
+    std::string fileName = "pronunciation_store_test.store";
+    std::remove(fileName.c_str());
+
+    ASSERT_TRUE(PronunciationStore::append(fileName, {{"ccaligner", "S IY S IY AH L AY N ER"}, {"pocketsphinx", "P AA K AH T S F IH NG K S"}}));
+    ASSERT_TRUE(PronunciationStore::append(fileName, {{"ccaligner", "K AH L AY N ER"}, {"gtest", "JH IY T EH S T"}}));
+
+    PronunciationStore store;
+    ASSERT_TRUE(store.load(fileName));
+    ASSERT_EQ(store.size(), 3u);
+    ASSERT_EQ(lookup(store, "ccaligner"), "K AH L AY N ER");     // replaced
+    ASSERT_EQ(lookup(store, "gtest"), "JH IY T EH S T");
+    ASSERT_EQ(lookup(store, "pocketsphinx"), "P AA K AH T S F IH NG K S");
+
+    PronunciationStore stale;
+    ASSERT_FALSE(stale.load(fileName, 42));    // compiled from another dictionary
+    ASSERT_FALSE(stale.load(fileName + ".missing"));
+
+    {
+        std::ofstream truncated(fileName, std::ios::binary | std::ios::in | std::ios::out);
+        truncated.seekp(-1, std::ios::end);
+        truncated.put('x');
+    }
+    ASSERT_FALSE(stale.load(fileName));
+    std::remove(fileName.c_str());
+}
+
+TEST(PronunciationStore, GenerateDictUsesLexicon) {
+    SubtitleItem sub(1, "00:00:01,000", "00:00:03,000", "Go forward ten meters, zorblax", false, "", 0, 0, 0, 0, {}, {}, {}, {});
+
+    Grammar grammar;
+    grammar.lexiconPath = lexicon;
+    ASSERT_TRUE(generate(std::vector<SubtitleItem*>({&sub}), grammar, quick_dict));
+
+    std::map<std::string, std::string> dictionary(grammar.dictionary.begin(), grammar.dictionary.end());
+    ASSERT_EQ(dictionary.size(), 5u);
+    ASSERT_EQ(dictionary["forward"], "F AO R W ER D");
+    ASSERT_EQ(dictionary["meters"], "M IY T ER Z");
+
+    std::string rules;
+    for (const Phoneme& ph : stringToPhoneme("zorblax"))
+        if (!ph.empty())
+            rules += rules.empty() ? ph : " " + ph;
+    ASSERT_EQ(dictionary["zorblax"], rules);     // not in the lexicon
+}
@@ -0,0 +1,74 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "../../src/lib_ccaligner/sample_stream.h"
+
+namespace {
+    int16_t sampleAt(std::size_t index) {
+        return static_cast<int16_t>(index % 30011);
+    }
+
+    // Raw 16 bit little endian audio where every sample encodes its own position.
+    std::string rawAudio(std::size_t numberOfSamples) {
+        std::string bytes;
+        for (std::size_t i = 0; i < numberOfSamples; i++) {
+            uint16_t sample = static_cast<uint16_t>(sampleAt(i));
+            bytes.push_back(static_cast<char>(sample & 0xFF));
+            bytes.push_back(static_cast<char>(sample >> 8));
+        }
+        return bytes;
+    }
+
+    void expectWindow(const SampleView& window, std::size_t firstSample, std::size_t size) {
+        ASSERT_EQ(window.firstSample(), firstSample);
+        ASSERT_EQ(window.size(), size);
+        for (std::size_t i = 0; i < window.size(); i++)
+            ASSERT_EQ(window[i], sampleAt(firstSample + i)) << firstSample + i;
+    }
+}
+
+TEST(SampleStream, ServesWindowsInOrder) {
+    std::istringstream stream(rawAudio(80000));
+    SampleStream audio(stream, true, 16000);
+
+    for (std::size_t first = 0; first < 75000; first += 7919)  // crosses the ring boundary several times
+        expectWindow(audio.getSamples(first, 5000), first, 5000);
+
+    expectWindow(audio.getSamplesByTime(4900, 5100, 320), 78080, 1920);  // clamped to the end of the audio
+    ASSERT_TRUE(audio.getSamplesByTime(5000, 6000, 320).empty());
+}
+
+TEST(SampleStream, KeepsRecentAudioForOverlappingWindows) {
+    std::istringstream stream(rawAudio(50000));
+    SampleStream audio(stream, true, 16000);
+
+    expectWindow(audio.getSamples(20000, 4000), 20000, 4000);
+    expectWindow(audio.getSamples(18000, 4000), 18000, 4000);   // still buffered
+
+    expectWindow(audio.getSamples(40000, 2000), 40000, 2000);
+    expectWindow(audio.getSamples(30000, 4000), 32000, 2000);   // beginning is already discarded
+    expectWindow(audio.getSamples(35000, 20000), 35000, 15000); // trimmed to the capacity, then to the audio
+}
+
+TEST(SampleStream, ReadsFileFromDisk) {
+    std::string fileName = "sample_stream_test.raw";
+    {
+        std::ofstream out(fileName, std::ios::binary);
+        out << rawAudio(20000);
+    }
+
+    {
+        SampleStream audio(fileName, true, 16000);
+        expectWindow(audio.getSamples(-100, 1100), 0, 1000);
+        expectWindow(audio.getSamples(19000, 2000), 19000, 1000);
+    }
+
+    std::remove(fileName.c_str());
+    ASSERT_THROW(SampleStream(fileName, true, 16000), FileNotFound);
+}
@@ -0,0 +1,89 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "pocketsphinx.h"
+#include "pocketsphinx_internal.h"
+#include "test_data.h"
+
+namespace {
+    cmd_ln_t *decoderConfig(const char *beam = "1e-48") {
+        std::string model = dataPath + "model/en-us/en-us";
+        std::string lm = dataPath + "test/data/turtle.lm.bin", dict = dataPath + "test/data/turtle.dic";
+        return cmd_ln_init(nullptr, ps_args(), TRUE, "-hmm", model.c_str(), "-lm", lm.c_str(), "-dict", dict.c_str(),
+                           "-beam", beam, "-logfn", discardedLog, nullptr);
+    }
+
+    std::string decode(ps_decoder_t *decoder, const std::vector<int16>& samples, int32& score) {
+        ps_start_utt(decoder);
+        ps_process_raw(decoder, samples.data(), samples.size(), FALSE, TRUE);
+        ps_end_utt(decoder);
+        const char *hypothesis = ps_get_hyp(decoder, &score);
+        return hypothesis == nullptr ? "" : hypothesis;
+    }
+}
+
+TEST(SharedModel, DecodesLikeOwnModel) {
+    std::vector<int16> samples = goForward();
+    ASSERT_FALSE(samples.empty());
+
+    cmd_ln_t *config = decoderConfig(), *otherConfig = decoderConfig("1e-40");
+    ps_decoder_t *model = ps_init(config);
+    ps_decoder_t *own = ps_init(otherConfig);
+    ps_decoder_t *shared = ps_init_shared(otherConfig, model);
+    ASSERT_NE(model, nullptr);
+    ASSERT_NE(shared, nullptr);
+
+    // parameters are shared, per utterance state is not
+    ASSERT_EQ(shared->acmod->mdef, model->acmod->mdef);
+    ASSERT_EQ(shared->acmod->tmat, model->acmod->tmat);
+    ASSERT_EQ(shared->dict, model->dict);   // read from the same files
+    ASSERT_NE(shared->acmod->mgau, model->acmod->mgau);
+    ASSERT_NE(shared->acmod->fcb, model->acmod->fcb);
+
+    int32 ownScore, sharedScore, modelScore;
+    std::string expected = decode(own, samples, ownScore);
+    ASSERT_EQ(expected, "go forward ten meters");
+    ASSERT_EQ(decode(shared, samples, sharedScore), expected);
+    ASSERT_EQ(sharedScore, ownScore);
+    ASSERT_EQ(decode(model, samples, modelScore), expected);
+
+    ps_free(model);     // shared parameters outlive the decoder that loaded them
+    ASSERT_EQ(decode(own, samples, ownScore), expected);    // second utterance, after the cepstral mean adapted
+    ASSERT_EQ(decode(shared, samples, sharedScore), expected);
+    ASSERT_EQ(sharedScore, ownScore);
+
+    ps_free(shared);
+    ps_free(own);
+    cmd_ln_free_r(config);
+    cmd_ln_free_r(otherConfig);
+}
+
+TEST(SharedModel, PrunedDictionary) {
+    std::vector<int16> samples = goForward();
+    cmd_ln_t *config = decoderConfig();
+    std::string lexicon = dataPath + "model/en-us/cmudict-en-us.dict";
+    cmd_ln_set_str_r(config, "-dict", nullptr);
+
+    ps_decoder_t *decoder = ps_init(config);
+    ASSERT_NE(decoder, nullptr);
+
+    const char *words[] = {"go", "forward", "ten", "meters", "read", nullptr};
+    ASSERT_EQ(ps_load_dict_words(decoder, lexicon.c_str(), nullptr, words), 0);
+
+    ASSERT_NE(ps_lookup_word(decoder, "forward"), nullptr);
+    ASSERT_NE(ps_lookup_word(decoder, "read(2)"), nullptr);     // alternate pronunciations are kept
+    ASSERT_EQ(ps_lookup_word(decoder, "backward"), nullptr);
+    ASSERT_LT(dict_size(decoder->dict), 20);    // with the fillers
+
+    int32 score;
+    ASSERT_EQ(decode(decoder, samples, score), "go forward ten meters");
+
+    ps_free(decoder);
+    cmd_ln_free_r(config);
+}
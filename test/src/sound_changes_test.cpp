@@ -0,0 +1,79 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../src/lib_ccaligner/phoneme_utils.h"
+
+namespace {
+    std::wstring regexReplace(const std::wstring& pattern, const std::wstring& replacement, const std::wstring& word) {
+        return std::regex_replace(word, std::wregex(pattern), replacement);
+    }
+
+    std::wstring compiledReplace(const std::wstring& pattern, const std::wstring& replacement, std::wstring word) {
+        SoundChange(pattern, replacement).apply(word);
+        return word;
+    }
+
+    // Every fiftieth word of the CMU dictionary, and random words over the letters the rules name.
+    std::vector<std::string> words() {
+        std::vector<std::string> result;
+        std::ifstream dictionary("../src/lib_ext/pocketsphinx/model/en-us/cmudict-en-us.dict");
+        std::string line;
+
+        for (int i = 0; std::getline(dictionary, line); i++)
+            if (i % 50 == 0 && line.find('(') == std::string::npos)
+                result.push_back(line.substr(0, line.find(' ')));
+
+        const std::string letters = "abcdefghijklmnopqrstuvwxyz'-.0123456789\xe4\xe2\xeb\xea\xef\xee\xf6\xf4\xfc\xfb\xf2\xf9\xe7\xf1@+$";
+        std::mt19937 random(7);
+        std::uniform_int_distribution<std::size_t> length(1, 12), letter(0, letters.size() - 1);
+
+        for (int i = 0; i < 1000; i++) {
+            std::string word;
+            for (std::size_t n = length(random); n > 0; n--)
+                word += letters[letter(random)];
+            result.push_back(word);
+        }
+
+        return result;
+    }
+}
+
+TEST(SoundChanges, ReplacesLikeRegex) {
+    const std::vector<std::vector<std::wstring>> cases = {
+        {L"(^)gu([eiy])", L"$1g$2", L"guiguy"},                // ^ only at the beginning of the word, not of each search
+        {L"a(l{2}$)", L"o$1", L"allall"},
+        {L"([bcd])a([bcd])", L"$1A$2", L"babab"},              // matches do not overlap
+        {L"(w)a((?:t)?x)", L"$1o$2", L"watx wax wx"},          // greedy optional
+        {L"([ae][bc](?:[bc])?(?:[bc])?)e($)", L"$1$2", L"abcbe abbbbe"},
+        {L"s(\\$)", L"$1", L"s$s$$"},
+        {L"sh", L"$$", L"shush"},
+        {L"([^aeiou])y", L"$1i", L"sky yay"},
+        {L"x", L"$3", L"xax"},                                  // groups that do not exist are empty
+        {L"o{2}", L"u", L"Ωoooo"},                         // characters outside Latin-1 are kept
+    };
+
+    for (const auto& rule : cases)
+        ASSERT_EQ(compiledReplace(rule[0], rule[1], rule[2]), regexReplace(rule[0], rule[1], rule[2])) << rule[0].size();
+}
+
+TEST(SoundChanges, MatchesRegexRules) {
+    const SoundChanges& compiled = getSoundChanges();
+    std::vector<std::string> vocabulary = words();
+    ASSERT_GT(vocabulary.size(), 3000u);
+
+    for (const std::string& word : vocabulary)
+        ASSERT_EQ(compiled.apply(latin1ToWide(word)), applyReplacementRules(word)) << word;
+}
+
+TEST(SoundChanges, Phonemes) {
+    ASSERT_EQ(stringToPhoneme("forward"), std::vector<Phoneme>({"F", "OW", "R", "W", "OW", "R", "D"}));
+    ASSERT_EQ(stringToPhoneme("back"), std::vector<Phoneme>({"B", "AE", "K"}));
+}
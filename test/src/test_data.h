@@ -0,0 +1,83 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#ifndef CCALIGNER_TEST_DATA_H
+#define CCALIGNER_TEST_DATA_H
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "pocketsphinx.h"
+#include "../../src/lib_ccaligner/params.h"
+
+const std::string dataPath = "../src/lib_ext/pocketsphinx/";    //model and test data shipped with pocketsphinx
+
+//-logfn of decoders whose log is not looked at
+#ifdef WIN32
+const char * const discardedLog = "NUL";
+#else
+const char * const discardedLog = "/dev/null";
+#endif
+
+inline std::vector<int16> goForward()   //"go forward ten meters", 16KHz raw samples
+{
+    std::ifstream in(dataPath + "test/data/goforward.raw", std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<int16> samples(bytes.size() / 2);
+    std::memcpy(samples.data(), bytes.data(), samples.size() * 2);
+    return samples;
+}
+
+inline Params parse(std::vector<std::string> args)   //parameters as given on the command line
+{
+    args.insert(args.begin(), "");
+    std::vector<char*> argv;
+    for (auto& arg : args)
+        argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+
+    Params params;
+    params.inputParams(argv.size() - 1, argv.data());
+    return params;
+}
+
+inline std::string fileContents(const std::string& fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+inline void putLittleEndian(std::ofstream& out, unsigned long value, int numberOfBytes)
+{
+    for (int i = 0; i < numberOfBytes; i++)
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+inline void writeGoForward(const std::string& fileName, int copies = 1)   //goforward.raw in a 16 bit mono 16KHz wave file, repeated
+{
+    std::string samples;
+    for (int i = 0; i < copies; i++)
+        samples += fileContents(dataPath + "test/data/goforward.raw");
+
+    std::ofstream out(fileName, std::ios::binary);
+
+    out << "RIFF";
+    putLittleEndian(out, 36 + samples.size(), 4);
+    out << "WAVEfmt ";
+    putLittleEndian(out, 16, 4);
+    putLittleEndian(out, 1, 2);
+    putLittleEndian(out, 1, 2);
+    putLittleEndian(out, 16000, 4);
+    putLittleEndian(out, 32000, 4);
+    putLittleEndian(out, 2, 2);
+    putLittleEndian(out, 16, 2);
+    out << "data";
+    putLittleEndian(out, samples.size(), 4);
+    out << samples;
+}
+
+#endif //CCALIGNER_TEST_DATA_H
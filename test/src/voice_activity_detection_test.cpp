@@ -0,0 +1,169 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include "../../src/lib_ccaligner/commons.h"
+#include "../../src/lib_ccaligner/voice_activity_detection.h"
+
+namespace {
+    std::vector<int16_t> goForward() {
+        std::ifstream in("../src/lib_ext/pocketsphinx/test/data/goforward.raw", std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::vector<int16_t> samples(bytes.size() / 2);
+        std::memcpy(samples.data(), bytes.data(), samples.size() * 2);
+        return samples;
+    }
+
+    std::vector<SpeechSegment> segment(const std::vector<int16_t>& audio, const VadOptions& options, std::size_t chunk) {
+        VoiceActivityDetector detector(options);
+        std::vector<SpeechSegment> segments;
+
+        for (std::size_t i = 0; i < audio.size(); i += chunk) {
+            for (const SpeechSegment& segment : detector.process(SampleView(audio.data() + i, std::min(chunk, audio.size() - i), i)))
+                segments.push_back(segment);
+
+            EXPECT_TRUE(segments.empty() || detector.keepFrom() >= segments.back().firstSample + segments.back().numberOfSamples);
+        }
+
+        for (const SpeechSegment& segment : detector.finish())
+            segments.push_back(segment);
+
+        return segments;
+    }
+}
+
+TEST(VoiceActivityDetection, SegmentsSpeech) {
+    std::vector<int16_t> speech = goForward(), audio(16000);    //a second of silence between them
+    ASSERT_FALSE(speech.empty());
+
+    audio.insert(audio.end(), speech.begin(), speech.end());
+    audio.insert(audio.end(), 16000, 0);
+    audio.insert(audio.end(), speech.begin(), speech.end());
+    audio.insert(audio.end(), 16000, 0);
+
+    std::vector<SpeechSegment> segments = segment(audio, VadOptions(), 2048);
+    ASSERT_EQ(segments.size(), 2u);
+    for (long int i = 0; i < 2; i++) {
+        long int speechStarts = 16000 + i * ((long int) speech.size() + 16000), speechEnds = speechStarts + speech.size();
+        ASSERT_GE(segments[i].firstSample, speechStarts - 200 * 16);
+        ASSERT_LT(segments[i].firstSample, speechEnds);
+        ASSERT_LE(segments[i].firstSample + segments[i].numberOfSamples, speechEnds + 200 * 16);
+    }
+
+    //the chunks the audio arrives in make no difference
+    std::vector<SpeechSegment> odd = segment(audio, VadOptions(), 333);
+    ASSERT_EQ(odd.size(), segments.size());
+    ASSERT_EQ(odd[1].firstSample, segments[1].firstSample);
+    ASSERT_EQ(odd[1].numberOfSamples, segments[1].numberOfSamples);
+
+    ASSERT_TRUE(segment(std::vector<int16_t>(48000), VadOptions(), 2048).empty());
+}
+
+TEST(VoiceActivityDetection, CapsSegmentLength) {
+    std::vector<int16_t> speech = goForward(), audio;
+
+    for (int i = 0; i < 4; i++)
+        audio.insert(audio.end(), speech.begin(), speech.end());
+
+    VadOptions options;
+    options.maximumSegment = 3000;
+    long int maxSegmentSamples = 3 * 16000;
+    std::vector<SpeechSegment> segments = segment(audio, options, 2048);
+    ASSERT_GE(segments.size(), 2u);
+
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        ASSERT_LE(segments[i].numberOfSamples, maxSegmentSamples);
+
+        if (i > 0)      //cut speech goes on in the next segment
+            ASSERT_GE(segments[i].firstSample, segments[i - 1].firstSample + segments[i - 1].numberOfSamples);
+    }
+}
+
+TEST(VoiceActivityDetection, Options) {
+    std::vector<int16_t> speech = goForward(), audio(16000);
+    audio.insert(audio.end(), speech.begin(), speech.end());
+    audio.insert(audio.end(), 16000, 0);
+
+    //positioned like the window
+    SampleView window(audio.data(), audio.size(), 160000);
+    std::vector<SpeechSegment> segments = detectSpeech(window);
+    ASSERT_EQ(segments.size(), 1u);
+    ASSERT_GE(segments[0].firstSample, 160000 + 16000 - 200 * 16);
+
+    for (long int frameLength : {10, 20}) {
+        VadOptions options;
+        options.frameLength = frameLength;
+        ASSERT_EQ(detectSpeech(window, options).size(), 1u) << frameLength;
+    }
+
+    VadOptions invalid;
+    invalid.frameLength = 25;
+    ASSERT_THROW(VoiceActivityDetector detector(invalid), InvalidParameters);
+    invalid = VadOptions();
+    invalid.aggressiveness = 4;
+    ASSERT_THROW(VoiceActivityDetector detector(invalid), InvalidParameters);
+
+    //all of it is too short to be speech
+    VadOptions longSpeech;
+    longSpeech.minimumSpeech = 5000;
+    ASSERT_TRUE(detectSpeech(window, longSpeech).empty());
+
+    //a detector per thread
+    std::vector<std::vector<SpeechSegment>> found(4);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < found.size(); i++)
+        threads.emplace_back([&, i] { found[i] = detectSpeech(window); });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (const std::vector<SpeechSegment>& other : found) {
+        ASSERT_EQ(other.size(), 1u);
+        ASSERT_EQ(other[0].firstSample, segments[0].firstSample);
+        ASSERT_EQ(other[0].numberOfSamples, segments[0].numberOfSamples);
+    }
+}
+
+TEST(VoiceActivityDetection, TrimsWindowsToSpeech) {
+    std::vector<SpeechSegment> speech({{1000, 500}, {3000, 1000}, {6000, 200}});
+
+    ASSERT_EQ(speechWithin(speech, 0, 10000).firstSample, 1000);
+    ASSERT_EQ(speechWithin(speech, 0, 10000).numberOfSamples, 5200);
+    ASSERT_EQ(speechWithin(speech, 1200, 3500).firstSample, 1200);
+    ASSERT_EQ(speechWithin(speech, 1200, 3500).numberOfSamples, 2300);
+    ASSERT_EQ(speechWithin(speech, 1500, 3000).numberOfSamples, 0);
+    ASSERT_EQ(speechWithin(speech, 2000, 5000).firstSample, 3000);
+    ASSERT_EQ(speechWithin(speech, 2000, 5000).numberOfSamples, 1000);
+    ASSERT_EQ(speechWithin({}, 0, 100).numberOfSamples, 0);
+
+    //speech found while the samples pass through, read in blocks as features are computed
+    std::vector<int16_t> speechSamples = goForward(), audio(16000);
+    audio.insert(audio.end(), speechSamples.begin(), speechSamples.end());
+    audio.insert(audio.end(), 16000, 0);
+
+    struct Samples : public SampleSource {
+        const std::vector<int16_t>& audio;
+        explicit Samples(const std::vector<int16_t>& samples) : audio(samples) {}
+        SampleView getSamples(long int firstSample, long int numberOfSamples) override {
+            long int size = std::max(0L, std::min(numberOfSamples, (long int) audio.size() - firstSample));
+            return SampleView(audio.data() + firstSample, size, firstSample);
+        }
+    } source(audio);
+
+    SpeechTracker tracker(source);
+
+    for (long int position = 0; !tracker.getSamples(position, 4096).empty(); position += 4096)
+        tracker.getSamples(position, 100);  //read again, not fed twice
+
+    std::vector<SpeechSegment> found = tracker.finish(), expected = detectSpeech(SampleView(audio.data(), audio.size()));
+    ASSERT_EQ(found.size(), expected.size());
+    ASSERT_EQ(found[0].firstSample, expected[0].firstSample);
+    ASSERT_EQ(found[0].numberOfSamples, expected[0].numberOfSamples);
+}
@@ -0,0 +1,308 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <sstream>
+#include <cmath>
+#include "../../src/lib_ccaligner/read_wav_file.h"
+
+namespace {
+    void putLittleEndian(std::vector<unsigned char>& bytes, unsigned long value, int numberOfBytes) {
+        for (int i = 0; i < numberOfBytes; i++)
+            bytes.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+    }
+
+    void putChunkID(std::vector<unsigned char>& bytes, const std::string& id) {
+        bytes.insert(bytes.end(), id.begin(), id.end());
+    }
+
+    // Build a wave file around already encoded frames, optionally with a metadata chunk between 'fmt ' and 'data'.
+    std::vector<unsigned char> buildWave(const std::vector<unsigned char>& frames, int audioFormat, int numChannels,
+                                         unsigned long sampleRate, int bitsPerSample, bool withListChunk) {
+        std::vector<unsigned char> bytes;
+        std::string list("INFOISFT\x05\x00\x00\x00test\x00", 17);
+        int blockAlign = numChannels * bitsPerSample / 8;
+
+        putChunkID(bytes, "RIFF");
+        putLittleEndian(bytes, 0, 4);   // patched below
+        putChunkID(bytes, "WAVE");
+
+        putChunkID(bytes, "fmt ");
+        putLittleEndian(bytes, 16, 4);
+        putLittleEndian(bytes, audioFormat, 2);
+        putLittleEndian(bytes, numChannels, 2);
+        putLittleEndian(bytes, sampleRate, 4);
+        putLittleEndian(bytes, sampleRate * blockAlign, 4);   // byte rate
+        putLittleEndian(bytes, blockAlign, 2);
+        putLittleEndian(bytes, bitsPerSample, 2);
+
+        if (withListChunk) {
+            putChunkID(bytes, "LIST");
+            putLittleEndian(bytes, list.size(), 4);
+            bytes.insert(bytes.end(), list.begin(), list.end());
+            bytes.push_back(0); // odd sized chunks are padded
+        }
+
+        putChunkID(bytes, "data");
+        putLittleEndian(bytes, frames.size(), 4);
+        bytes.insert(bytes.end(), frames.begin(), frames.end());
+
+        unsigned long riffSize = bytes.size() - 8;
+        for (int i = 0; i < 4; i++)
+            bytes[4 + i] = static_cast<unsigned char>((riffSize >> (8 * i)) & 0xFF);
+
+        return bytes;
+    }
+
+    // Build a 16 bit mono 16KHz wave file.
+    std::vector<unsigned char> buildWave(const std::vector<int16_t>& samples, bool withListChunk) {
+        std::vector<unsigned char> frames;
+        for (int16_t sample : samples)
+            putLittleEndian(frames, static_cast<uint16_t>(sample), 2);
+
+        return buildWave(frames, 1, 1, 16000, 16, withListChunk);
+    }
+
+    // 44.1KHz stereo 16 bit with identical channels, a second long.
+    std::vector<unsigned char> stereoFrames() {
+        std::vector<unsigned char> frames;
+        for (int i = 0; i < 44100; i++) {
+            uint16_t sample = static_cast<uint16_t>(static_cast<int16_t>(10000 * std::sin(2 * M_PI * 300 * i / 44100)));
+            putLittleEndian(frames, sample, 2);
+            putLittleEndian(frames, sample, 2);
+        }
+        return frames;
+    }
+
+    std::string writeTempFile(const std::string& name, const std::vector<unsigned char>& bytes) {
+        std::ofstream out(name, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        return name;
+    }
+
+    std::vector<int16_t> testSamples() {
+        std::vector<int16_t> samples;
+        for (int i = 0; i < 4000; i++)
+            samples.push_back(static_cast<int16_t>((i * 37) % 65536 - 32768));
+        return samples;
+    }
+}
+
+TEST(WaveFileData, ReadsMappedFile) {
+    const std::vector<int16_t> samples = testSamples();
+    std::string fileName = writeTempFile("wave_file_test_mapped.wav", buildWave(samples, false));
+
+    {
+        WaveFileData file(fileName);
+        ASSERT_TRUE(file.read());
+
+        SampleView view = file.getSamples();
+        ASSERT_EQ(view.size(), samples.size());
+        ASSERT_TRUE(std::equal(view.begin(), view.end(), samples.begin()));
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveFileData, SkipsMetadataChunks) {
+    const std::vector<int16_t> samples = testSamples();
+    std::string fileName = writeTempFile("wave_file_test_list.wav", buildWave(samples, true));
+
+    {
+        WaveFileData file(fileName);
+        ASSERT_TRUE(file.read());
+
+        SampleView view = file.getSamples();
+        ASSERT_EQ(view.size(), samples.size());
+        ASSERT_TRUE(std::equal(view.begin(), view.end(), samples.begin()));
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveFileData, ReadsRawFile) {
+    const std::vector<int16_t> samples = testSamples();
+    std::vector<unsigned char> bytes;
+    for (int16_t sample : samples)
+        putLittleEndian(bytes, static_cast<uint16_t>(sample), 2);
+    std::string fileName = writeTempFile("wave_file_test.raw", bytes);
+
+    {
+        WaveFileData file(fileName, true);
+        ASSERT_TRUE(file.read());
+
+        SampleView view = file.getSamples();
+        ASSERT_EQ(view.size(), samples.size());
+        ASSERT_TRUE(std::equal(view.begin(), view.end(), samples.begin()));
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveFileData, ConvertsToSixteenKHzMono) {
+    std::string fileName = writeTempFile("wave_file_test_stereo.wav", buildWave(stereoFrames(), 1, 2, 44100, 16, true));
+
+    {
+        WaveFileData file(fileName);
+        ASSERT_TRUE(file.read());
+
+        SampleView view = file.getSamples();
+        ASSERT_EQ(view.size(), 16000u);
+        ASSERT_NEAR(*std::max_element(view.begin(), view.end()), 10000, 100);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveFileData, RejectsUnsupportedFormat) {
+    std::string fileName = writeTempFile("wave_file_test_adpcm.wav", buildWave(std::vector<unsigned char>(400), 2, 1, 16000, 16, false));
+
+    {
+        WaveFileData file(fileName);
+        ASSERT_THROW(file.read(), InvalidFile);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveFileData, RejectsInvalidFile) {
+    std::vector<unsigned char> bytes = buildWave(testSamples(), false);
+    bytes[0] = 'X';
+    std::string fileName = writeTempFile("wave_file_test_invalid.wav", bytes);
+
+    {
+        WaveFileData file(fileName);
+        ASSERT_THROW(file.read(), InvalidFile);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveFileData, MissingFile) {
+    WaveFileData file("wave_file_test_does_not_exist.wav");
+    ASSERT_THROW(file.read(), FileNotFound);
+}
+
+TEST(WaveFileData, ClampsSampleWindows) {
+    const std::vector<int16_t> samples = testSamples();   // 250 ms
+    std::string fileName = writeTempFile("wave_file_test_window.wav", buildWave(samples, false));
+
+    {
+        WaveFileData file(fileName);
+        ASSERT_TRUE(file.read());
+
+        SampleView window = file.getSamplesByTime(100, 150, 160);
+        ASSERT_EQ(window.firstSample(), 1440u);
+        ASSERT_EQ(window.size(), 1120u);
+        ASSERT_EQ(window.startTime(), 90);
+        ASSERT_TRUE(std::equal(window.begin(), window.end(), samples.begin() + 1440));
+
+        window = file.getSamplesByTime(5, 240, 160);    // padding overflows on both sides
+        ASSERT_EQ(window.firstSample(), 0u);
+        ASSERT_EQ(window.size(), samples.size());
+
+        window = file.getSamples(3900, 500);
+        ASSERT_EQ(window.firstSample(), 3900u);
+        ASSERT_EQ(window.size(), 100u);
+        ASSERT_EQ(window[0], samples[3900]);
+
+        ASSERT_TRUE(file.getSamplesByTime(250, 300, 160).empty());
+        ASSERT_TRUE(file.getSamples(-500, 400).empty());
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST(WaveStreamReader, ReadsStreamInBlocks) {
+    const std::vector<int16_t> samples = testSamples();
+    std::vector<unsigned char> bytes = buildWave(samples, true);
+    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
+
+    WaveStreamReader reader(stream);
+    ASSERT_TRUE(reader.readHeader());
+    ASSERT_EQ(reader.expectedSamples(), samples.size());
+
+    std::vector<int16_t> decoded(samples.size() + 100);
+    std::size_t total = 0, count;
+    while ((count = reader.readSamples(decoded.data() + total, 333)) > 0)
+        total += count;
+
+    ASSERT_EQ(total, samples.size());
+    decoded.resize(total);
+    ASSERT_EQ(decoded, samples);
+}
+
+TEST(WaveStreamReader, ReadsStreamWithUnknownDataSize) {
+    std::vector<int16_t> samples = testSamples();
+    samples.resize(WaveStreamReader::blockSize + 7);    // exercise the direct read path
+    std::vector<unsigned char> bytes = buildWave(samples, false);
+    for (int i = 0; i < 4; i++)
+        bytes[40 + i] = 0xFF;   // placeholder size, as written by streaming encoders
+    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
+
+    WaveStreamReader reader(stream);
+    ASSERT_TRUE(reader.readHeader());
+    ASSERT_EQ(reader.expectedSamples(), 0u);
+
+    std::vector<int16_t> decoded(2 * samples.size());
+    std::size_t total = reader.readSamples(decoded.data() + 1, 1);
+    total += reader.readSamples(decoded.data() + 1 + total, decoded.size() - 1 - total);
+
+    ASSERT_EQ(total, samples.size());
+    ASSERT_TRUE(std::equal(samples.begin(), samples.end(), decoded.begin() + 1));
+    ASSERT_EQ(reader.readSamples(decoded.data(), decoded.size()), 0u);
+}
+
+TEST(WaveStreamReader, ReadsRawStream) {
+    const std::vector<int16_t> samples = testSamples();
+    std::vector<unsigned char> bytes;
+    for (int16_t sample : samples)
+        putLittleEndian(bytes, static_cast<uint16_t>(sample), 2);
+    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
+
+    WaveStreamReader reader(stream, true);
+    std::vector<int16_t> decoded(samples.size());
+    ASSERT_EQ(reader.readSamples(decoded.data(), decoded.size()), samples.size());
+    ASSERT_EQ(decoded, samples);
+}
+
+TEST(WaveStreamReader, RejectsInvalidStream) {
+    std::vector<unsigned char> bytes = buildWave(testSamples(), false);
+    bytes[8] = 'X';
+    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
+
+    WaveStreamReader reader(stream);
+    ASSERT_THROW(reader.readHeader(), InvalidFile);
+}
+
+TEST(WaveStreamReader, ConvertsStream) {
+    std::vector<unsigned char> frames;
+    for (int i = 0; i < 48000; i++) {   // 48KHz float mono, a second long
+        float sample = static_cast<float>(0.25 * std::sin(2 * M_PI * 300 * i / 48000));
+        uint32_t bits;
+        std::memcpy(&bits, &sample, sizeof(bits));
+        putLittleEndian(frames, bits, 4);
+    }
+
+    std::vector<unsigned char> bytes = buildWave(frames, 3, 1, 48000, 32, false);
+    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
+
+    WaveStreamReader reader(stream);
+    ASSERT_TRUE(reader.readHeader());
+    ASSERT_EQ(reader.expectedSamples(), 16000u);
+
+    std::vector<int16_t> decoded(20000);
+    std::size_t total = 0, count;
+    while ((count = reader.readSamples(decoded.data() + total, 777)) > 0)
+        total += count;
+
+    ASSERT_EQ(total, 16000u);
+    ASSERT_NEAR(*std::max_element(decoded.begin(), decoded.end()), 8192, 100);
+}
@@ -0,0 +1,99 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include "../../src/lib_ccaligner/word_matcher.h"
+
+namespace {
+    int classicDistance(const std::string& a, const std::string& b) {
+        std::vector<std::vector<int>> d(a.size() + 1, std::vector<int>(b.size() + 1));
+        for (std::size_t i = 0; i <= a.size(); i++)
+            d[i][0] = static_cast<int>(i);
+        for (std::size_t j = 0; j <= b.size(); j++)
+            d[0][j] = static_cast<int>(j);
+        for (std::size_t i = 1; i <= a.size(); i++)
+            for (std::size_t j = 1; j <= b.size(); j++)
+                d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1)});
+        return d[a.size()][b.size()];
+    }
+
+    std::vector<std::string> split(const std::string& text) {
+        std::istringstream iss(text);
+        return std::vector<std::string>((std::istream_iterator<std::string>(iss)), std::istream_iterator<std::string>());
+    }
+}
+
+TEST(WordMatcher, BitParallelDistance) {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> character('a', 'd');
+
+    for (int test = 0; test < 2000; test++) {
+        std::string a(random() % 70, ' '), b(random() % 70, ' ');
+        for (char& c : a)
+            c = static_cast<char>(character(random));
+        for (char& c : b)
+            c = static_cast<char>(character(random));
+
+        ASSERT_EQ(levenshtein_distance(a, b), classicDistance(a, b)) << a << " / " << b;
+    }
+
+    WordPattern pattern;
+    std::string word = "forward";
+    ASSERT_TRUE(pattern.assign(word));
+    ASSERT_EQ(pattern.distance("forwards"), 1);
+    ASSERT_EQ(pattern.distance(""), 7);
+    std::string other = "meters";
+    ASSERT_TRUE(pattern.assign(other));     // nothing of forward is left
+    ASSERT_EQ(pattern.distance("meters"), 0);
+    ASSERT_EQ(pattern.distance("forward"), classicDistance("meters", "forward"));
+    ASSERT_FALSE(pattern.assign(std::string(65, 'a')));
+}
+
+TEST(WordMatcher, MatchesMonotonically) {
+    std::vector<std::string> words = split("why would you use a tomato just why");
+
+    // the first why was not recognised, it must not take the time of the last
+    std::vector<int> matches = matchWords(words, split("<s> would you use a tomatos just why </s>"), 3);
+    ASSERT_EQ(matches, std::vector<int>({-1, 1, 2, 3, 4, 5, 6, 7, -1}));
+
+    // a greedy search would give "you" the first of them and leave nothing for the second
+    matches = matchWords(split("you know you"), split("<sil> you you"), 3);
+    ASSERT_EQ(matches, std::vector<int>({-1, 0, 2}));
+
+    // a close word does not pull the rest out of place
+    matches = matchWords(split("go forward ten meters"), split("go four ward ten meters [NOISE]"), 3);
+    ASSERT_EQ(matches, std::vector<int>({0, -1, -1, 2, 3, -1}));
+
+    matches = matchWords(split("go forward ten meters"), split("go"), 0);
+    ASSERT_EQ(matches, std::vector<int>({0}));
+    ASSERT_EQ(matchWords({}, split("go"), 3), std::vector<int>({-1}));
+    ASSERT_TRUE(matchWords(split("go"), {}, 3).empty());
+
+    // out of reach of the window
+    ASSERT_EQ(matchWords(split("a b c d e f g meters"), split("meters"), 3), std::vector<int>({-1}));
+}
+
+TEST(WordMatcher, LongDialogue) {
+    std::vector<std::string> words, recognised;
+    for (int i = 0; i < 2000; i++) {
+        words.push_back("word" + std::to_string(i));
+        if (i % 10 != 3)
+            recognised.push_back(i % 10 == 5 ? "<sil>" : "word" + std::to_string(i));
+    }
+
+    std::vector<int> matches = matchWords(words, recognised, 3);
+    int matched = 0;
+    for (std::size_t i = 0; i < matches.size(); i++) {
+        if (matches[i] < 0)
+            continue;
+        ASSERT_EQ(words[matches[i]], recognised[i]);
+        matched++;
+    }
+    ASSERT_EQ(matched, 1600);
+}
@@ -0,0 +1,83 @@
+/*
+ * Author   : Saurabh Shrivastava
+ * Email    : saurabh.shrivastava54@gmail.com
+ * Link     : https://github.com/saurabhshri
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include "../../src/lib_ccaligner/grammar_tools.h"
+#include "../../src/lib_ccaligner/params.h"
+#include "test_data.h"
+
+namespace {
+    Params aligning(std::vector<std::string> args) {
+        args.insert(args.begin(), {"-wav", "path/to/wav/file", "-srt", "path/to/srt/file"});
+        return parse(args);
+    }
+
+    bool startsWith(const std::string& text, const std::string& prefix) {
+        return text.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+TEST(Workspace, CreatesAndRemoves) {
+    Workspace workspace("workspace_test/job/");
+    ASSERT_EQ(workspace.directory(), "workspace_test/job");
+    ASSERT_EQ(workspace.lmPath(), "workspace_test/job/lm/complete.lm");
+
+    workspace.create();
+    workspace.create();     // already there
+    ASSERT_TRUE(std::ofstream(workspace.path("fsg/1000.fsg")).good());
+
+    ASSERT_TRUE(workspace.remove());
+    ASSERT_FALSE(std::ifstream(workspace.path("fsg/1000.fsg")).good());
+    ASSERT_TRUE(workspace.remove());        // nothing left to remove
+    ASSERT_TRUE(Workspace("workspace_test").remove());
+
+    std::string first = Workspace::unique("workspace_test"), second = Workspace::unique("workspace_test");
+    ASSERT_TRUE(startsWith(first, "workspace_test/job-"));
+    ASSERT_NE(first, second);
+}
+
+TEST(Workspace, ParamsDefaultToWorkspace) {
+    Params shared = aligning({});
+    ASSERT_EQ(shared.workspacePath, "tempFiles");
+    ASSERT_EQ(shared.lmPath, "tempFiles/lm/complete.lm");
+    ASSERT_FALSE(shared.removeWorkspace);
+
+    Params given = aligning({"-lm", "path/to/lm/file", "-workdir", "jobs/42", "-alignerLog", "path/to/alignerLog/file"});
+    ASSERT_EQ(given.workspacePath, "jobs/42");
+    ASSERT_EQ(given.lmPath, "path/to/lm/file");
+    ASSERT_EQ(given.dictPath, "jobs/42/dict/complete.dict");
+    ASSERT_EQ(given.phoneticLmPath, "model/en-us-phone.lm.bin");
+    ASSERT_TRUE(startsWith(given.logPath, "jobs/42/"));
+    ASSERT_TRUE(startsWith(given.phonemeLogPath, "jobs/42/phoneme-"));
+    ASSERT_EQ(given.alignerLogPath, "path/to/alignerLog/file");
+    ASSERT_FALSE(given.removeWorkspace);
+
+    Params generated = aligning({"-phoneLM", "tempFiles/lm/phoneticCorpus.txt.arpabo", "-workdir", "auto"});
+    ASSERT_TRUE(startsWith(generated.workspacePath, "tempFiles/job-"));
+    ASSERT_EQ(generated.phoneticLmPath, generated.workspacePath + "/lm/phoneticCorpus.txt.arpabo");
+    ASSERT_TRUE(generated.removeWorkspace);
+
+    ASSERT_FALSE(aligning({"-workdir", "auto", "--dump-grammar", "yes"}).removeWorkspace);
+}
+
+TEST(Workspace, GrammarWrittenToWorkspace) {
+    SubtitleItem sub(1, "00:00:01,000", "00:00:03,000", "Go forward ten meters", false, "", 0, 0, 0, 0, {}, {}, {}, {});
+
+    Grammar grammar;
+    grammar.workspace = Workspace("workspace_test");
+    ASSERT_TRUE(generate(std::vector<SubtitleItem*>({&sub}), grammar, quick_dict, true));
+    ASSERT_TRUE(std::ifstream("workspace_test/lm/complete.lm").good());
+    ASSERT_TRUE(std::ifstream("workspace_test/dict/complete.dict").good());
+    ASSERT_TRUE(std::ifstream("workspace_test/corpus/corpus.txt").good());
+
+    Grammar fsgGrammar;
+    fsgGrammar.workspace = grammar.workspace;
+    ASSERT_TRUE(generate(std::vector<SubtitleItem*>({&sub}), fsgGrammar, fsg, true));
+    ASSERT_TRUE(std::ifstream("workspace_test/fsg/1000.fsg").good());
+
+    ASSERT_TRUE(grammar.workspace.remove());
+}